@@ -0,0 +1,277 @@
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import threading
+import time
+
+# Runs a manifest of games through duckstation-regtest, several processes at a time, and collects the benchmark
+# reports, frame hash comparisons and crash states into a single JSON file.
+#
+# The manifest is a JSON object:
+# {
+#   "defaults": { "frames": 3600, "renderer": "Software", "args": ["-cpu", "Recompiler"] },
+#   "games": [
+#     { "path": "/games/Some Game.chd" },
+#     { "name": "other-game-pgxp", "path": "/games/Other Game.cue", "frames": 1800, "args": ["-pgxp"] }
+#   ]
+# }
+#
+# Per-game keys override the defaults. "args" from both are concatenated. Relative paths are relative to the manifest.
+
+CRASH_MARKER = "REGTEST_CRASH "
+GAME_KEYS = ["name", "path", "frames", "renderer", "warmup_frames", "args", "timeout"]
+
+print_lock = threading.Lock()
+
+
+def log(msg):
+    with print_lock:
+        print(msg, flush=True)
+
+
+def game_name(game):
+    if "name" in game:
+        return game["name"]
+
+    return os.path.splitext(os.path.basename(game["path"]))[0]
+
+
+def load_manifest(path):
+    with open(path, "r", encoding="utf-8") as f:
+        manifest = json.load(f)
+
+    base_dir = os.path.dirname(os.path.realpath(path))
+    defaults = manifest.get("defaults", {})
+    games = []
+    names = set()
+    for entry in manifest.get("games", []):
+        for key in entry.keys():
+            if key not in GAME_KEYS:
+                raise ValueError("Unknown key '%s' in manifest entry" % key)
+
+        game = dict(defaults)
+        game.update(entry)
+        game["args"] = defaults.get("args", []) + entry.get("args", [])
+        if "path" not in game:
+            raise ValueError("Manifest entry is missing a path")
+        game["path"] = os.path.join(base_dir, game["path"])
+        game["name"] = game_name(game)
+        if game["name"] in names:
+            raise ValueError("Duplicate game name '%s', set a unique name for each entry" % game["name"])
+        names.add(game["name"])
+        games.append(game)
+
+    return games
+
+
+def compare_hash_logs(path, golden_path):
+    def read_log(path):
+        frames = []
+        with open(path, "r", encoding="utf-8") as f:
+            for line in f:
+                line = line.strip()
+                if len(line) > 0 and not line.startswith("#"):
+                    frames.append(line.split(" "))
+        return frames
+
+    if not os.path.isfile(golden_path):
+        return {"status": "missing_golden"}
+
+    frames = read_log(path)
+    golden = read_log(golden_path)
+    mismatches = 0
+    first_mismatch = None
+    for actual, expected in zip(frames, golden):
+        if actual != expected:
+            mismatches += 1
+            if first_mismatch is None:
+                first_mismatch = {"frame": int(actual[0]),
+                                  "video": len(actual) < 2 or len(expected) < 2 or actual[1] != expected[1],
+                                  "audio": len(actual) < 3 or len(expected) < 3 or actual[2] != expected[2]}
+
+    # A run which stopped before the end of the golden log, or ran past it, doesn't match even if the common frames do.
+    if len(frames) != len(golden):
+        status = "length_mismatch"
+    else:
+        status = "match" if mismatches == 0 else "mismatch"
+
+    return {"status": status,
+            "frames": len(frames),
+            "frames_compared": min(len(frames), len(golden)),
+            "golden_frames": len(golden),
+            "mismatched_frames": mismatches,
+            "first_mismatch": first_mismatch}
+
+
+def parse_crash_state(output):
+    for line in reversed(output.splitlines()):
+        idx = line.find(CRASH_MARKER)
+        if idx >= 0:
+            try:
+                return json.loads(line[idx + len(CRASH_MARKER):])
+            except ValueError:
+                return {"raw": line[idx + len(CRASH_MARKER):]}
+
+    return None
+
+
+class CorePool:
+    """Hands out disjoint sets of host cores to workers, so concurrently running games don't share cores."""
+
+    def __init__(self, workers, cores_per_worker):
+        self.lock = threading.Lock()
+        self.free = []
+        cores = sorted(os.sched_getaffinity(0)) if hasattr(os, "sched_getaffinity") else []
+        for i in range(workers):
+            core_set = cores[i * cores_per_worker:(i + 1) * cores_per_worker]
+            if len(core_set) == cores_per_worker:
+                self.free.append(core_set)
+
+        self.enabled = shutil.which("taskset") is not None and len(self.free) == workers
+
+    def acquire(self):
+        with self.lock:
+            return self.free.pop() if self.enabled else None
+
+    def release(self, cores):
+        if cores is not None:
+            with self.lock:
+                self.free.append(cores)
+
+
+def run_game(runner, outdir, golden_dir, update_golden, core_pool, game):
+    name = game["name"]
+    safe_name = re.sub(r"[^A-Za-z0-9_.-]", "_", name)
+    report_path = os.path.join(outdir, safe_name + ".benchmark.json")
+    hash_path = os.path.join(outdir, safe_name + ".hashes.txt")
+    log_path = os.path.join(outdir, safe_name + ".log")
+
+    args = [runner,
+            "-log", "error",
+            "-frames", str(game.get("frames", 3600)),
+            "-renderer", game.get("renderer", "Software"),
+            "-benchmark", report_path,
+            "-warmupframes", str(game.get("warmup_frames", 0)),
+            "-hashlog", hash_path,
+    ]
+    args += game["args"]
+    args += ["--", game["path"]]
+
+    for path in [report_path, hash_path]:
+        if os.path.exists(path):
+            os.remove(path)
+
+    # preexec_fn isn't safe from worker threads, so pin the process with taskset where it's available.
+    cores = core_pool.acquire()
+    result = {"name": name, "path": game["path"], "args": args[1:], "cores": cores}
+    if cores is not None:
+        args = ["taskset", "-c", ",".join(str(core) for core in cores)] + args
+
+    log("Running '%s'%s" % (name, (" on cores %s" % cores) if cores is not None else ""))
+    start_time = time.monotonic()
+    try:
+        proc = subprocess.run(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=game.get("timeout"))
+        output = proc.stdout.decode("utf-8", errors="replace")
+        result["return_code"] = proc.returncode
+        if proc.returncode == 0:
+            result["status"] = "ok"
+        else:
+            crash_state = parse_crash_state(output)
+            result["status"] = "crashed" if (crash_state is not None or proc.returncode < 0) else "failed"
+            result["crash_state"] = crash_state
+    except subprocess.TimeoutExpired as e:
+        output = e.output.decode("utf-8", errors="replace") if e.output is not None else ""
+        result["status"] = "timeout"
+    finally:
+        core_pool.release(cores)
+
+    result["wall_seconds"] = time.monotonic() - start_time
+    with open(log_path, "w", encoding="utf-8") as f:
+        f.write(output)
+
+    if os.path.isfile(report_path):
+        with open(report_path, "r", encoding="utf-8") as f:
+            result["benchmark"] = json.load(f)
+
+    if os.path.isfile(hash_path) and golden_dir is not None:
+        golden_path = os.path.join(golden_dir, safe_name + ".hashes.txt")
+        if update_golden and result["status"] == "ok":
+            os.replace(hash_path, golden_path)
+            result["hashes"] = {"status": "updated"}
+        else:
+            result["hashes"] = compare_hash_logs(hash_path, golden_path)
+
+    fps = result.get("benchmark", {}).get("fps")
+    log("Finished '%s': %s%s" % (name, result["status"], (", %.2f fps" % fps) if fps is not None else ""))
+    return result
+
+
+def run_suite(runner, manifest, outdir, golden_dir, update_golden, parallel, cores_per_worker, result_path):
+    games = load_manifest(manifest)
+    os.makedirs(outdir, exist_ok=True)
+    if golden_dir is not None:
+        os.makedirs(golden_dir, exist_ok=True)
+
+    core_pool = CorePool(parallel, cores_per_worker)
+    log("Running %u games with %u processes%s" % (len(games), parallel,
+                                                   ", pinned to %u cores each" % cores_per_worker if core_pool.enabled
+                                                   else ""))
+
+    results = []
+    start_time = time.monotonic()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=parallel) as executor:
+        futures = [executor.submit(run_game, runner, outdir, golden_dir, update_golden, core_pool, game)
+                   for game in games]
+        for future in concurrent.futures.as_completed(futures):
+            results.append(future.result())
+
+    results.sort(key=lambda r: r["name"])
+    summary = {"games": len(results),
+               "wall_seconds": time.monotonic() - start_time,
+               "ok": sum(1 for r in results if r["status"] == "ok"),
+               "failed": sum(1 for r in results if r["status"] == "failed"),
+               "crashed": sum(1 for r in results if r["status"] == "crashed"),
+               "timeout": sum(1 for r in results if r["status"] == "timeout"),
+               "hash_mismatches": sum(1 for r in results
+                                      if r.get("hashes", {}).get("status") in ("mismatch", "length_mismatch"))}
+
+    with open(result_path, "w", encoding="utf-8") as f:
+        json.dump({"summary": summary, "results": results}, f, indent=2)
+
+    log("%u ok, %u failed, %u crashed, %u timed out, %u with hash mismatches. Results written to '%s'." %
+        (summary["ok"], summary["failed"], summary["crashed"], summary["timeout"], summary["hash_mismatches"],
+         result_path))
+    return summary["ok"] == summary["games"] and summary["hash_mismatches"] == 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Run a manifest of regression tests in parallel and collect results")
+    parser.add_argument("-runner", action="store", required=True, help="Path to DuckStation regression test runner")
+    parser.add_argument("-manifest", action="store", required=True, help="JSON manifest of games to run")
+    parser.add_argument("-outdir", action="store", required=True, help="Directory for logs, hashes and reports")
+    parser.add_argument("-goldendir", action="store", help="Directory containing golden frame hash logs")
+    parser.add_argument("-updategolden", action="store_true", help="Replace golden hash logs with this run's")
+    parser.add_argument("-parallel", action="store", type=int, default=max(os.cpu_count() // 2, 1),
+                        help="Number of processes to run")
+    parser.add_argument("-corespergame", action="store", type=int, default=2,
+                        help="Host cores to pin each process to, the software renderer uses a second thread")
+    parser.add_argument("-results", action="store", help="Path to write aggregated results to")
+
+    args = parser.parse_args()
+    if args.updategolden and args.goldendir is None:
+        print("-updategolden requires -goldendir")
+        sys.exit(1)
+
+    outdir = os.path.realpath(args.outdir)
+    result_path = args.results if args.results is not None else os.path.join(outdir, "results.json")
+    golden_dir = os.path.realpath(args.goldendir) if args.goldendir is not None else None
+    if not run_suite(os.path.realpath(args.runner), args.manifest, outdir, golden_dir, args.updategolden,
+                     max(args.parallel, 1), max(args.corespergame, 1), result_path):
+        sys.exit(1)
+    else:
+        sys.exit(0)
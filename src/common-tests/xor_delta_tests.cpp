@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "common/xor_delta.h"
+#include <gtest/gtest.h>
+#include <random>
+
+static std::vector<u8> RoundTrip(const std::vector<u8>& data, const std::vector<u8>& base,
+                                 size_t* delta_size = nullptr)
+{
+  std::vector<u8> delta;
+  XORDelta::Encode(&delta, data, base);
+  if (delta_size)
+    *delta_size = delta.size();
+
+  const std::optional<size_t> size = XORDelta::GetDecodedSize(delta);
+  EXPECT_TRUE(size.has_value());
+
+  std::vector<u8> buffer = base;
+  buffer.resize(size.value_or(0));
+  EXPECT_TRUE(XORDelta::Apply(buffer, base.size(), delta));
+  return buffer;
+}
+
+TEST(XORDelta, IdenticalBuffersEncodeToHeaderOnly)
+{
+  std::vector<u8> data(64 * 1024, 0x5A);
+  size_t delta_size;
+  ASSERT_EQ(RoundTrip(data, data, &delta_size), data);
+  ASSERT_LE(delta_size, 4u);
+}
+
+TEST(XORDelta, SparseChanges)
+{
+  std::vector<u8> base(256 * 1024);
+  std::mt19937 rng(1234);
+  for (u8& v : base)
+    v = static_cast<u8>(rng());
+
+  std::vector<u8> data = base;
+  for (u32 i = 0; i < 100; i++)
+    data[rng() % data.size()] ^= 0xFF;
+
+  size_t delta_size;
+  ASSERT_EQ(RoundTrip(data, base, &delta_size), data);
+  ASSERT_LT(delta_size, 1024u);
+}
+
+TEST(XORDelta, SizeChanges)
+{
+  std::vector<u8> base(10000, 1);
+  std::vector<u8> larger(15000, 1);
+  larger[12000] = 7;
+  ASSERT_EQ(RoundTrip(larger, base), larger);
+
+  std::vector<u8> smaller(5000, 2);
+  ASSERT_EQ(RoundTrip(smaller, base), smaller);
+  ASSERT_EQ(RoundTrip(std::vector<u8>(), base), std::vector<u8>());
+}
+
+TEST(XORDelta, StaleTailIsCleared)
+{
+  // Bytes past the base size must not leak into the result, even if the buffer had them.
+  const std::vector<u8> base(100, 3);
+  const std::vector<u8> data(200, 0);
+  std::vector<u8> delta;
+  XORDelta::Encode(&delta, data, base);
+
+  std::vector<u8> buffer(200, 0xEE);
+  std::fill_n(buffer.begin(), base.size(), 3);
+  ASSERT_TRUE(XORDelta::Apply(buffer, base.size(), delta));
+  ASSERT_EQ(buffer, data);
+}
+
+TEST(XORDelta, RandomRoundTrips)
+{
+  std::mt19937 rng(42);
+  for (u32 iter = 0; iter < 50; iter++)
+  {
+    std::vector<u8> base(rng() % 20000);
+    for (u8& v : base)
+      v = static_cast<u8>(rng() % 4);
+
+    std::vector<u8> data = base;
+    data.resize(rng() % 20000);
+    for (u32 i = 0, count = rng() % 2000; i < count && !data.empty(); i++)
+      data[rng() % data.size()] = static_cast<u8>(rng());
+
+    ASSERT_EQ(RoundTrip(data, base), data);
+  }
+}
+
+TEST(XORDelta, RejectsMalformedDelta)
+{
+  const std::vector<u8> base(100, 0);
+  std::vector<u8> data(100, 9);
+  std::vector<u8> delta;
+  XORDelta::Encode(&delta, data, base);
+
+  std::vector<u8> buffer = base;
+  ASSERT_FALSE(XORDelta::Apply(buffer, base.size(), std::span<const u8>(delta.data(), delta.size() - 1)));
+
+  std::vector<u8> wrong_size(50);
+  ASSERT_FALSE(XORDelta::Apply(wrong_size, base.size(), delta));
+}
@@ -110,6 +110,13 @@ public:
   void Remove(u32 count)
   {
     DebugAssert(m_size >= count);
+    if constexpr (std::is_trivially_destructible_v<T>)
+    {
+      m_head = (m_head + count) % CAPACITY;
+      m_size -= count;
+      return;
+    }
+
     for (u32 i = 0; i < count; i++)
     {
       m_ptr[m_head].~T();
@@ -140,6 +147,16 @@ public:
   void PopRange(T* out_data, u32 count)
   {
     DebugAssert(m_size >= count);
+    if constexpr (std::is_standard_layout_v<T> && std::is_trivial_v<T>)
+    {
+      const u32 count_before_end = std::min(CAPACITY - m_head, count);
+      std::memcpy(out_data, &m_ptr[m_head], sizeof(T) * count_before_end);
+      if (count > count_before_end)
+        std::memcpy(out_data + count_before_end, m_ptr, sizeof(T) * (count - count_before_end));
+      m_head = (m_head + count) % CAPACITY;
+      m_size -= count;
+      return;
+    }
 
     for (u32 i = 0; i < count; i++)
     {
@@ -19,6 +19,7 @@
 #include <cerrno>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
@@ -89,6 +90,52 @@ void MemMap::UnmapSharedMemory(void* baseaddr, size_t size)
     Panic("Failed to unmap shared memory");
 }
 
+const void* MemMap::MapFileReadOnly(const char* path, size_t* size, Error* error)
+{
+  const HANDLE file =
+    CreateFileW(StringUtil::UTF8StringToWideString(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    Error::SetWin32(error, "CreateFileW() failed: ", GetLastError());
+    return nullptr;
+  }
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+  {
+    Error::SetStringView(error, "File is empty or size is unknown.");
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  const HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    Error::SetWin32(error, "CreateFileMappingW() failed: ", GetLastError());
+    return nullptr;
+  }
+
+  // the view keeps the mapping alive
+  const void* ret = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!ret)
+  {
+    Error::SetWin32(error, "MapViewOfFile() failed: ", GetLastError());
+    return nullptr;
+  }
+
+  *size = static_cast<size_t>(file_size.QuadPart);
+  return ret;
+}
+
+void MemMap::UnmapFile(const void* ptr, size_t size)
+{
+  if (!UnmapViewOfFile(ptr))
+    Panic("Failed to unmap file");
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea() = default;
 
 SharedMemoryMappingArea::~SharedMemoryMappingArea()
@@ -329,6 +376,16 @@ std::string MemMap::GetFileMappingName(const char* prefix)
   return {};
 }
 
+const void* MemMap::MapFileReadOnly(const char* path, size_t* size, Error* error)
+{
+  Error::SetStringView(error, "File mapping is not supported.");
+  return nullptr;
+}
+
+void MemMap::UnmapFile(const void* ptr, size_t size)
+{
+}
+
 void* ReserveVirtmem(size_t size)
 {
   void* addr = virtmemFindAslr(size, 0x1000);
@@ -693,6 +750,42 @@ void MemMap::UnmapSharedMemory(void* baseaddr, size_t size)
     Panic("Failed to unmap shared memory");
 }
 
+const void* MemMap::MapFileReadOnly(const char* path, size_t* size, Error* error)
+{
+  const int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    Error::SetErrno(error, "open() failed: ", errno);
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    Error::SetStringView(error, "File is empty or size is unknown.");
+    close(fd);
+    return nullptr;
+  }
+
+  // the mapping holds a reference to the file, so it's safe to replace or delete it afterwards
+  void* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED)
+  {
+    Error::SetErrno(error, "mmap() failed: ", errno);
+    return nullptr;
+  }
+
+  *size = static_cast<size_t>(st.st_size);
+  return ptr;
+}
+
+void MemMap::UnmapFile(const void* ptr, size_t size)
+{
+  if (munmap(const_cast<void*>(ptr), size) != 0)
+    Panic("Failed to unmap file");
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea() = default;
 
 SharedMemoryMappingArea::~SharedMemoryMappingArea()
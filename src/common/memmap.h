@@ -52,6 +52,11 @@ void* MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_t size,
 void UnmapSharedMemory(void* baseaddr, size_t size);
 bool MemProtect(void* baseaddr, size_t size, PageProtect mode);
 
+/// Maps an entire file read-only. Pages are loaded on first access and shared with the page cache, so only the parts
+/// which are actually read take up memory. Returns nullptr on failure or if the platform doesn't support it.
+const void* MapFileReadOnly(const char* path, size_t* size, Error* error);
+void UnmapFile(const void* ptr, size_t size);
+
 /// JIT write protect for Apple Silicon. Needs to be called prior to writing to any RWX pages.
 #if !defined(__APPLE__) || !defined(__aarch64__)
 // clang-format off
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "xor_delta.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The stream is a varint decoded size, followed by varint tokens. A token of (n << 1) skips n unchanged bytes, and
+// (n << 1) | 1 is followed by n bytes which are XORed into the buffer. Trailing unchanged bytes are not stored.
+
+namespace XORDelta {
+// Equal bytes shorter than this are kept inside the literal, as a skip token would cost about as much.
+static constexpr size_t MIN_SKIP_LENGTH = 8;
+
+static void WriteVarInt(std::vector<u8>* out, u64 value);
+static bool ReadVarInt(std::span<const u8> in, size_t* pos, u64* value);
+} // namespace XORDelta
+
+void XORDelta::WriteVarInt(std::vector<u8>* out, u64 value)
+{
+  while (value >= 0x80)
+  {
+    out->push_back(static_cast<u8>(value) | 0x80);
+    value >>= 7;
+  }
+  out->push_back(static_cast<u8>(value));
+}
+
+bool XORDelta::ReadVarInt(std::span<const u8> in, size_t* pos, u64* value)
+{
+  u64 result = 0;
+  for (u32 shift = 0; shift < 64; shift += 7)
+  {
+    if (*pos == in.size())
+      return false;
+
+    const u8 byte = in[(*pos)++];
+    result |= static_cast<u64>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      *value = result;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void XORDelta::Encode(std::vector<u8>* out, std::span<const u8> data, std::span<const u8> base)
+{
+  // Past the end of the base, data is compared against zeros.
+  const auto base_byte = [&base](size_t i) -> u8 { return (i < base.size()) ? base[i] : 0; };
+
+  WriteVarInt(out, data.size());
+
+  size_t skip = 0;
+  size_t pos = 0;
+  while (pos < data.size())
+  {
+    const size_t page_end = std::min(pos + COMPARE_PAGE_SIZE, data.size());
+    if (page_end <= base.size() && std::memcmp(&data[pos], &base[pos], page_end - pos) == 0)
+    {
+      skip += page_end - pos;
+      pos = page_end;
+      continue;
+    }
+
+    while (pos < page_end)
+    {
+      if (data[pos] == base_byte(pos))
+      {
+        skip++;
+        pos++;
+        continue;
+      }
+
+      // Extend the literal until we hit enough equal bytes to make a skip worthwhile.
+      size_t literal_end = pos;
+      size_t equal_count = 0;
+      while (literal_end < page_end && equal_count < MIN_SKIP_LENGTH)
+      {
+        equal_count = (data[literal_end] == base_byte(literal_end)) ? (equal_count + 1) : 0;
+        literal_end++;
+      }
+      literal_end -= equal_count;
+
+      if (skip > 0)
+      {
+        WriteVarInt(out, static_cast<u64>(skip) << 1);
+        skip = 0;
+      }
+
+      WriteVarInt(out, (static_cast<u64>(literal_end - pos) << 1) | 1);
+      for (; pos < literal_end; pos++)
+        out->push_back(data[pos] ^ base_byte(pos));
+    }
+  }
+}
+
+std::optional<size_t> XORDelta::GetDecodedSize(std::span<const u8> delta)
+{
+  size_t pos = 0;
+  u64 size;
+  if (!ReadVarInt(delta, &pos, &size))
+    return std::nullopt;
+
+  return static_cast<size_t>(size);
+}
+
+bool XORDelta::Apply(std::span<u8> buffer, size_t base_size, std::span<const u8> delta)
+{
+  size_t delta_pos = 0;
+  u64 decoded_size;
+  if (!ReadVarInt(delta, &delta_pos, &decoded_size) || decoded_size != buffer.size())
+    return false;
+
+  if (base_size < buffer.size())
+    std::memset(&buffer[base_size], 0, buffer.size() - base_size);
+
+  size_t pos = 0;
+  while (delta_pos < delta.size())
+  {
+    u64 token;
+    if (!ReadVarInt(delta, &delta_pos, &token))
+      return false;
+
+    const u64 length = token >> 1;
+    if (length > (buffer.size() - pos))
+      return false;
+
+    if (token & 1)
+    {
+      if (length > (delta.size() - delta_pos))
+        return false;
+
+      for (u64 i = 0; i < length; i++)
+        buffer[pos++] ^= delta[delta_pos++];
+    }
+    else
+    {
+      pos += static_cast<size_t>(length);
+    }
+  }
+
+  return true;
+}
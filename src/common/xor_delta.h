@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+#include "types.h"
+#include <optional>
+#include <span>
+#include <vector>
+
+/// Compact difference between two buffers, stored as the run-length encoded XOR of the two. Identical pages are
+/// skipped with a memcmp(), so encoding cost scales with how much of the buffer actually changed.
+namespace XORDelta {
+
+/// Granularity that unchanged data is skipped at before falling back to a byte-wise scan.
+static constexpr size_t COMPARE_PAGE_SIZE = 4096;
+
+/// Appends the delta which turns base into data to out.
+void Encode(std::vector<u8>* out, std::span<const u8> data, std::span<const u8> base);
+
+/// Returns the size of the buffer which the delta reconstructs, or std::nullopt if it is malformed.
+std::optional<size_t> GetDecodedSize(std::span<const u8> delta);
+
+/// Reconstructs the data that delta was encoded from, in-place. The first base_size bytes of buffer must hold the
+/// base, and buffer must be exactly GetDecodedSize() bytes long. Any bytes past base_size are overwritten.
+bool Apply(std::span<u8> buffer, size_t base_size, std::span<const u8> delta);
+
+} // namespace XORDelta
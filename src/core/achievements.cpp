@@ -26,6 +26,7 @@
 #include "common/scoped_guard.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 
 #include "util/cd_image.h"
 #include "util/http_downloader.h"
@@ -46,6 +47,7 @@
 #include <atomic>
 #include <cstdarg>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <functional>
 #include <string>
@@ -140,7 +142,14 @@ static void DownloadImage(std::string url, std::string cache_filename);
 static bool CreateClient(rc_client_t** client, std::unique_ptr<HTTPDownloader>* http);
 static void DestroyClient(rc_client_t** client, std::unique_ptr<HTTPDownloader>* http);
 static void ClientMessageCallback(const char* message, const rc_client_t* client);
+static u32 ReadMemoryBlock(u32 address, u8* buffer, u32 num_bytes);
 static uint32_t ClientReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client);
+static uint32_t ClientSafeReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client);
+template<rc_client_read_memory_func_t read_memory>
+static uint32_t BenchmarkHashingReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes,
+                                           rc_client_t* client);
+static void BenchmarkServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback,
+                                void* callback_data, rc_client_t* client);
 static void ClientServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback, void* callback_data,
                              rc_client_t* client);
 
@@ -591,7 +600,30 @@ void Achievements::ClientMessageCallback(const char* message, const rc_client_t*
   Log_DevPrint(message);
 }
 
+u32 Achievements::ReadMemoryBlock(u32 address, u8* buffer, u32 num_bytes)
+{
+  // Achievement addresses are physical RAM offsets, so skip the CPU's address translation and copy directly. The
+  // rcheevos memory map for the PS1 only covers RAM, so nothing else needs handling here.
+  if (address >= Bus::g_ram_size)
+    return 0;
+
+  const u32 copy_size = std::min<u32>(Bus::g_ram_size - address, num_bytes);
+  std::memcpy(buffer, Bus::g_unprotected_ram + address, copy_size);
+  return copy_size;
+}
+
 uint32_t Achievements::ClientReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client)
+{
+  // Called for every memref each frame, so most reads should be satisfied by the direct path.
+  if (ReadMemoryBlock(address, buffer, num_bytes) == num_bytes)
+    return num_bytes;
+
+  // Mirrors, BIOS, and reads straddling the end of RAM.
+  return ClientSafeReadMemory(address, buffer, num_bytes, client);
+}
+
+uint32_t Achievements::ClientSafeReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes,
+                                            rc_client_t* client)
 {
   switch (num_bytes)
   {
@@ -615,6 +647,143 @@ uint32_t Achievements::ClientReadMemory(uint32_t address, uint8_t* buffer, uint3
   }
 }
 
+namespace Achievements {
+namespace {
+struct ReadBenchmarkData
+{
+  const std::string* patch_data;
+  u64 read_hash;
+  int load_result;
+};
+} // namespace
+} // namespace Achievements
+
+template<rc_client_read_memory_func_t read_memory>
+uint32_t Achievements::BenchmarkHashingReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes,
+                                                  rc_client_t* client)
+{
+  const uint32_t result = read_memory(address, buffer, num_bytes, client);
+
+  // FNV-1a over everything the runtime asked for and got back. The CPU path never supported 24-bit reads, so those
+  // are left out, otherwise any set using them would show up as a mismatch.
+  if (num_bytes == 3)
+    return result;
+
+  ReadBenchmarkData* data = static_cast<ReadBenchmarkData*>(rc_client_get_userdata(client));
+  const auto mix = [data](u32 value) { data->read_hash = (data->read_hash ^ value) * 0x100000001B3ULL; };
+  mix(address);
+  mix(num_bytes);
+  mix(result);
+  for (u32 i = 0; i < result; i++)
+    mix(buffer[i]);
+
+  return result;
+}
+
+void Achievements::BenchmarkServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback,
+                                       void* callback_data, rc_client_t* client)
+{
+  // Answers just enough of the API to log in and load the set, everything else (unlocks, pings) just succeeds.
+  const ReadBenchmarkData* data = static_cast<const ReadBenchmarkData*>(rc_client_get_userdata(client));
+  const std::string_view post_data = request->post_data ? std::string_view(request->post_data) : std::string_view();
+  const auto is_request = [&post_data](std::string_view name) {
+    return (post_data.starts_with("r=") && post_data.substr(2).starts_with(name) &&
+            (post_data.size() == (name.size() + 2) || post_data[name.size() + 2] == '&'));
+  };
+
+  std::string_view body = R"({"Success":true})";
+  if (is_request("login2"))
+    body = R"({"Success":true,"User":"benchmark","Token":"benchmark"})";
+  else if (is_request("gameid"))
+    body = R"({"Success":true,"GameID":1})";
+  else if (is_request("patch"))
+    body = *data->patch_data;
+  else if (is_request("startsession"))
+    body = R"({"Success":true,"Unlocks":[],"HardcoreUnlocks":[],"ServerNow":0})";
+
+  rc_api_server_response_t response;
+  response.body = body.data();
+  response.body_length = body.size();
+  response.http_status_code = 200;
+  callback(&response, callback_data);
+}
+
+bool Achievements::RunReadBenchmark(const char* path, u32 frames, Error* error)
+{
+  if (!System::IsValid())
+  {
+    Error::SetStringView(error, "Achievement read benchmark needs a running system.");
+    return false;
+  }
+
+  std::optional<std::string> patch_data = FileSystem::ReadFileToString(path, error);
+  if (!patch_data.has_value())
+    return false;
+
+  frames = std::max<u32>(frames, 1);
+
+  // The system isn't running frames while we do this, so both paths see the same RAM and should read the same values.
+  const auto run = [&patch_data, frames, error](const char* name, rc_client_read_memory_func_t read_memory,
+                                                rc_client_read_memory_func_t hashing_read_memory,
+                                                ReadBenchmarkData* data) {
+    *data = {&patch_data.value(), 0xCBF29CE484222325ULL, RC_OK};
+
+    rc_client_t* client = rc_client_create(read_memory, BenchmarkServerCall);
+    if (!client)
+    {
+      Error::SetStringView(error, "rc_client_create() failed.");
+      return false;
+    }
+
+    ScopedGuard client_guard([client]() { rc_client_destroy(client); });
+    rc_client_set_userdata(client, data);
+    rc_client_set_hardcore_enabled(client, 0);
+    rc_client_set_unofficial_enabled(client, 1);
+
+    // The fake server answers synchronously, so both of these have finished when they return.
+    const auto load_callback = [](int result, const char*, rc_client_t*, void* userdata) {
+      static_cast<ReadBenchmarkData*>(userdata)->load_result = result;
+    };
+    rc_client_begin_login_with_token(client, "benchmark", "benchmark", load_callback, data);
+    if (data->load_result == RC_OK)
+      rc_client_begin_load_game(client, "00000000000000000000000000000000", load_callback, data);
+    if (data->load_result != RC_OK || !rc_client_get_game_info(client))
+    {
+      Error::SetStringFmt(error, "Failed to load achievement set: {}", rc_error_str(data->load_result));
+      return false;
+    }
+
+    Common::Timer timer;
+    for (u32 i = 0; i < frames; i++)
+      rc_client_do_frame(client);
+    const double time = timer.GetTimeSeconds();
+
+    rc_client_set_read_memory_function(client, hashing_read_memory);
+    rc_client_do_frame(client);
+
+    Log_InfoFmt("{}: {} frames in {:.2f} ms, {:.2f} us/frame, read hash {:016X}", name, frames, time * 1000.0,
+                time * 1000000.0 / static_cast<double>(frames), data->read_hash);
+    return true;
+  };
+
+  ReadBenchmarkData cpu_data, direct_data;
+  Log_InfoFmt("Running achievement set from '{}' for {} frames.", path, frames);
+  if (!run("CPU reads", &ClientSafeReadMemory, &BenchmarkHashingReadMemory<&ClientSafeReadMemory>, &cpu_data) ||
+      !run("Direct reads", &ClientReadMemory, &BenchmarkHashingReadMemory<&ClientReadMemory>, &direct_data))
+  {
+    return false;
+  }
+
+  if (cpu_data.read_hash != direct_data.read_hash)
+  {
+    Error::SetStringFmt(error, "Direct reads do not match CPU reads ({:016X} vs {:016X}).", direct_data.read_hash,
+                        cpu_data.read_hash);
+    return false;
+  }
+
+  return true;
+}
+
 void Achievements::ClientServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback,
                                     void* callback_data, rc_client_t* client)
 {
@@ -3233,12 +3402,7 @@ void Achievements::RAIntegration::RACallbackWriteMemory(unsigned int address, un
 unsigned int Achievements::RAIntegration::RACallbackReadMemoryBlock(unsigned int nAddress, unsigned char* pBuffer,
                                                                     unsigned int nBytes)
 {
-  if (nAddress >= Bus::g_ram_size)
-    return 0;
-
-  const u32 copy_size = std::min<u32>(Bus::g_ram_size - nAddress, nBytes);
-  std::memcpy(pBuffer, Bus::g_unprotected_ram + nAddress, copy_size);
-  return copy_size;
+  return ReadMemoryBlock(nAddress, pBuffer, nBytes);
 }
 
 #else
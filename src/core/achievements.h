@@ -61,6 +61,10 @@ void IdleUpdate();
 /// Returns true if idle updates are necessary (e.g. outstanding requests).
 bool NeedsIdleUpdate();
 
+/// Times rcheevos processing the achievement set in a saved "patch" API response against the current RAM, once
+/// through the CPU's read functions and once through the direct RAM path. Doesn't contact the server.
+bool RunReadBenchmark(const char* path, u32 frames, Error* error);
+
 /// Saves/loads state.
 bool DoState(StateWrapper& sw);
 
@@ -7,6 +7,7 @@
 #include "host.h"
 #include "host_interface_progress_callback.h"
 #include "interrupt_controller.h"
+#include "perf_sections.h"
 #include "settings.h"
 #include "spu.h"
 #include "system.h"
@@ -750,6 +751,7 @@ void CDROM::InsertMedia(std::unique_ptr<CDImage> media, DiscRegion region)
                  Settings::GetConsoleRegionName(System::GetRegion()));
 
   s_disc_region = region;
+  media->SetDecompressionPrefetch(g_settings.cdrom_chd_prefetch_hunks);
   s_reader.SetMedia(std::move(media));
   SetHoldPosition(0, true);
 
@@ -849,6 +851,13 @@ void CDROM::SetReadaheadSectors(u32 readahead_sectors)
     s_reader.QueueReadSector(s_requested_lba);
 }
 
+void CDROM::SetDecompressionPrefetch(u32 count)
+{
+  // safe to call while the reader thread is active
+  if (s_reader.HasMedia())
+    s_reader.GetMedia()->SetDecompressionPrefetch(count);
+}
+
 void CDROM::CPUClockChanged()
 {
   // reschedule the disc read event
@@ -1426,6 +1435,8 @@ void CDROM::EndCommand()
 
 void CDROM::ExecuteCommand(void*, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::CDROM);
+
   const CommandInfo& ci = s_command_info[static_cast<u8>(s_command)];
   if (Log_DevVisible()) [[unlikely]]
   {
@@ -2147,6 +2158,8 @@ void CDROM::ExecuteTestCommand(u8 subcommand)
 
 void CDROM::ExecuteCommandSecondResponse(void*, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::CDROM);
+
   switch (s_command_second_response)
   {
     case Command::GetID:
@@ -2205,6 +2218,8 @@ void CDROM::UpdateCommandEvent()
 
 void CDROM::ExecuteDrive(void*, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::CDROM);
+
   switch (s_drive_state)
   {
     case DriveState::ShellOpening:
@@ -3394,6 +3409,32 @@ void CDROM::DrawDebugWindow()
                     s_reader.GetBufferedSectorCount());
       }
 
+      if (s_reader.IsUsingThread())
+      {
+        const CDROMAsyncReader::Statistics rstats = s_reader.GetStatistics();
+        const u64 sectors = rstats.cache_hits + rstats.cache_misses;
+        ImGui::Text("Reader: %" PRIu64 " readahead hits, %" PRIu64 " seeks, %.1f%% sector cache hit rate [%" PRIu64
+                    " hits, %" PRIu64 " misses], %" PRIu64 " prefetched [%" PRIu64 " used]",
+                    rstats.readahead_hits, rstats.seeks,
+                    (sectors > 0) ? (static_cast<double>(rstats.cache_hits) * 100.0 / static_cast<double>(sectors)) :
+                                    0.0,
+                    rstats.cache_hits, rstats.cache_misses, rstats.prefetched_sectors, rstats.prefetch_hits);
+      }
+
+      CDImage::DecompressionStats dstats;
+      if (media->GetDecompressionStats(&dstats))
+      {
+        const u64 lookups = dstats.cache_hits + dstats.cache_misses;
+        ImGui::Text("Decompression: %.1f%% hit rate [%" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+                    " waits], %" PRIu64 " prefetched, %.3f ms avg",
+                    (lookups > 0) ? (static_cast<double>(dstats.cache_hits) * 100.0 / static_cast<double>(lookups)) :
+                                    0.0,
+                    dstats.cache_hits, dstats.cache_misses, dstats.prefetch_waits, dstats.blocks_prefetched,
+                    (dstats.blocks_decompressed > 0) ?
+                      (dstats.decompress_time_ms / static_cast<double>(dstats.blocks_decompressed)) :
+                      0.0);
+      }
+
       ImGui::Text("Disc Position: MSF[%02u:%02u:%02u] LBA[%u]", disc_position.minute, disc_position.second,
                   disc_position.frame, disc_position.ToLBA());
 
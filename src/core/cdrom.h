@@ -40,6 +40,7 @@ void DMARead(u32* words, u32 word_count);
 void DrawDebugWindow();
 
 void SetReadaheadSectors(u32 readahead_sectors);
+void SetDecompressionPrefetch(u32 count);
 
 /// Reads a frame from the audio FIFO, used by the SPU.
 std::tuple<s16, s16> GetAudioFrame();
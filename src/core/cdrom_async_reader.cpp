@@ -23,6 +23,10 @@ void CDROMAsyncReader::StartThread(u32 readahead_count)
   m_buffers.resize(readahead_count);
   EmptyBuffers();
 
+  m_sector_cache.resize(SECTOR_CACHE_SIZE);
+  m_seek_history.resize(SEEK_HISTORY_SIZE);
+  ClearSectorCache();
+
   m_shutdown_flag.store(false);
   m_read_thread = std::thread(&CDROMAsyncReader::WorkerThreadEntryPoint, this);
   Log_InfoPrintf("Read thread started with readahead of %u sectors", readahead_count);
@@ -42,6 +46,10 @@ void CDROMAsyncReader::StopThread()
   m_read_thread.join();
   EmptyBuffers();
   m_buffers.clear();
+
+  m_sector_cache = {};
+  m_sector_cache_map = {};
+  m_seek_history = {};
 }
 
 void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
@@ -125,6 +133,7 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
     {
       // great, don't need a seek, but still kick the thread to start reading ahead again
       Log_DebugPrintf("Readahead buffer hit for sector %u", lba);
+      m_stat_readahead_hits.fetch_add(1, std::memory_order_relaxed);
       m_buffer_front.store(next_buffer);
       m_buffer_count.fetch_sub(1);
       m_can_readahead.store(true);
@@ -136,6 +145,7 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
   // we need to toss away our readahead and start fresh
   Log_DebugPrintf("Readahead buffer miss, queueing seek to %u", lba);
   std::unique_lock<std::mutex> lock(m_mutex);
+  m_last_consumed_lba = m_last_returned_lba;
   m_next_position_set.store(true);
   m_next_position = lba;
   m_do_read_cv.notify_one();
@@ -180,13 +190,27 @@ bool CDROMAsyncReader::InternalReadSectorUncached(CDImage::LBA lba, CDImage::Sub
   return true;
 }
 
+CDROMAsyncReader::Statistics CDROMAsyncReader::GetStatistics() const
+{
+  Statistics stats;
+  stats.readahead_hits = m_stat_readahead_hits.load(std::memory_order_relaxed);
+  stats.seeks = m_stat_seeks.load(std::memory_order_relaxed);
+  stats.cache_hits = m_stat_cache_hits.load(std::memory_order_relaxed);
+  stats.cache_misses = m_stat_cache_misses.load(std::memory_order_relaxed);
+  stats.prefetched_sectors = m_stat_prefetched_sectors.load(std::memory_order_relaxed);
+  stats.prefetch_hits = m_stat_prefetch_hits.load(std::memory_order_relaxed);
+  return stats;
+}
+
 bool CDROMAsyncReader::WaitForReadToComplete()
 {
   // Safe without locking with memory_order_seq_cst.
   if (!m_next_position_set.load() && m_buffer_count.load() > 0)
   {
-    Log_TracePrintf("Returning sector %u", m_buffers[m_buffer_front.load()].lba);
-    return m_buffers[m_buffer_front.load()].result;
+    const BufferSlot& buffer = m_buffers[m_buffer_front.load()];
+    Log_TracePrintf("Returning sector %u", buffer.lba);
+    m_last_returned_lba = buffer.lba;
+    return buffer.result;
   }
 
   Common::Timer wait_timer;
@@ -207,6 +231,7 @@ bool CDROMAsyncReader::WaitForReadToComplete()
     Log_WarningPrintf("Had to wait %.2f msec for LBA %u", wait_time, m_buffers[front].lba);
 
   Log_TracePrintf("Returning sector %u after waiting", m_buffers[front].lba);
+  m_last_returned_lba = m_buffers[front].lba;
   return m_buffers[front].result;
 }
 
@@ -234,26 +259,48 @@ bool CDROMAsyncReader::ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock)
   m_buffer_back.store((slot + 1) % static_cast<u32>(m_buffers.size()));
 
   BufferSlot& buffer = m_buffers[slot];
-  buffer.lba = m_media->GetPositionOnDisc();
-  m_is_reading.store(true);
-  lock.unlock();
+  buffer.lba = m_next_read_lba++;
 
-  Log_TracePrintf("Reading LBA %u...", buffer.lba);
-
-  buffer.result = m_media->ReadRawSector(buffer.data.data(), &buffer.subq);
-  if (buffer.result)
+  if (CachedSector* cs = LookupCachedSector(buffer.lba))
   {
-    const double read_time = timer.GetTimeMilliseconds();
-    if (read_time > 1.0f)
-      Log_DevPrintf("Read LBA %u took %.2f msec", buffer.lba, read_time);
+    Log_TracePrintf("Sector cache hit for LBA %u", buffer.lba);
+    m_stat_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    if (cs->prefetched)
+    {
+      m_stat_prefetch_hits.fetch_add(1, std::memory_order_relaxed);
+      cs->prefetched = false;
+    }
+
+    buffer.data = cs->data;
+    buffer.subq = cs->subq;
+    buffer.result = true;
   }
   else
   {
-    Log_ErrorPrintf("Read of LBA %u failed", buffer.lba);
+    m_is_reading.store(true);
+    lock.unlock();
+
+    Log_TracePrintf("Reading LBA %u...", buffer.lba);
+
+    buffer.result = InternalReadSectorUncached(buffer.lba, &buffer.subq, &buffer.data);
+    if (buffer.result)
+    {
+      const double read_time = timer.GetTimeMilliseconds();
+      if (read_time > 1.0f)
+        Log_DevPrintf("Read LBA %u took %.2f msec", buffer.lba, read_time);
+    }
+    else
+    {
+      Log_ErrorPrintf("Read of LBA %u failed", buffer.lba);
+    }
+
+    lock.lock();
+    m_is_reading.store(false);
+    m_stat_cache_misses.fetch_add(1, std::memory_order_relaxed);
+    if (buffer.result)
+      InsertCachedSector(buffer.lba, buffer.data, buffer.subq, false);
   }
 
-  lock.lock();
-  m_is_reading.store(false);
   m_buffer_count.fetch_add(1);
   m_notify_read_complete_cv.notify_all();
   return true;
@@ -306,6 +353,150 @@ void CDROMAsyncReader::CancelReadahead()
   // prevent it from doing any more when it re-acquires the lock
   m_can_readahead.store(false);
   EmptyBuffers();
+
+  // media is changing, so nothing we've cached or learned is relevant
+  ClearSectorCache();
+}
+
+CDROMAsyncReader::CachedSector* CDROMAsyncReader::LookupCachedSector(CDImage::LBA lba)
+{
+  const auto it = m_sector_cache_map.find(lba);
+  if (it == m_sector_cache_map.end())
+    return nullptr;
+
+  CachedSector& cs = m_sector_cache[it->second];
+  cs.last_used = ++m_sector_cache_counter;
+  return &cs;
+}
+
+void CDROMAsyncReader::InsertCachedSector(CDImage::LBA lba, const SectorBuffer& data, const CDImage::SubChannelQ& subq,
+                                          bool prefetched)
+{
+  u32 index = 0;
+  for (u32 i = 1; i < SECTOR_CACHE_SIZE; i++)
+  {
+    if (m_sector_cache[i].last_used < m_sector_cache[index].last_used)
+      index = i;
+  }
+
+  CachedSector& cs = m_sector_cache[index];
+  if (cs.lba != INVALID_LBA)
+    m_sector_cache_map.erase(cs.lba);
+
+  cs.lba = lba;
+  cs.last_used = ++m_sector_cache_counter;
+  cs.prefetched = prefetched;
+  cs.data = data;
+  cs.subq = subq;
+  m_sector_cache_map.emplace(lba, index);
+}
+
+void CDROMAsyncReader::ClearSectorCache()
+{
+  for (CachedSector& cs : m_sector_cache)
+  {
+    cs.lba = INVALID_LBA;
+    cs.last_used = 0;
+    cs.prefetched = false;
+  }
+  m_sector_cache_map.clear();
+  m_sector_cache_counter = 0;
+
+  for (SeekHistoryEntry& entry : m_seek_history)
+    entry = SeekHistoryEntry{INVALID_LBA, INVALID_LBA, 0, 0};
+  m_seek_history_counter = 0;
+
+  m_last_consumed_lba = INVALID_LBA;
+  m_last_returned_lba = INVALID_LBA;
+  m_current_extent_start = INVALID_LBA;
+  m_prefetch_count = 0;
+}
+
+CDROMAsyncReader::SeekHistoryEntry* CDROMAsyncReader::LookupSeekHistory(CDImage::LBA start_lba, bool create)
+{
+  SeekHistoryEntry* lru = nullptr;
+  for (SeekHistoryEntry& entry : m_seek_history)
+  {
+    if (entry.start_lba == start_lba)
+    {
+      entry.last_used = ++m_seek_history_counter;
+      return &entry;
+    }
+
+    if (!lru || entry.last_used < lru->last_used)
+      lru = &entry;
+  }
+
+  if (!create || !lru)
+    return nullptr;
+
+  *lru = SeekHistoryEntry{start_lba, INVALID_LBA, 0, ++m_seek_history_counter};
+  return lru;
+}
+
+void CDROMAsyncReader::RecordSeek(CDImage::LBA lba)
+{
+  m_stat_seeks.fetch_add(1, std::memory_order_relaxed);
+
+  // remember how much of the previous extent was read, and where the game went afterwards
+  if (m_current_extent_start != INVALID_LBA && m_last_consumed_lba != INVALID_LBA &&
+      m_last_consumed_lba >= m_current_extent_start)
+  {
+    SeekHistoryEntry* entry = LookupSeekHistory(m_current_extent_start, true);
+    entry->length = m_last_consumed_lba - m_current_extent_start + 1;
+    entry->next_seek_lba = lba;
+  }
+  m_current_extent_start = lba;
+
+  // if we've been here before, queue up wherever the game went next last time
+  m_prefetch_count = 0;
+  const SeekHistoryEntry* entry = LookupSeekHistory(lba, false);
+  if (!entry || entry->next_seek_lba == INVALID_LBA)
+    return;
+
+  const SeekHistoryEntry* next_entry = LookupSeekHistory(entry->next_seek_lba, false);
+  m_prefetch_lba = entry->next_seek_lba;
+  const u32 length = (next_entry && next_entry->length > 0) ? next_entry->length : DEFAULT_PREFETCH_SECTORS;
+  m_prefetch_count = std::min(length, MAX_PREFETCH_SECTORS);
+  Log_DebugPrintf("Predicting seek from %u to %u, prefetching %u sectors", lba, m_prefetch_lba, m_prefetch_count);
+}
+
+void CDROMAsyncReader::PrefetchSectors(std::unique_lock<std::mutex>& lock)
+{
+  // sequential readahead and seeks always take priority
+  while (m_prefetch_count > 0 && !m_next_position_set.load() && !m_can_readahead.load() && !m_shutdown_flag.load())
+  {
+    const CDImage::LBA lba = m_prefetch_lba++;
+    m_prefetch_count--;
+    if (lba >= m_media->GetLBACount())
+    {
+      m_prefetch_count = 0;
+      break;
+    }
+    else if (LookupCachedSector(lba))
+    {
+      continue;
+    }
+
+    SectorBuffer data;
+    CDImage::SubChannelQ subq;
+    m_is_reading.store(true);
+    lock.unlock();
+
+    const bool result = InternalReadSectorUncached(lba, &subq, &data);
+
+    lock.lock();
+    m_is_reading.store(false);
+    m_notify_read_complete_cv.notify_all();
+    if (!result)
+    {
+      m_prefetch_count = 0;
+      break;
+    }
+
+    InsertCachedSector(lba, data, subq, true);
+    m_stat_prefetched_sectors.fetch_add(1, std::memory_order_relaxed);
+  }
 }
 
 void CDROMAsyncReader::WorkerThreadEntryPoint()
@@ -314,8 +505,9 @@ void CDROMAsyncReader::WorkerThreadEntryPoint()
 
   for (;;)
   {
-    m_do_read_cv.wait(
-      lock, [this]() { return (m_shutdown_flag.load() || m_next_position_set.load() || m_can_readahead.load()); });
+    m_do_read_cv.wait(lock, [this]() {
+      return (m_shutdown_flag.load() || m_next_position_set.load() || m_can_readahead.load() || m_prefetch_count > 0);
+    });
     if (m_shutdown_flag.load())
       break;
 
@@ -328,15 +520,22 @@ void CDROMAsyncReader::WorkerThreadEntryPoint()
         EmptyBuffers();
         m_next_position_set.store(false);
         m_seek_error.store(false);
-        m_is_reading.store(true);
-        lock.unlock();
+        RecordSeek(seek_location);
 
-        // seek without lock held in case it takes time
-        Log_DebugPrintf("Seeking to LBA %u...", seek_location);
-        const bool seek_result = (m_media->GetPositionOnDisc() == seek_location || m_media->Seek(seek_location));
+        // no need to touch the media if we already have the sector, it'll get seeked when we run out of cache
+        bool seek_result = true;
+        if (!LookupCachedSector(seek_location))
+        {
+          m_is_reading.store(true);
+          lock.unlock();
+
+          // seek without lock held in case it takes time
+          Log_DebugPrintf("Seeking to LBA %u...", seek_location);
+          seek_result = (m_media->GetPositionOnDisc() == seek_location || m_media->Seek(seek_location));
 
-        lock.lock();
-        m_is_reading.store(false);
+          lock.lock();
+          m_is_reading.store(false);
+        }
 
         // did another request come in? abort if so
         if (m_next_position_set.load())
@@ -353,11 +552,16 @@ void CDROMAsyncReader::WorkerThreadEntryPoint()
         }
 
         // go go read ahead!
+        m_next_read_lba = seek_location;
         m_can_readahead.store(true);
       }
 
       if (!m_can_readahead.load())
+      {
+        // nothing else to do, so fill the cache for where we think the game is going next
+        PrefetchSectors(lock);
         break;
+      }
 
       // readahead time! read as many sectors as we have space for
       Log_DebugPrintf("Reading ahead %u sectors...", static_cast<u32>(m_buffers.size()) - m_buffer_count.load());
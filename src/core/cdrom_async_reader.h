@@ -8,6 +8,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 class ProgressCallback;
 
@@ -24,6 +26,16 @@ public:
     bool result;
   };
 
+  struct Statistics
+  {
+    u64 readahead_hits;     ///< Requests satisfied by the sequential readahead buffer.
+    u64 seeks;              ///< Requests which needed the reader to start from a new position.
+    u64 cache_hits;         ///< Sectors copied from the sector cache instead of the media.
+    u64 cache_misses;       ///< Sectors read from the media.
+    u64 prefetched_sectors; ///< Sectors read ahead of a predicted seek.
+    u64 prefetch_hits;      ///< Prefetched sectors which were later requested.
+  };
+
   CDROMAsyncReader();
   ~CDROMAsyncReader();
 
@@ -57,13 +69,48 @@ public:
   /// Bypasses the sector cache and reads directly from the image.
   bool ReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data);
 
+  Statistics GetStatistics() const;
+
 private:
+  static constexpr CDImage::LBA INVALID_LBA = static_cast<CDImage::LBA>(-1);
+  static constexpr u32 SECTOR_CACHE_SIZE = 256;
+  static constexpr u32 SEEK_HISTORY_SIZE = 64;
+  static constexpr u32 MAX_PREFETCH_SECTORS = 32;
+  static constexpr u32 DEFAULT_PREFETCH_SECTORS = 8;
+
+  struct CachedSector
+  {
+    CDImage::LBA lba;
+    u32 last_used;
+    bool prefetched;
+    SectorBuffer data;
+    CDImage::SubChannelQ subq;
+  };
+
+  // Where the game went after reading a run of sectors, so we can fetch it before it asks next time.
+  struct SeekHistoryEntry
+  {
+    CDImage::LBA start_lba;
+    CDImage::LBA next_seek_lba;
+    u32 length;
+    u32 last_used;
+  };
+
   void EmptyBuffers();
   bool ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock);
   void ReadSectorNonThreaded(CDImage::LBA lba);
   bool InternalReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data);
   void CancelReadahead();
 
+  CachedSector* LookupCachedSector(CDImage::LBA lba);
+  void InsertCachedSector(CDImage::LBA lba, const SectorBuffer& data, const CDImage::SubChannelQ& subq,
+                          bool prefetched);
+  void ClearSectorCache();
+
+  SeekHistoryEntry* LookupSeekHistory(CDImage::LBA start_lba, bool create);
+  void RecordSeek(CDImage::LBA lba);
+  void PrefetchSectors(std::unique_lock<std::mutex>& lock);
+
   void WorkerThreadEntryPoint();
 
   std::unique_ptr<CDImage> m_media;
@@ -85,4 +132,28 @@ private:
   std::atomic<u32> m_buffer_front{0};
   std::atomic<u32> m_buffer_back{0};
   std::atomic<u32> m_buffer_count{0};
+
+  // Last sector handed back by WaitForReadToComplete(), only accessed by the CPU thread.
+  CDImage::LBA m_last_returned_lba = INVALID_LBA;
+
+  // Everything below is protected by m_mutex, or only accessed by the read thread.
+  CDImage::LBA m_next_read_lba = 0;
+  CDImage::LBA m_last_consumed_lba = INVALID_LBA;
+  CDImage::LBA m_current_extent_start = INVALID_LBA;
+  CDImage::LBA m_prefetch_lba = 0;
+  u32 m_prefetch_count = 0;
+
+  std::vector<CachedSector> m_sector_cache;
+  std::unordered_map<CDImage::LBA, u32> m_sector_cache_map;
+  u32 m_sector_cache_counter = 0;
+
+  std::vector<SeekHistoryEntry> m_seek_history;
+  u32 m_seek_history_counter = 0;
+
+  std::atomic<u64> m_stat_readahead_hits{0};
+  std::atomic<u64> m_stat_seeks{0};
+  std::atomic<u64> m_stat_cache_hits{0};
+  std::atomic<u64> m_stat_cache_misses{0};
+  std::atomic<u64> m_stat_prefetched_sectors{0};
+  std::atomic<u64> m_stat_prefetch_hits{0};
 };
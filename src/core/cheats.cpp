@@ -4,8 +4,10 @@
 #include "cheats.h"
 #include "bus.h"
 #include "common/assert.h"
+#include "common/bitutils.h"
 #include "common/byte_stream.h"
 #include "common/file_system.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
@@ -14,7 +16,9 @@
 #include "cpu_core.h"
 #include "host.h"
 #include "system.h"
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <type_traits>
@@ -202,6 +206,8 @@ bool CheatList::LoadFromPCSXRFile(const char* filename)
 
 bool CheatList::LoadFromPCSXRString(const std::string& str)
 {
+  m_compiled_ops_dirty = true;
+
   std::istringstream iss(str);
 
   std::string line;
@@ -326,6 +332,8 @@ bool CheatList::LoadFromLibretroFile(const char* filename)
 
 bool CheatList::LoadFromLibretroString(const std::string& str)
 {
+  m_compiled_ops_dirty = true;
+
   std::istringstream iss(str);
   std::string line;
   KeyValuePairVector kvp;
@@ -420,6 +428,8 @@ bool CheatList::LoadFromLibretroString(const std::string& str)
 
 bool CheatList::LoadFromEPSXeString(const std::string& str)
 {
+  m_compiled_ops_dirty = true;
+
   std::istringstream iss(str);
 
   std::string line;
@@ -551,21 +561,677 @@ bool CheatList::ParseLibretroCheat(CheatCode* cc, const char* line)
   return !cc->instructions.empty();
 }
 
+template<typename T>
+ALWAYS_INLINE static T DoRAMRead(u32 address)
+{
+  T value;
+  std::memcpy(&value, &Bus::g_unprotected_ram[address & Bus::g_ram_mask], sizeof(T));
+  return value;
+}
+
+template<typename T>
+ALWAYS_INLINE static void DoRAMWrite(u32 address, T value)
+{
+  // Same semantics as CPU::SafeWriteMemory*(), only touch memory and invalidate code when the value changes.
+  const u32 offset = address & Bus::g_ram_mask;
+  T old_value;
+  std::memcpy(&old_value, &Bus::g_unprotected_ram[offset], sizeof(T));
+  if (old_value == value)
+    return;
+
+  std::memcpy(&Bus::g_unprotected_ram[offset], &value, sizeof(T));
+
+  const u32 page_index = offset / HOST_PAGE_SIZE;
+  if (Bus::g_ram_code_bits[page_index])
+    CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+}
+
+template<typename T>
+ALWAYS_INLINE static bool IsAlignedRAMAddress(u32 address)
+{
+  return (address < Bus::RAM_MIRROR_END && (address % sizeof(T)) == 0);
+}
+
+template<typename T>
+static void DoCompiledSlide(u32 address, u32 value, u32 count, u32 address_step, u32 value_step)
+{
+  // Fill in a single pass when the whole slide stays within one RAM mirror.
+  const u32 offset = address & Bus::g_ram_mask;
+  if (address_step == sizeof(T) && value_step == 0 && IsAlignedRAMAddress<T>(address) &&
+      (offset + count * sizeof(T)) <= Bus::g_ram_size)
+  {
+    const T fill_value = static_cast<T>(value);
+    u8* ptr = &Bus::g_unprotected_ram[offset];
+    u32 remaining = count * sizeof(T);
+    u32 page_index = offset / HOST_PAGE_SIZE;
+    u32 page_offset = offset % HOST_PAGE_SIZE;
+    while (remaining > 0)
+    {
+      const u32 chunk_size = std::min<u32>(remaining, static_cast<u32>(HOST_PAGE_SIZE) - page_offset);
+      bool changed = false;
+      for (u32 i = 0; i < chunk_size; i += sizeof(T))
+      {
+        T old_value;
+        std::memcpy(&old_value, ptr + i, sizeof(T));
+        changed |= (old_value != fill_value);
+        std::memcpy(ptr + i, &fill_value, sizeof(T));
+      }
+      if (changed && Bus::g_ram_code_bits[page_index])
+        CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+
+      ptr += chunk_size;
+      remaining -= chunk_size;
+      page_index++;
+      page_offset = 0;
+    }
+
+    return;
+  }
+
+  for (u32 i = 0; i < count; i++)
+  {
+    if (IsAlignedRAMAddress<T>(address))
+      DoRAMWrite<T>(address, static_cast<T>(value));
+    else
+      DoMemoryWrite<T>(address, static_cast<T>(value));
+
+    address += address_step;
+    value += value_step;
+  }
+}
+
+static void DoCompiledMemoryCopy(u32 src_address, u32 dst_address, u32 byte_count)
+{
+  // The interpreter copies forwards a byte at a time, so only a destination overlapping the tail of the source
+  // (which replicates the pattern) can't be done with memmove.
+  const u32 src_offset = src_address & Bus::g_ram_mask;
+  const u32 dst_offset = dst_address & Bus::g_ram_mask;
+  if (src_address < Bus::RAM_MIRROR_END && dst_address < Bus::RAM_MIRROR_END &&
+      (src_offset + byte_count) <= Bus::g_ram_size && (dst_offset + byte_count) <= Bus::g_ram_size &&
+      (dst_offset <= src_offset || dst_offset >= (src_offset + byte_count)))
+  {
+    u32 copied = 0;
+    while (copied < byte_count)
+    {
+      const u32 page_index = (dst_offset + copied) / HOST_PAGE_SIZE;
+      const u32 page_offset = (dst_offset + copied) % HOST_PAGE_SIZE;
+      const u32 chunk_size = std::min<u32>(byte_count - copied, static_cast<u32>(HOST_PAGE_SIZE) - page_offset);
+      u8* dst = &Bus::g_unprotected_ram[dst_offset + copied];
+      const u8* src = &Bus::g_unprotected_ram[src_offset + copied];
+      if (std::memcmp(dst, src, chunk_size) != 0)
+      {
+        std::memmove(dst, src, chunk_size);
+        if (Bus::g_ram_code_bits[page_index])
+          CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+      }
+
+      copied += chunk_size;
+    }
+
+    return;
+  }
+
+  for (u32 i = 0; i < byte_count; i++)
+  {
+    const u8 value = DoMemoryRead<u8>(src_address);
+    DoMemoryWrite<u8>(dst_address, value);
+    src_address++;
+    dst_address++;
+  }
+}
+
+template<typename T>
+ALWAYS_INLINE T CheatList::DoCompiledRead(CompiledRegion region, u32 address)
+{
+  if (region == CompiledRegion::RAM)
+  {
+    return DoRAMRead<T>(address);
+  }
+  else if (region == CompiledRegion::Scratchpad)
+  {
+    T value;
+    std::memcpy(&value, &CPU::g_state.scratchpad[address], sizeof(T));
+    return value;
+  }
+  else
+  {
+    return DoMemoryRead<T>(address);
+  }
+}
+
+template<typename T>
+ALWAYS_INLINE void CheatList::DoCompiledWrite(CompiledRegion region, u32 address, T value)
+{
+  if (region == CompiledRegion::RAM)
+    DoRAMWrite<T>(address, value);
+  else if (region == CompiledRegion::Scratchpad)
+    std::memcpy(&CPU::g_state.scratchpad[address], &value, sizeof(T));
+  else
+    DoMemoryWrite<T>(address, value);
+}
+
+bool CheatList::CanCompileCode(const CheatCode& cc)
+{
+  using InstructionCode = CheatCode::InstructionCode;
+
+  const u32 count = static_cast<u32>(cc.instructions.size());
+  for (u32 i = 0; i < count; i++)
+  {
+    const CheatCode::Instruction& inst = cc.instructions[i];
+    switch (inst.code)
+    {
+      case InstructionCode::Nop:
+      case InstructionCode::ConstantWrite8:
+      case InstructionCode::ConstantWrite16:
+      case InstructionCode::ExtConstantWrite32:
+      case InstructionCode::ExtConstantBitSet8:
+      case InstructionCode::ExtConstantBitSet16:
+      case InstructionCode::ExtConstantBitSet32:
+      case InstructionCode::ExtConstantBitClear8:
+      case InstructionCode::ExtConstantBitClear16:
+      case InstructionCode::ExtConstantBitClear32:
+      case InstructionCode::ScratchpadWrite16:
+      case InstructionCode::ExtScratchpadWrite32:
+      case InstructionCode::ExtIncrement32:
+      case InstructionCode::ExtDecrement32:
+      case InstructionCode::Increment16:
+      case InstructionCode::Decrement16:
+      case InstructionCode::Increment8:
+      case InstructionCode::Decrement8:
+      case InstructionCode::ExtConstantWriteIfMatch16:
+      case InstructionCode::ExtConstantWriteIfMatchWithRestore16:
+      case InstructionCode::CompareEqual16:
+      case InstructionCode::CompareNotEqual16:
+      case InstructionCode::CompareLess16:
+      case InstructionCode::CompareGreater16:
+      case InstructionCode::CompareEqual8:
+      case InstructionCode::CompareNotEqual8:
+      case InstructionCode::CompareLess8:
+      case InstructionCode::CompareGreater8:
+      case InstructionCode::ExtCompareEqual32:
+      case InstructionCode::ExtCompareNotEqual32:
+      case InstructionCode::ExtCompareLess32:
+      case InstructionCode::ExtCompareGreater32:
+      case InstructionCode::CompareButtons:
+      case InstructionCode::SkipIfNotEqual16:
+      case InstructionCode::ExtSkipIfNotEqual32:
+      case InstructionCode::SkipIfButtonsNotEqual:
+      case InstructionCode::SkipIfButtonsEqual:
+      case InstructionCode::ExtSkipIfNotLess8:
+      case InstructionCode::ExtSkipIfNotGreater8:
+      case InstructionCode::ExtSkipIfNotLess16:
+      case InstructionCode::ExtSkipIfNotGreater16:
+      case InstructionCode::DelayActivation:
+        break;
+
+      case InstructionCode::Slide:
+      case InstructionCode::ExtImprovedSlide:
+      case InstructionCode::MemoryCopy:
+      {
+        // Leave incomplete and invalid codes to the interpreter, so they still log errors.
+        if ((i + 1) >= count)
+          return false;
+
+        const InstructionCode write_type = cc.instructions[i + 1].code;
+        if ((inst.code == InstructionCode::Slide && write_type != InstructionCode::ConstantWrite8 &&
+             write_type != InstructionCode::ConstantWrite16) ||
+            (inst.code == InstructionCode::ExtImprovedSlide && write_type != InstructionCode::ConstantWrite8 &&
+             write_type != InstructionCode::ConstantWrite16 && write_type != InstructionCode::ExtConstantWrite32))
+        {
+          return false;
+        }
+      }
+      break;
+
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void CheatList::CompileCode(const CheatCode& cc, u32 code_index)
+{
+  using InstructionCode = CheatCode::InstructionCode;
+
+  const u32 base = static_cast<u32>(m_compiled_ops.size());
+  if (!CanCompileCode(cc))
+  {
+    CompiledOp& op = m_compiled_ops.emplace_back();
+    op.type = CompiledOpType::Interpret;
+    op.param = code_index;
+    return;
+  }
+
+  const auto get_region = [](u32 address, u32 size) {
+    if ((address % size) != 0)
+      return CompiledRegion::Bus;
+    else if ((address & CPU::SCRATCHPAD_ADDR_MASK) == CPU::SCRATCHPAD_ADDR)
+      return CompiledRegion::Scratchpad;
+    else if (address < Bus::RAM_MIRROR_END)
+      return CompiledRegion::RAM;
+    else
+      return CompiledRegion::Bus;
+  };
+
+  const u32 count = static_cast<u32>(cc.instructions.size());
+  for (u32 i = 0; i < count; i++)
+  {
+    const CheatCode::Instruction& inst = cc.instructions[i];
+    CompiledOp op = {};
+    op.address = inst.address;
+
+    const auto set_memory_op = [&op, &get_region](CompiledOpType type, u32 size, u32 value) {
+      op.type = type;
+      op.region = get_region(op.address, size);
+      op.value = value;
+      if (op.region == CompiledRegion::Scratchpad)
+        op.address &= CPU::SCRATCHPAD_OFFSET_MASK;
+    };
+
+    // Targets for failed conditions, matching the interpreter's skip behavior.
+    const auto get_skip_target = [&cc, base, i]() { return base + cc.GetNextNonConditionalInstruction(i); };
+    const auto get_separator_target = [&cc, base, count, i]() {
+      constexpr u64 separator_value = UINT64_C(0x000000000000FFFF);
+      u32 index = i + 1;
+      while (index < count)
+      {
+        if (cc.instructions[index++].bits == separator_value)
+          break;
+      }
+      return base + index;
+    };
+
+    switch (inst.code)
+    {
+      case InstructionCode::Nop:
+        op.type = CompiledOpType::Nop;
+        break;
+
+      case InstructionCode::ConstantWrite8:
+        set_memory_op(CompiledOpType::Write8, 1, inst.value8);
+        break;
+      case InstructionCode::ConstantWrite16:
+        set_memory_op(CompiledOpType::Write16, 2, inst.value16);
+        break;
+      case InstructionCode::ExtConstantWrite32:
+        set_memory_op(CompiledOpType::Write32, 4, inst.value32);
+        break;
+
+      case InstructionCode::ExtConstantBitSet8:
+        set_memory_op(CompiledOpType::Or8, 1, inst.value8);
+        break;
+      case InstructionCode::ExtConstantBitSet16:
+        set_memory_op(CompiledOpType::Or16, 2, inst.value16);
+        break;
+      case InstructionCode::ExtConstantBitSet32:
+        set_memory_op(CompiledOpType::Or32, 4, inst.value32);
+        break;
+
+      case InstructionCode::ExtConstantBitClear8:
+        set_memory_op(CompiledOpType::And8, 1, Truncate8(~inst.value8));
+        break;
+      case InstructionCode::ExtConstantBitClear16:
+        set_memory_op(CompiledOpType::And16, 2, Truncate16(~inst.value16));
+        break;
+      case InstructionCode::ExtConstantBitClear32:
+        set_memory_op(CompiledOpType::And32, 4, ~inst.value32);
+        break;
+
+      case InstructionCode::ScratchpadWrite16:
+        op.address = CPU::SCRATCHPAD_ADDR | (inst.address & CPU::SCRATCHPAD_OFFSET_MASK);
+        set_memory_op(CompiledOpType::Write16, 2, inst.value16);
+        break;
+      case InstructionCode::ExtScratchpadWrite32:
+        op.address = CPU::SCRATCHPAD_ADDR | (inst.address & CPU::SCRATCHPAD_OFFSET_MASK);
+        set_memory_op(CompiledOpType::Write32, 4, inst.value32);
+        break;
+
+      // Decrements are wrapping additions of the negated value.
+      case InstructionCode::Increment8:
+        set_memory_op(CompiledOpType::Add8, 1, inst.value8);
+        break;
+      case InstructionCode::Decrement8:
+        set_memory_op(CompiledOpType::Add8, 1, Truncate8(0u - inst.value8));
+        break;
+      case InstructionCode::Increment16:
+        set_memory_op(CompiledOpType::Add16, 2, inst.value16);
+        break;
+      case InstructionCode::Decrement16:
+        set_memory_op(CompiledOpType::Add16, 2, Truncate16(0u - inst.value16));
+        break;
+      case InstructionCode::ExtIncrement32:
+        set_memory_op(CompiledOpType::Add32, 4, inst.value32);
+        break;
+      case InstructionCode::ExtDecrement32:
+        set_memory_op(CompiledOpType::Add32, 4, 0u - inst.value32);
+        break;
+
+      case InstructionCode::ExtConstantWriteIfMatch16:
+      case InstructionCode::ExtConstantWriteIfMatchWithRestore16:
+        set_memory_op(CompiledOpType::WriteIfMatch16, 2, inst.value32 & 0xFFFFu);
+        op.param = (inst.value32 >> 16) & 0xFFFFu;
+        break;
+
+      case InstructionCode::CompareEqual16:
+        set_memory_op(CompiledOpType::Equal16, 2, inst.value16);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareNotEqual16:
+        set_memory_op(CompiledOpType::NotEqual16, 2, inst.value16);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareLess16:
+        set_memory_op(CompiledOpType::Less16, 2, inst.value16);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareGreater16:
+        set_memory_op(CompiledOpType::Greater16, 2, inst.value16);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareEqual8:
+        set_memory_op(CompiledOpType::Equal8, 1, inst.value8);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareNotEqual8:
+        set_memory_op(CompiledOpType::NotEqual8, 1, inst.value8);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareLess8:
+        set_memory_op(CompiledOpType::Less8, 1, inst.value8);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareGreater8:
+        set_memory_op(CompiledOpType::Greater8, 1, inst.value8);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::ExtCompareEqual32:
+        set_memory_op(CompiledOpType::Equal32, 4, inst.value32);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::ExtCompareNotEqual32:
+        set_memory_op(CompiledOpType::NotEqual32, 4, inst.value32);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::ExtCompareLess32:
+        set_memory_op(CompiledOpType::Less32, 4, inst.value32);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::ExtCompareGreater32:
+        set_memory_op(CompiledOpType::Greater32, 4, inst.value32);
+        op.target = get_skip_target();
+        break;
+      case InstructionCode::CompareButtons: // D4
+        op.type = CompiledOpType::ButtonsEqual;
+        op.value = inst.value16;
+        op.target = get_skip_target();
+        break;
+
+      case InstructionCode::SkipIfNotEqual16: // C0
+        set_memory_op(CompiledOpType::Equal16, 2, inst.value16);
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::ExtSkipIfNotEqual32: // A4
+        set_memory_op(CompiledOpType::Equal32, 4, inst.value32);
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::SkipIfButtonsNotEqual: // D5
+        op.type = CompiledOpType::ButtonsEqual;
+        op.value = inst.value16;
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::SkipIfButtonsEqual: // D6
+        op.type = CompiledOpType::ButtonsNotEqual;
+        op.value = inst.value16;
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::ExtSkipIfNotLess8: // C3
+        set_memory_op(CompiledOpType::Less8, 1, inst.value8);
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::ExtSkipIfNotGreater8: // C4
+        set_memory_op(CompiledOpType::Greater8, 1, inst.value8);
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::ExtSkipIfNotLess16: // C5
+        set_memory_op(CompiledOpType::Less16, 2, inst.value16);
+        op.target = get_separator_target();
+        break;
+      case InstructionCode::ExtSkipIfNotGreater16: // C6
+        set_memory_op(CompiledOpType::Greater16, 2, inst.value16);
+        op.target = get_separator_target();
+        break;
+
+      case InstructionCode::DelayActivation: // C1
+        op.type = CompiledOpType::DelayActivation;
+        op.value = inst.value16;
+        op.target = base + count;
+        break;
+
+      case InstructionCode::Slide:
+      {
+        const CheatCode::Instruction& inst2 = cc.instructions[i + 1];
+        op.type = (inst2.code == InstructionCode::ConstantWrite8) ? CompiledOpType::Slide8 : CompiledOpType::Slide16;
+        op.address = inst2.address;
+        op.value = inst2.value16;
+        op.param = (inst.first >> 8) & 0xFFu;
+        op.address_step = inst.first & 0xFFu;
+        op.value_step = inst.second & 0xFFFFu;
+        op.target = base + i + 2;
+      }
+      break;
+
+      case InstructionCode::ExtImprovedSlide:
+      {
+        const CheatCode::Instruction& inst2 = cc.instructions[i + 1];
+        const u32 address_change = (inst.second >> 16) & 0xFFFFu;
+        const u32 value_change = inst.second & 0xFFFFu;
+        op.type = (inst2.code == InstructionCode::ConstantWrite8) ?
+                    CompiledOpType::Slide8 :
+                    ((inst2.code == InstructionCode::ConstantWrite16) ? CompiledOpType::Slide16 :
+                                                                        CompiledOpType::Slide32);
+        op.address = inst2.address;
+        op.value = inst2.value32;
+        op.param = inst.first & 0xFFFFu;
+        op.address_step = ((inst.first >> 20) & 0x1u) ? (0u - address_change) : address_change;
+        op.value_step = ((inst.first >> 16) & 0x1u) ? (0u - value_change) : value_change;
+        op.target = base + i + 2;
+      }
+      break;
+
+      case InstructionCode::MemoryCopy:
+      {
+        op.type = CompiledOpType::MemoryCopy;
+        op.param = cc.instructions[i + 1].address;
+        op.value = inst.value16;
+        op.target = base + i + 2;
+      }
+      break;
+
+      default:
+        UnreachableCode();
+        break;
+    }
+
+    m_compiled_ops.push_back(op);
+  }
+}
+
+void CheatList::CompileCodes()
+{
+  m_compiled_ops.clear();
+  for (u32 i = 0; i < static_cast<u32>(m_codes.size()); i++)
+  {
+    const CheatCode& cc = m_codes[i];
+    if (cc.enabled)
+      CompileCode(cc, i);
+  }
+
+  m_compiled_ops_dirty = false;
+  Log_DevPrintf("Compiled %u cheat codes to %zu ops", GetEnabledCodeCount(), m_compiled_ops.size());
+}
+
 void CheatList::Apply()
 {
   if (!m_master_enable)
     return;
 
-  for (const CheatCode& code : m_codes)
+  if (m_compiled_ops_dirty)
+    CompileCodes();
+
+  // Codes are laid out back to back, so jumping to the end of a code continues with the next one.
+  const u32 count = static_cast<u32>(m_compiled_ops.size());
+  for (u32 index = 0; index < count;)
   {
-    if (code.enabled)
-      code.Apply();
+    const CompiledOp& op = m_compiled_ops[index];
+    const CompiledRegion region = op.region;
+
+#define CONDITION_OP(type, cond)                                                                                       \
+  {                                                                                                                    \
+    const type value = DoCompiledRead<type>(region, op.address);                                                      \
+    index = (value cond static_cast<type>(op.value)) ? (index + 1) : op.target;                                       \
+  }                                                                                                                    \
+  break;
+
+    switch (op.type)
+    {
+      case CompiledOpType::Nop:
+        index++;
+        break;
+
+      case CompiledOpType::Interpret:
+        m_codes[op.param].Apply();
+        index++;
+        break;
+
+      case CompiledOpType::Write8:
+        DoCompiledWrite<u8>(region, op.address, Truncate8(op.value));
+        index++;
+        break;
+      case CompiledOpType::Write16:
+        DoCompiledWrite<u16>(region, op.address, Truncate16(op.value));
+        index++;
+        break;
+      case CompiledOpType::Write32:
+        DoCompiledWrite<u32>(region, op.address, op.value);
+        index++;
+        break;
+
+      case CompiledOpType::Or8:
+        DoCompiledWrite<u8>(region, op.address, DoCompiledRead<u8>(region, op.address) | Truncate8(op.value));
+        index++;
+        break;
+      case CompiledOpType::Or16:
+        DoCompiledWrite<u16>(region, op.address, DoCompiledRead<u16>(region, op.address) | Truncate16(op.value));
+        index++;
+        break;
+      case CompiledOpType::Or32:
+        DoCompiledWrite<u32>(region, op.address, DoCompiledRead<u32>(region, op.address) | op.value);
+        index++;
+        break;
+
+      case CompiledOpType::And8:
+        DoCompiledWrite<u8>(region, op.address, DoCompiledRead<u8>(region, op.address) & Truncate8(op.value));
+        index++;
+        break;
+      case CompiledOpType::And16:
+        DoCompiledWrite<u16>(region, op.address, DoCompiledRead<u16>(region, op.address) & Truncate16(op.value));
+        index++;
+        break;
+      case CompiledOpType::And32:
+        DoCompiledWrite<u32>(region, op.address, DoCompiledRead<u32>(region, op.address) & op.value);
+        index++;
+        break;
+
+      case CompiledOpType::Add8:
+        DoCompiledWrite<u8>(region, op.address, DoCompiledRead<u8>(region, op.address) + Truncate8(op.value));
+        index++;
+        break;
+      case CompiledOpType::Add16:
+        DoCompiledWrite<u16>(region, op.address, DoCompiledRead<u16>(region, op.address) + Truncate16(op.value));
+        index++;
+        break;
+      case CompiledOpType::Add32:
+        DoCompiledWrite<u32>(region, op.address, DoCompiledRead<u32>(region, op.address) + op.value);
+        index++;
+        break;
+
+      case CompiledOpType::WriteIfMatch16:
+      {
+        if (DoCompiledRead<u16>(region, op.address) == Truncate16(op.param))
+          DoCompiledWrite<u16>(region, op.address, Truncate16(op.value));
+        index++;
+      }
+      break;
+
+      case CompiledOpType::Equal8:
+        CONDITION_OP(u8, ==)
+      case CompiledOpType::Equal16:
+        CONDITION_OP(u16, ==)
+      case CompiledOpType::Equal32:
+        CONDITION_OP(u32, ==)
+      case CompiledOpType::NotEqual8:
+        CONDITION_OP(u8, !=)
+      case CompiledOpType::NotEqual16:
+        CONDITION_OP(u16, !=)
+      case CompiledOpType::NotEqual32:
+        CONDITION_OP(u32, !=)
+      case CompiledOpType::Less8:
+        CONDITION_OP(u8, <)
+      case CompiledOpType::Less16:
+        CONDITION_OP(u16, <)
+      case CompiledOpType::Less32:
+        CONDITION_OP(u32, <)
+      case CompiledOpType::Greater8:
+        CONDITION_OP(u8, >)
+      case CompiledOpType::Greater16:
+        CONDITION_OP(u16, >)
+      case CompiledOpType::Greater32:
+        CONDITION_OP(u32, >)
+
+      case CompiledOpType::ButtonsEqual:
+        index = (GetControllerButtonBits() == op.value) ? (index + 1) : op.target;
+        break;
+      case CompiledOpType::ButtonsNotEqual:
+        index = (GetControllerButtonBits() != op.value) ? (index + 1) : op.target;
+        break;
+
+      case CompiledOpType::DelayActivation:
+        index = (((System::GetFrameNumber() * 10) / 3) < op.value) ? op.target : (index + 1);
+        break;
+
+      case CompiledOpType::Slide8:
+        DoCompiledSlide<u8>(op.address, op.value, op.param, op.address_step, op.value_step);
+        index = op.target;
+        break;
+      case CompiledOpType::Slide16:
+        DoCompiledSlide<u16>(op.address, op.value, op.param, op.address_step, op.value_step);
+        index = op.target;
+        break;
+      case CompiledOpType::Slide32:
+        DoCompiledSlide<u32>(op.address, op.value, op.param, op.address_step, op.value_step);
+        index = op.target;
+        break;
+
+      case CompiledOpType::MemoryCopy:
+        DoCompiledMemoryCopy(op.address, op.param, op.value);
+        index = op.target;
+        break;
+
+      default:
+        UnreachableCode();
+        break;
+    }
+
+#undef CONDITION_OP
   }
 }
 
 void CheatList::AddCode(CheatCode cc)
 {
   m_codes.push_back(std::move(cc));
+  m_compiled_ops_dirty = true;
 }
 
 void CheatList::SetCode(u32 index, CheatCode cc)
@@ -573,6 +1239,7 @@ void CheatList::SetCode(u32 index, CheatCode cc)
   if (index > m_codes.size())
     return;
 
+  m_compiled_ops_dirty = true;
   if (index == m_codes.size())
   {
     m_codes.push_back(std::move(cc));
@@ -585,6 +1252,7 @@ void CheatList::SetCode(u32 index, CheatCode cc)
 void CheatList::RemoveCode(u32 i)
 {
   m_codes.erase(m_codes.begin() + i);
+  m_compiled_ops_dirty = true;
 }
 
 std::optional<CheatList::Format> CheatList::DetectFileFormat(const char* filename)
@@ -689,6 +1357,8 @@ bool CheatList::SaveToPCSXRFile(const char* filename)
 
 bool CheatList::LoadFromPackage(const std::string& serial)
 {
+  m_compiled_ops_dirty = true;
+
   const std::optional<std::string> db_string(Host::ReadResourceFileToString("chtdb.txt", false));
   if (!db_string.has_value())
     return false;
@@ -831,6 +1501,7 @@ void CheatList::SetCodeEnabled(u32 index, bool state)
     return;
 
   m_codes[index].enabled = state;
+  m_compiled_ops_dirty = true;
   if (!state)
     m_codes[index].ApplyOnDisable();
 }
@@ -2819,108 +3490,522 @@ MemoryScan::MemoryScan() = default;
 
 MemoryScan::~MemoryScan() = default;
 
-void MemoryScan::ResetSearch()
+namespace {
+enum class ScanCompare : u8
 {
-  m_results.clear();
+  None,
+  All,
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Generic,
+};
+
+/// Scan operator reduced to a comparison in the element's own type, so it can be evaluated on packed lanes.
+template<typename T>
+struct ScanPredicate
+{
+  MemoryScan::Operator op;
+  ScanCompare compare;
+  bool against_last;
+  T value;
+  u32 comp_value;
+};
+} // namespace
+
+static constexpr u32 SCAN_BLOCK_SIZE = 64;
+
+ALWAYS_INLINE static u64 GetScanBlockMask(u32 count)
+{
+  return (count == SCAN_BLOCK_SIZE) ? ~UINT64_C(0) : ((UINT64_C(1) << count) - 1);
 }
 
-void MemoryScan::Search()
+/// Reads a block of the scan range, returning the mask of elements at valid addresses.
+static u64 ReadScanBlock(PhysicalMemoryAddress address, u8* dst, u32 count, u32 element_size)
 {
-  m_results.clear();
+  const u32 size = count * element_size;
+  const u32 segment = address >> 29;
+  const PhysicalMemoryAddress paddr = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  if ((segment == 0 || segment == 4 || segment == 5) && paddr < Bus::RAM_MIRROR_END &&
+      ((paddr & Bus::g_ram_mask) + size) <= Bus::g_ram_size)
+  {
+    std::memcpy(dst, &Bus::g_unprotected_ram[paddr & Bus::g_ram_mask], size);
+    return GetScanBlockMask(count);
+  }
 
-  switch (m_size)
+  for (u32 i = 0; i < size; i++)
+    dst[i] = DoMemoryRead<u8>(address + i);
+
+  u64 valid = 0;
+  for (u32 i = 0; i < count; i++)
   {
-    case MemoryAccessSize::Byte:
-      SearchBytes();
-      break;
+    if (IsValidScanAddress(address + i * element_size))
+      valid |= UINT64_C(1) << i;
+  }
 
-    case MemoryAccessSize::HalfWord:
-      SearchHalfwords();
+  return valid;
+}
+
+template<typename T>
+static ScanPredicate<T> GetScanPredicate(MemoryScan::Operator op, u32 comp_value)
+{
+  using Operator = MemoryScan::Operator;
+
+  ScanPredicate<T> pred = {op, ScanCompare::Generic, false, 0, comp_value};
+
+  // Byte and halfword values are extended to 32 bits before comparing, so constants outside the element's range
+  // either always or never match.
+  const s64 value = std::is_signed_v<T> ? static_cast<s64>(static_cast<s32>(comp_value)) : static_cast<s64>(comp_value);
+  const s64 min = static_cast<s64>(std::numeric_limits<T>::min());
+  const s64 max = static_cast<s64>(std::numeric_limits<T>::max());
+  const bool in_range = (value >= min && value <= max);
+  pred.value = in_range ? static_cast<T>(value) : 0;
+
+  switch (op)
+  {
+    case Operator::Any:
+      pred.compare = ScanCompare::All;
+      break;
+    case Operator::Equal:
+      pred.compare = in_range ? ScanCompare::Equal : ScanCompare::None;
+      break;
+    case Operator::NotEqual:
+      pred.compare = in_range ? ScanCompare::NotEqual : ScanCompare::All;
+      break;
+    case Operator::LessThan:
+      pred.compare = (value <= min) ? ScanCompare::None : ((value > max) ? ScanCompare::All : ScanCompare::Less);
+      break;
+    case Operator::LessEqual:
+      pred.compare = (value < min) ? ScanCompare::None : ((value >= max) ? ScanCompare::All : ScanCompare::LessEqual);
+      break;
+    case Operator::GreaterThan:
+      pred.compare = (value >= max) ? ScanCompare::None : ((value < min) ? ScanCompare::All : ScanCompare::Greater);
+      break;
+    case Operator::GreaterEqual:
+      pred.compare =
+        (value > max) ? ScanCompare::None : ((value <= min) ? ScanCompare::All : ScanCompare::GreaterEqual);
       break;
 
-    case MemoryAccessSize::Word:
-      SearchWords();
+    case Operator::EqualLast:
+      pred.compare = ScanCompare::Equal;
+      pred.against_last = true;
+      break;
+    case Operator::NotEqualLast:
+      pred.compare = ScanCompare::NotEqual;
+      pred.against_last = true;
+      break;
+    case Operator::LessThanLast:
+      pred.compare = ScanCompare::Less;
+      pred.against_last = true;
+      break;
+    case Operator::LessEqualLast:
+      pred.compare = ScanCompare::LessEqual;
+      pred.against_last = true;
+      break;
+    case Operator::GreaterThanLast:
+      pred.compare = ScanCompare::Greater;
+      pred.against_last = true;
+      break;
+    case Operator::GreaterEqualLast:
+      pred.compare = ScanCompare::GreaterEqual;
+      pred.against_last = true;
       break;
 
     default:
+      pred.compare = ScanCompare::Generic;
       break;
   }
+
+  return pred;
 }
 
-void MemoryScan::SearchBytes()
-{
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address++)
-  {
-    if (!IsValidScanAddress(address))
-      continue;
+#if defined(CPU_ARCH_SSE)
 
-    const u8 bvalue = DoMemoryRead<u8>(address);
+template<typename T>
+ALWAYS_INLINE static __m128i VectorBroadcast(T value)
+{
+  if constexpr (sizeof(T) == 1)
+    return _mm_set1_epi8(static_cast<char>(value));
+  else if constexpr (sizeof(T) == 2)
+    return _mm_set1_epi16(static_cast<short>(value));
+  else
+    return _mm_set1_epi32(static_cast<int>(value));
+}
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+template<typename T>
+ALWAYS_INLINE static __m128i VectorCompareEqual(__m128i a, __m128i b)
+{
+  if constexpr (sizeof(T) == 1)
+    return _mm_cmpeq_epi8(a, b);
+  else if constexpr (sizeof(T) == 2)
+    return _mm_cmpeq_epi16(a, b);
+  else
+    return _mm_cmpeq_epi32(a, b);
+}
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+template<typename T>
+ALWAYS_INLINE static __m128i VectorCompareGreater(__m128i a, __m128i b)
+{
+  // SSE2 only has signed comparisons, flip the sign bit for unsigned.
+  if constexpr (!std::is_signed_v<T>)
+  {
+    const __m128i bias = VectorBroadcast<T>(static_cast<T>(T(1) << (sizeof(T) * 8 - 1)));
+    a = _mm_xor_si128(a, bias);
+    b = _mm_xor_si128(b, bias);
   }
+
+  if constexpr (sizeof(T) == 1)
+    return _mm_cmpgt_epi8(a, b);
+  else if constexpr (sizeof(T) == 2)
+    return _mm_cmpgt_epi16(a, b);
+  else
+    return _mm_cmpgt_epi32(a, b);
 }
 
-void MemoryScan::SearchHalfwords()
+/// Compares 16 elements, returning one bit per element.
+template<typename T>
+ALWAYS_INLINE static u32 VectorCompare16(const u8* a, const u8* b, __m128i value, bool equal, bool swap)
 {
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 2)
+  __m128i masks[sizeof(T)];
+  for (u32 i = 0; i < sizeof(T); i++)
   {
-    if (!IsValidScanAddress(address))
-      continue;
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 16));
+    const __m128i vb = b ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 16)) : value;
+    masks[i] = equal ? VectorCompareEqual<T>(va, vb) :
+                       (swap ? VectorCompareGreater<T>(vb, va) : VectorCompareGreater<T>(va, vb));
+  }
+
+  if constexpr (sizeof(T) == 1)
+    return static_cast<u32>(_mm_movemask_epi8(masks[0]));
+  else if constexpr (sizeof(T) == 2)
+    return static_cast<u32>(_mm_movemask_epi8(_mm_packs_epi16(masks[0], masks[1])));
+  else
+    return static_cast<u32>(_mm_movemask_epi8(
+      _mm_packs_epi16(_mm_packs_epi32(masks[0], masks[1]), _mm_packs_epi32(masks[2], masks[3]))));
+}
 
-    const u16 bvalue = DoMemoryRead<u16>(address);
+#elif defined(CPU_ARCH_NEON)
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+template<typename T>
+ALWAYS_INLINE static uint8x16_t VectorBroadcast(T value)
+{
+  if constexpr (sizeof(T) == 1)
+    return vdupq_n_u8(static_cast<u8>(value));
+  else if constexpr (sizeof(T) == 2)
+    return vreinterpretq_u8_u16(vdupq_n_u16(static_cast<u16>(value)));
+  else
+    return vreinterpretq_u8_u32(vdupq_n_u32(static_cast<u32>(value)));
+}
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+template<typename T>
+ALWAYS_INLINE static uint8x16_t VectorCompareEqual(uint8x16_t a, uint8x16_t b)
+{
+  if constexpr (sizeof(T) == 1)
+    return vceqq_u8(a, b);
+  else if constexpr (sizeof(T) == 2)
+    return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+  else
+    return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+}
+
+template<typename T>
+ALWAYS_INLINE static uint8x16_t VectorCompareGreater(uint8x16_t a, uint8x16_t b)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return vcgtq_u8(a, b);
+  else if constexpr (std::is_same_v<T, s8>)
+    return vcgtq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b));
+  else if constexpr (std::is_same_v<T, u16>)
+    return vreinterpretq_u8_u16(vcgtq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+  else if constexpr (std::is_same_v<T, s16>)
+    return vreinterpretq_u8_u16(vcgtq_s16(vreinterpretq_s16_u8(a), vreinterpretq_s16_u8(b)));
+  else if constexpr (std::is_same_v<T, u32>)
+    return vreinterpretq_u8_u32(vcgtq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+  else
+    return vreinterpretq_u8_u32(vcgtq_s32(vreinterpretq_s32_u8(a), vreinterpretq_s32_u8(b)));
+}
+
+/// Compares 16 elements, returning one bit per element.
+template<typename T>
+ALWAYS_INLINE static u32 VectorCompare16(const u8* a, const u8* b, uint8x16_t value, bool equal, bool swap)
+{
+  uint8x16_t masks[sizeof(T)];
+  for (u32 i = 0; i < sizeof(T); i++)
+  {
+    const uint8x16_t va = vld1q_u8(a + i * 16);
+    const uint8x16_t vb = b ? vld1q_u8(b + i * 16) : value;
+    masks[i] = equal ? VectorCompareEqual<T>(va, vb) :
+                       (swap ? VectorCompareGreater<T>(vb, va) : VectorCompareGreater<T>(va, vb));
+  }
+
+  uint8x16_t mask;
+  if constexpr (sizeof(T) == 1)
+  {
+    mask = masks[0];
   }
+  else if constexpr (sizeof(T) == 2)
+  {
+    mask = vcombine_u8(vmovn_u16(vreinterpretq_u16_u8(masks[0])), vmovn_u16(vreinterpretq_u16_u8(masks[1])));
+  }
+  else
+  {
+    const uint16x8_t lo = vcombine_u16(vmovn_u32(vreinterpretq_u32_u8(masks[0])),
+                                       vmovn_u32(vreinterpretq_u32_u8(masks[1])));
+    const uint16x8_t hi = vcombine_u16(vmovn_u32(vreinterpretq_u32_u8(masks[2])),
+                                       vmovn_u32(vreinterpretq_u32_u8(masks[3])));
+    mask = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+  }
+
+  static constexpr u8 bit_weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  mask = vandq_u8(mask, vld1q_u8(bit_weights));
+  return static_cast<u32>(vaddv_u8(vget_low_u8(mask))) | (static_cast<u32>(vaddv_u8(vget_high_u8(mask))) << 8);
 }
 
-void MemoryScan::SearchWords()
+#endif
+
+/// Evaluates the predicate for up to SCAN_BLOCK_SIZE elements, returning one bit per matching element.
+template<typename T>
+static u64 EvaluateScanBlock(const ScanPredicate<T>& pred, const u8* current, const u8* last, u32 count, bool is_signed)
 {
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 4)
+  if (pred.compare == ScanCompare::None)
+    return 0;
+  else if (pred.compare == ScanCompare::All)
+    return GetScanBlockMask(count);
+
+  u64 result = 0;
+  u32 i = 0;
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  if (pred.compare != ScanCompare::Generic)
   {
-    if (!IsValidScanAddress(address))
-      continue;
+    const bool equal = (pred.compare == ScanCompare::Equal || pred.compare == ScanCompare::NotEqual);
+    const bool swap = (pred.compare == ScanCompare::Less || pred.compare == ScanCompare::GreaterEqual);
+    const u32 invert = (pred.compare == ScanCompare::NotEqual || pred.compare == ScanCompare::LessEqual ||
+                        pred.compare == ScanCompare::GreaterEqual) ?
+                         0xFFFFu :
+                         0u;
+    const auto value = VectorBroadcast<T>(pred.value);
+    const u8* last_ptr = pred.against_last ? last : nullptr;
+    for (; (i + 16) <= count; i += 16)
+    {
+      const u32 bits = VectorCompare16<T>(current + i * sizeof(T), last_ptr ? (last_ptr + i * sizeof(T)) : nullptr,
+                                          value, equal, swap) ^
+                       invert;
+      result |= static_cast<u64>(bits) << i;
+    }
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    T value, last_value;
+    std::memcpy(&value, current + i * sizeof(T), sizeof(T));
+    std::memcpy(&last_value, last + i * sizeof(T), sizeof(T));
+
+    const T rhs = pred.against_last ? last_value : pred.value;
+    bool match;
+    switch (pred.compare)
+    {
+      case ScanCompare::Equal:
+        match = (value == rhs);
+        break;
+      case ScanCompare::NotEqual:
+        match = (value != rhs);
+        break;
+      case ScanCompare::Less:
+        match = (value < rhs);
+        break;
+      case ScanCompare::LessEqual:
+        match = (value <= rhs);
+        break;
+      case ScanCompare::Greater:
+        match = (value > rhs);
+        break;
+      case ScanCompare::GreaterEqual:
+        match = (value >= rhs);
+        break;
+      default:
+      {
+        // Difference operators depend on 32-bit wraparound, so use the same path as individual results.
+        MemoryScan::Result res;
+        res.value = static_cast<u32>(value);
+        res.last_value = static_cast<u32>(last_value);
+        match = res.Filter(pred.op, pred.comp_value, is_signed);
+      }
+      break;
+    }
+
+    result |= static_cast<u64>(match) << i;
+  }
+
+  return result;
+}
 
-    Result res;
-    res.address = address;
-    res.value = DoMemoryRead<u32>(address);
-    res.last_value = res.value;
-    res.value_changed = false;
+void MemoryScan::ResetSearch()
+{
+  m_scan_ranges = {};
+  m_snapshot = {};
+  m_candidates = {};
+  m_result_count = 0;
+  m_results.clear();
+}
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+void MemoryScan::Search()
+{
+  m_scan_size = m_size;
+  m_scan_ranges.clear();
+
+  // The range is free-form and can cover the whole address space, so only keep the parts which are RAM, scratchpad
+  // or BIOS, matching IsValidScanAddress(). Everything else would never produce a result.
+  const u32 element_size = 1u << static_cast<u32>(m_size);
+  const u64 start = m_start_address;
+  const u64 end = m_end_address;
+  u32 num_blocks = 0;
+  const auto add_range = [this, element_size, start, end, &num_blocks](u64 range_start, u64 range_end) {
+    range_start = std::max(range_start, start);
+    range_end = std::min(range_end, end);
+    if (range_start >= range_end)
+      return;
+
+    // first and last element which begins inside the range
+    const u64 first = (range_start - start + element_size - 1) / element_size;
+    const u64 last = (range_end - start + element_size - 1) / element_size;
+    if (first >= last)
+      return;
+
+    const u32 count = static_cast<u32>(last - first);
+    m_scan_ranges.push_back(
+      ScanRange{static_cast<PhysicalMemoryAddress>(start + first * element_size), count, num_blocks});
+    num_blocks += (count + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE;
+  };
+
+  static constexpr u64 SEGMENT_SIZE = u64(CPU::PHYSICAL_MEMORY_ADDRESS_MASK) + 1;
+  for (u64 segment = (start & ~(SEGMENT_SIZE - 1)); segment < end; segment += SEGMENT_SIZE)
+  {
+    add_range(segment, segment + Bus::RAM_MIRROR_END);
+    if ((static_cast<u32>(segment + CPU::SCRATCHPAD_ADDR) & CPU::SCRATCHPAD_ADDR_MASK) == CPU::SCRATCHPAD_ADDR)
+      add_range(segment + CPU::SCRATCHPAD_ADDR, segment + CPU::SCRATCHPAD_ADDR + CPU::SCRATCHPAD_SIZE);
+    add_range(segment + Bus::BIOS_BASE, segment + Bus::BIOS_BASE + Bus::BIOS_SIZE);
   }
+
+  m_snapshot.resize(static_cast<size_t>(num_blocks) * SCAN_BLOCK_SIZE * element_size);
+  m_candidates.assign(num_blocks, 0);
+  DispatchSearch(false);
 }
 
 void MemoryScan::SearchAgain()
 {
-  ResultVector new_results;
-  new_results.reserve(m_results.size());
-  for (Result& res : m_results)
+  DispatchSearch(true);
+}
+
+void MemoryScan::DispatchSearch(bool search_again)
+{
+  switch (m_scan_size)
   {
-    res.UpdateValue(m_size, m_signed);
+    case MemoryAccessSize::Byte:
+      m_signed ? DoSearch<s8>(search_again) : DoSearch<u8>(search_again);
+      break;
 
-    if (res.Filter(m_operator, m_value, m_signed))
+    case MemoryAccessSize::HalfWord:
+      m_signed ? DoSearch<s16>(search_again) : DoSearch<u16>(search_again);
+      break;
+
+    case MemoryAccessSize::Word:
+      m_signed ? DoSearch<s32>(search_again) : DoSearch<u32>(search_again);
+      break;
+
+    default:
+      break;
+  }
+
+  MaterializeResults();
+}
+
+template<typename T>
+void MemoryScan::DoSearch(bool search_again)
+{
+  const ScanPredicate<T> pred = GetScanPredicate<T>(m_operator, m_value);
+  std::array<u8, SCAN_BLOCK_SIZE * sizeof(T)> current;
+
+  m_result_count = 0;
+  for (const ScanRange& range : m_scan_ranges)
+  {
+    for (u32 first = 0; first < range.count; first += SCAN_BLOCK_SIZE)
     {
-      res.last_value = res.value;
-      new_results.push_back(res);
+      // Blocks without any candidates left don't need to be read again.
+      const u32 block = range.first_block + first / SCAN_BLOCK_SIZE;
+      u64& candidates = m_candidates[block];
+      if (search_again && candidates == 0)
+        continue;
+
+      const u32 count = std::min(range.count - first, SCAN_BLOCK_SIZE);
+      const PhysicalMemoryAddress address = range.address + first * sizeof(T);
+      u8* snapshot = &m_snapshot[static_cast<size_t>(block) * SCAN_BLOCK_SIZE * sizeof(T)];
+
+      if (!search_again)
+      {
+        candidates = ReadScanBlock(address, snapshot, count, sizeof(T));
+        if (candidates != 0)
+          candidates &= EvaluateScanBlock<T>(pred, snapshot, snapshot, count, m_signed);
+      }
+      else
+      {
+        ReadScanBlock(address, current.data(), count, sizeof(T));
+        candidates &= EvaluateScanBlock<T>(pred, current.data(), snapshot, count, m_signed);
+        std::memcpy(snapshot, current.data(), count * sizeof(T));
+      }
+
+      m_result_count += static_cast<u32>(std::popcount(candidates));
     }
   }
+}
+
+void MemoryScan::MaterializeResults()
+{
+  m_results.clear();
+
+  const u32 element_size = 1u << static_cast<u32>(m_scan_size);
+  for (const ScanRange& range : m_scan_ranges)
+  {
+    for (u32 first = 0; first < range.count; first += SCAN_BLOCK_SIZE)
+    {
+      const u32 block = range.first_block + first / SCAN_BLOCK_SIZE;
+      u64 bits = m_candidates[block];
+      while (bits != 0)
+      {
+        if (m_results.size() == MAX_MATERIALIZED_RESULTS)
+          return;
+
+        const u32 index = CountTrailingZeros(bits);
+        bits &= bits - 1;
 
-  m_results.swap(new_results);
+        const u8* ptr = &m_snapshot[(static_cast<size_t>(block) * SCAN_BLOCK_SIZE + index) * element_size];
+        Result res;
+        res.address = range.address + (first + index) * element_size;
+        if (m_scan_size == MemoryAccessSize::Byte)
+        {
+          res.value = m_signed ? SignExtend32(ptr[0]) : ZeroExtend32(ptr[0]);
+        }
+        else if (m_scan_size == MemoryAccessSize::HalfWord)
+        {
+          u16 value;
+          std::memcpy(&value, ptr, sizeof(value));
+          res.value = m_signed ? SignExtend32(value) : ZeroExtend32(value);
+        }
+        else
+        {
+          std::memcpy(&res.value, ptr, sizeof(res.value));
+        }
+
+        res.last_value = res.value;
+        res.value_changed = false;
+        m_results.push_back(res);
+      }
+    }
+  }
 }
 
 void MemoryScan::UpdateResultsValues()
@@ -151,7 +151,6 @@ public:
   ~CheatList();
 
   ALWAYS_INLINE const CheatCode& GetCode(u32 i) const { return m_codes[i]; }
-  ALWAYS_INLINE CheatCode& GetCode(u32 i) { return m_codes[i]; }
   ALWAYS_INLINE u32 GetCodeCount() const { return static_cast<u32>(m_codes.size()); }
   ALWAYS_INLINE bool IsCodeEnabled(u32 index) const { return m_codes[index].enabled; }
 
@@ -195,8 +194,81 @@ public:
   void MergeList(const CheatList& cl);
 
 private:
+  enum class CompiledOpType : u8
+  {
+    Nop,
+    Interpret,
+    Write8,
+    Write16,
+    Write32,
+    Or8,
+    Or16,
+    Or32,
+    And8,
+    And16,
+    And32,
+    Add8,
+    Add16,
+    Add32,
+    WriteIfMatch16,
+
+    // Conditions continue with the next op when true, and jump to target when false.
+    Equal8,
+    Equal16,
+    Equal32,
+    NotEqual8,
+    NotEqual16,
+    NotEqual32,
+    Less8,
+    Less16,
+    Less32,
+    Greater8,
+    Greater16,
+    Greater32,
+    ButtonsEqual,
+    ButtonsNotEqual,
+    DelayActivation,
+
+    // Two-instruction ops, continue at target.
+    Slide8,
+    Slide16,
+    Slide32,
+    MemoryCopy,
+  };
+
+  enum class CompiledRegion : u8
+  {
+    RAM,
+    Scratchpad,
+    Bus,
+  };
+
+  /// Pre-decoded instruction. Each code compiles to one op per instruction, so jump targets map directly.
+  struct CompiledOp
+  {
+    CompiledOpType type;
+    CompiledRegion region;
+    u32 address;
+    u32 value;
+    u32 param;
+    u32 address_step;
+    u32 value_step;
+    u32 target;
+  };
+
+  template<typename T>
+  static T DoCompiledRead(CompiledRegion region, u32 address);
+  template<typename T>
+  static void DoCompiledWrite(CompiledRegion region, u32 address, T value);
+
+  static bool CanCompileCode(const CheatCode& cc);
+  void CompileCode(const CheatCode& cc, u32 code_index);
+  void CompileCodes();
+
   std::vector<CheatCode> m_codes;
+  std::vector<CompiledOp> m_compiled_ops;
   bool m_master_enable = true;
+  bool m_compiled_ops_dirty = true;
 };
 
 class MemoryScan
@@ -235,6 +307,9 @@ public:
 
   using ResultVector = std::vector<Result>;
 
+  /// Only the first results are materialized for display, the full candidate set is kept as a bitmap.
+  static constexpr u32 MAX_MATERIALIZED_RESULTS = 5000;
+
   MemoryScan();
   ~MemoryScan();
 
@@ -246,7 +321,7 @@ public:
   PhysicalMemoryAddress GetEndAddress() const { return m_end_address; }
   const ResultVector& GetResults() const { return m_results; }
   const Result& GetResult(u32 index) const { return m_results[index]; }
-  u32 GetResultCount() const { return static_cast<u32>(m_results.size()); }
+  u32 GetResultCount() const { return m_result_count; }
 
   void SetValue(u32 value) { m_value = value; }
   void SetValueSigned(bool s) { m_signed = s; }
@@ -263,15 +338,32 @@ public:
   void SetResultValue(u32 index, u32 value);
 
 private:
-  void SearchBytes();
-  void SearchHalfwords();
-  void SearchWords();
+  template<typename T>
+  void DoSearch(bool search_again);
+  void DispatchSearch(bool search_again);
+  void MaterializeResults();
 
   u32 m_value = 0;
   MemoryAccessSize m_size = MemoryAccessSize::HalfWord;
   Operator m_operator = Operator::Equal;
   PhysicalMemoryAddress m_start_address = 0;
   PhysicalMemoryAddress m_end_address = 0x200000;
+
+  // Run of elements at valid addresses within the search range. Each starts on a new candidate block.
+  struct ScanRange
+  {
+    PhysicalMemoryAddress address;
+    u32 count;
+    u32 first_block;
+  };
+
+  // Values of every element in the ranges at the last search, and a bit per element which still matches.
+  std::vector<ScanRange> m_scan_ranges;
+  std::vector<u8> m_snapshot;
+  std::vector<u64> m_candidates;
+  MemoryAccessSize m_scan_size = MemoryAccessSize::HalfWord;
+  u32 m_result_count = 0;
+
   ResultVector m_results;
   bool m_signed = false;
 };
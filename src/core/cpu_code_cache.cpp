@@ -8,6 +8,7 @@
 #include "cpu_disasm.h"
 #include "cpu_recompiler_types.h"
 #include "host.h"
+#include "perf_sections.h"
 #include "settings.h"
 #include "system.h"
 #include "timing_event.h"
@@ -28,6 +29,8 @@ Log_SetChannel(CPU::CodeCache);
 #include "cpu_newrec_compiler.h"
 #endif
 
+#include <algorithm>
+#include <array>
 #include <map>
 #include <unordered_set>
 #include <zlib.h>
@@ -87,6 +90,7 @@ static std::unique_ptr<const void*[]> s_lut_code_pointers;
 static std::unique_ptr<Block*[]> s_lut_block_pointers;
 static PageProtectionArray s_page_protection = {};
 static std::vector<Block*> s_blocks;
+static CompileStats s_compile_stats = {};
 
 // for compiling - reuse to avoid allocations
 static BlockInstructionList s_block_instructions;
@@ -104,10 +108,32 @@ static Common::PageFaultHandler::HandlerResult HandleFastmemException(void* exce
 static void BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info);
 static void RemoveBackpatchInfoForRange(const void* host_code, u32 size);
 
+static void SetupCodeRegions();
+static void TouchCodeRegion(const void* host_code);
+static bool EvictCodeRegion();
+static void EvictBlock(Block* block);
+
 static BlockLinkMap s_block_links;
 static std::map<const void*, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
+// The code buffer is split into regions which are filled in turn. When the buffer is full, the region which was least
+// recently entered is recycled, instead of throwing away every block.
+static constexpr u32 CODE_REGION_COUNT = 8;
+static std::array<u32, CODE_REGION_COUNT> s_code_region_last_used_frame = {};
+static u32 s_code_regions_allocated = 0;
+static CodeBufferStats s_code_buffer_stats = {};
+
+// Backpatch thunks are emitted from the fault handler, long after the block which faulted was compiled, so they can't
+// go in the current region: it may be a different region to the block's, and get evicted while the block still jumps
+// into it. Instead they live in a small area of far code before the regions, which is never evicted. NewRec blocks are
+// always recompiled after backpatching, so a thunk is only reachable until its block returns to the dispatcher, and
+// the area can be reused from the start when it fills up.
+static constexpr u32 BACKPATCH_THUNK_AREA_SIZE = 64 * 1024;
+static constexpr u32 MAX_BACKPATCH_THUNK_SIZE = 1024;
+static u8* s_backpatch_thunk_area = nullptr;
+static u32 s_backpatch_thunk_area_used = 0;
+
 NORETURN_FUNCTION_POINTER void (*g_enter_recompiler)();
 const void* g_compile_or_revalidate_block;
 const void* g_check_events_and_dispatch;
@@ -206,12 +232,14 @@ void CPU::CodeCache::ProcessShutdown()
 void CPU::CodeCache::Initialize()
 {
   Assert(s_blocks.empty());
+  s_compile_stats = {};
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
   if (IsUsingAnyRecompiler())
   {
     s_code_buffer.Reset();
     CompileASMFunctions();
+    SetupCodeRegions();
     ResetCodeLUT();
   }
 #endif
@@ -239,9 +267,11 @@ void CPU::CodeCache::Reset()
 #ifdef ENABLE_RECOMPILER_SUPPORT
   if (IsUsingAnyRecompiler())
   {
+    s_code_buffer_stats.full_flushes++;
     ClearASMFunctions();
     s_code_buffer.Reset();
     CompileASMFunctions();
+    SetupCodeRegions();
     ResetCodeLUT();
   }
 #endif
@@ -628,6 +658,7 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
 
   BlockState new_block_state = BlockState::Invalidated;
   PageProtectionInfo& ppi = s_page_protection[index];
+  s_compile_stats.page_invalidations++;
 
   const u32 frame_number = System::GetFrameNumber();
   const u32 frame_delta = frame_number - ppi.invalidate_frame;
@@ -664,6 +695,11 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
   MemMap::EndCodeWrite();
 }
 
+const CPU::CodeCache::CompileStats& CPU::CodeCache::GetCompileStats()
+{
+  return s_compile_stats;
+}
+
 CPU::CodeCache::PageProtectionMode CPU::CodeCache::GetProtectionModeForPC(u32 pc)
 {
   if (!AddressInRAM(pc))
@@ -1315,7 +1351,6 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
 
 void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
 {
-  // TODO: this doesn't currently handle when the cache overflows...
   DebugAssert(IsUsingAnyRecompiler());
   MemMap::BeginCodeWrite();
 
@@ -1327,6 +1362,7 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
     if (RevalidateBlock(block))
     {
       DebugAssert(block->host_code);
+      TouchCodeRegion(block->host_code);
       SetCodeLUT(start_pc, block->host_code);
       BacklinkBlocks(start_pc, block->host_code);
       MemMap::EndCodeWrite();
@@ -1354,8 +1390,11 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
   // Ensure we're not going to run out of space while compiling this block.
   // We could definitely do better here... TODO: far code is no longer needed for newrec
   const u32 block_size = static_cast<u32>(s_block_instructions.size());
-  if (s_code_buffer.GetFreeCodeSpace() < (block_size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) ||
-      s_code_buffer.GetFreeFarCodeSpace() < (block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION))
+  const auto has_space_for_block = [block_size]() {
+    return (s_code_buffer.GetFreeCodeSpace() >= (block_size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) &&
+            s_code_buffer.GetFreeFarCodeSpace() >= (block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION));
+  };
+  if (!has_space_for_block() && (!EvictCodeRegion() || !has_space_for_block()))
   {
     Log_ErrorFmt("Out of code space while compiling {:08X}. Resetting code cache.", start_pc);
     CodeCache::Reset();
@@ -1400,6 +1439,9 @@ const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
     const Block* next_block = LookupBlock(newpc);
     if (next_block)
     {
+      if (next_block->state == BlockState::Valid)
+        TouchCodeRegion(next_block->host_code);
+
       dst = (next_block->state == BlockState::Valid) ?
               next_block->host_code :
               ((next_block->state == BlockState::FallbackToInterpreter) ? g_interpret_block :
@@ -1443,11 +1485,130 @@ void CPU::CodeCache::UnlinkBlockExits(Block* block)
   block->num_exit_links = 0;
 }
 
+const CPU::CodeCache::CodeBufferStats& CPU::CodeCache::GetCodeBufferStats()
+{
+  return s_code_buffer_stats;
+}
+
+void CPU::CodeCache::SetupCodeRegions()
+{
+  // dispatchers and backpatch thunks live before the first region, so they're never evicted
+  Assert(s_code_buffer.GetFreeFarCodeSpace() >= BACKPATCH_THUNK_AREA_SIZE);
+  s_backpatch_thunk_area = s_code_buffer.GetFreeFarCodePointer();
+  s_backpatch_thunk_area_used = 0;
+  s_code_buffer.CommitFarCode(BACKPATCH_THUNK_AREA_SIZE);
+
+  s_code_buffer.SetupRegions(CODE_REGION_COUNT);
+  s_code_region_last_used_frame.fill(System::GetFrameNumber());
+  s_code_regions_allocated = 1;
+}
+
+void CPU::CodeCache::TouchCodeRegion(const void* host_code)
+{
+  const u32 region = s_code_buffer.GetRegionForPointer(host_code);
+  if (region < CODE_REGION_COUNT)
+    s_code_region_last_used_frame[region] = System::GetFrameNumber();
+}
+
+bool CPU::CodeCache::EvictCodeRegion()
+{
+  if (s_code_buffer.GetRegionCount() != CODE_REGION_COUNT)
+    return false;
+
+  // fill untouched regions first
+  if (s_code_regions_allocated < CODE_REGION_COUNT)
+  {
+    const u32 region = s_code_regions_allocated++;
+    Log_DevFmt("Code region {} full, moving to region {}", s_code_buffer.GetCurrentRegion(), region);
+    s_code_buffer.SwitchToRegion(region);
+    s_code_region_last_used_frame[region] = System::GetFrameNumber();
+    return true;
+  }
+
+  const u32 current_region = s_code_buffer.GetCurrentRegion();
+  u32 victim = CODE_REGION_COUNT;
+  for (u32 i = 0; i < CODE_REGION_COUNT; i++)
+  {
+    if (i != current_region &&
+        (victim == CODE_REGION_COUNT || s_code_region_last_used_frame[i] < s_code_region_last_used_frame[victim]))
+    {
+      victim = i;
+    }
+  }
+
+  // Compilation is always entered through a tail call from the dispatcher or a block link, so there's no way any code
+  // in the victim region is on the stack at this point. Anything linking into it is redirected to the compiler.
+  u32 blocks_evicted = 0;
+  for (Block* block : s_blocks)
+  {
+    if (block->host_code && s_code_buffer.GetRegionForPointer(block->host_code) == victim)
+    {
+      EvictBlock(block);
+      blocks_evicted++;
+    }
+  }
+
+  Log_DevFmt("Evicting code region {} (last used frame {}, {} blocks)", victim, s_code_region_last_used_frame[victim],
+             blocks_evicted);
+
+  s_code_buffer.SwitchToRegion(victim);
+  s_code_region_last_used_frame[victim] = System::GetFrameNumber();
+  s_code_buffer_stats.regions_evicted++;
+  s_code_buffer_stats.blocks_evicted += blocks_evicted;
+  return true;
+}
+
+void CPU::CodeCache::EvictBlock(Block* block)
+{
+  if (block->state == BlockState::Valid)
+  {
+    RemoveBlockFromPageList(block);
+    InvalidateBlock(block, BlockState::NeedsRecompile);
+  }
+  else if (block->state == BlockState::Invalidated)
+  {
+    // can't be revalidated without code
+    block->state = BlockState::NeedsRecompile;
+  }
+
+  UnlinkBlockExits(block);
+  if (block->HasFlag(BlockFlags::ContainsLoadStoreInstructions))
+    RemoveBackpatchInfoForRange(block->host_code, block->host_code_size);
+
+  block->host_code = nullptr;
+  block->host_code_size = 0;
+
+  // not the block's fault it got recompiled, don't count it towards interpreter fallback
+  block->compile_frame = System::GetFrameNumber();
+  block->compile_count = 0;
+}
+
 JitCodeBuffer& CPU::CodeCache::GetCodeBuffer()
 {
   return s_code_buffer;
 }
 
+u8* CPU::CodeCache::GetBackpatchThunkPointer(u32* space)
+{
+  DebugAssert(s_backpatch_thunk_area);
+  if ((BACKPATCH_THUNK_AREA_SIZE - s_backpatch_thunk_area_used) < MAX_BACKPATCH_THUNK_SIZE)
+  {
+    // Nothing is executing in here while we're handling a fault, see above.
+    Log_DevPrint("Backpatch thunk area full, wrapping around");
+    s_backpatch_thunk_area_used = 0;
+  }
+
+  *space = BACKPATCH_THUNK_AREA_SIZE - s_backpatch_thunk_area_used;
+  return s_backpatch_thunk_area + s_backpatch_thunk_area_used;
+}
+
+void CPU::CodeCache::CommitBackpatchThunk(u32 size)
+{
+  DebugAssert(size <= MAX_BACKPATCH_THUNK_SIZE);
+  JitCodeBuffer::FlushInstructionCache(s_backpatch_thunk_area + s_backpatch_thunk_area_used, size);
+  s_backpatch_thunk_area_used += size;
+}
+
 const void* CPU::CodeCache::GetInterpretUncachedBlockFunction()
 {
   if (g_settings.gpu_pgxp_enable)
@@ -1496,6 +1657,8 @@ void CPU::CodeCache::CompileASMFunctions()
 
 bool CPU::CodeCache::CompileBlock(Block* block)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::JITCompile);
+
   const void* host_code = nullptr;
   u32 host_code_size = 0;
   u32 host_far_code_size = 0;
@@ -1522,6 +1685,12 @@ bool CPU::CodeCache::CompileBlock(Block* block)
     return false;
   }
 
+  TouchCodeRegion(host_code);
+
+  s_compile_stats.blocks_compiled++;
+  s_compile_stats.guest_instructions += block->size;
+  s_compile_stats.host_code_bytes += host_code_size + host_far_code_size;
+
 #ifdef _DEBUG
   const u32 host_instructions = GetHostInstructionCount(host_code, host_code_size);
   s_total_instructions_compiled += block->size;
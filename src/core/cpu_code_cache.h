@@ -38,4 +38,23 @@ void InvalidateBlocksWithPageIndex(u32 page_index);
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
+/// Code buffer reclamation statistics, since the system was started.
+struct CodeBufferStats
+{
+  u32 regions_evicted; ///< Least recently used regions which were recycled when the buffer filled up.
+  u32 blocks_evicted;  ///< Blocks discarded by region eviction, which will be recompiled on next execution.
+  u32 full_flushes;    ///< Times the entire code cache was reset.
+};
+const CodeBufferStats& GetCodeBufferStats();
+
+/// Block compilation statistics, since the system was started.
+struct CompileStats
+{
+  u32 blocks_compiled;    ///< Blocks passed to the recompiler, including recompiles after invalidation.
+  u32 guest_instructions; ///< MIPS instructions in compiled blocks.
+  u64 host_code_bytes;    ///< Near and far host code emitted.
+  u32 page_invalidations; ///< RAM code pages invalidated by writes.
+};
+const CompileStats& GetCompileStats();
+
 } // namespace CPU::CodeCache
@@ -243,6 +243,10 @@ void LogCurrentState();
 #endif
 
 JitCodeBuffer& GetCodeBuffer();
+
+/// Returns space for a fastmem backpatch thunk, outside of the evictable code regions.
+u8* GetBackpatchThunkPointer(u32* space);
+void CommitBackpatchThunk(u32 size);
 const void* GetInterpretUncachedBlockFunction();
 
 void CompileOrRevalidateBlock(u32 start_pc);
@@ -2339,10 +2339,12 @@ void CPU::NewRec::BackpatchLoadStore(void* exception_pc, const CodeCache::Loadst
     static_cast<TickCount>(static_cast<u32>(info.cycles)) - (info.is_load ? Bus::RAM_READ_TICKS : 0);
   const TickCount cycles_to_remove = static_cast<TickCount>(static_cast<u32>(info.cycles));
 
+  // thunks don't go in the current far code region, as it might not be the block's, and could get evicted
   JitCodeBuffer& buffer = CodeCache::GetCodeBuffer();
-  void* thunk_address = buffer.GetFreeFarCodePointer();
+  u32 thunk_space;
+  void* thunk_address = CodeCache::GetBackpatchThunkPointer(&thunk_space);
   const u32 thunk_size =
-    CompileLoadStoreThunk(thunk_address, buffer.GetFreeFarCodeSpace(), exception_pc, info.code_size, buffer.GetRWDiff(), cycles_to_add,
+    CompileLoadStoreThunk(thunk_address, thunk_space, exception_pc, info.code_size, buffer.GetRWDiff(), cycles_to_add,
                           cycles_to_remove, info.gpr_bitmask, info.address_register, info.data_register,
                           info.AccessSize(), info.is_signed, info.is_load);
 
@@ -2354,7 +2356,7 @@ void CPU::NewRec::BackpatchLoadStore(void* exception_pc, const CodeCache::Loadst
   // backpatch to a jump to the slowmem handler
   CodeCache::EmitJump(exception_pc, thunk_address, buffer.GetRWDiff(), true);
 
-  buffer.CommitFarCode(thunk_size);
+  CodeCache::CommitBackpatchThunk(thunk_size);
 }
 
 void CPU::NewRec::Compiler::InitSpeculativeRegs()
@@ -2132,13 +2132,294 @@ void CPU::NewRec::AArch64Compiler::Compile_cop2(CompileFlags cf)
   TickCount func_ticks;
   GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
 
+  // See X64Compiler::Compile_cop2(), these only use scratch registers.
+  const GTE::Instruction gte_inst{inst->bits};
+  const bool inline_nclip = (gte_inst.command == 0x06 && !(g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling));
+  if (inline_nclip || gte_inst.command == 0x2D || gte_inst.command == 0x2E)
+  {
+    if (inline_nclip)
+      Compile_cop2_NCLIP();
+    else
+      Compile_cop2_AVSZ(gte_inst.command == 0x2E);
+
+    AddGTETicks(func_ticks);
+    return;
+  }
+
   Flush(FLUSH_FOR_C_CALL);
+
+  // PGXP and the widescreen hack change the projection, so those keep calling into the GTE.
+  if ((gte_inst.command == 0x01 || gte_inst.command == 0x30) && !g_settings.gpu_pgxp_enable &&
+      !g_settings.gpu_widescreen_hack)
+  {
+    Compile_cop2_RTP(gte_inst.command == 0x30, gte_inst.GetShift(), gte_inst.lm);
+    AddGTETicks(func_ticks);
+    return;
+  }
+
   EmitMov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
   EmitCall(reinterpret_cast<const void*>(func));
 
   AddGTETicks(func_ticks);
 }
 
+void CPU::NewRec::AArch64Compiler::Compile_cop2_NCLIP()
+{
+  // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1), same as the six-product form in the interpreter.
+  // ::s16, since s16 is also a vixl register.
+  const ::s16* sxy[3] = {g_state.gte_regs.SXY0, g_state.gte_regs.SXY1, g_state.gte_regs.SXY2};
+  for (u32 i = 0; i < 3; i++)
+  {
+    armAsm->ldrsh(RWARG1, PTR(&sxy[(i + 1) % 3][1]));
+    armAsm->ldrsh(RWARG2, PTR(&sxy[(i + 2) % 3][1]));
+    armAsm->sub(RWARG1, RWARG1, RWARG2);
+    armAsm->ldrsh(RWARG2, PTR(&sxy[i][0]));
+    if (i == 0)
+      armAsm->smull(RXSCRATCH, RWARG2, RWARG1);
+    else
+      armAsm->smaddl(RXSCRATCH, RWARG2, RWARG1, RXSCRATCH);
+  }
+
+  Compile_cop2_SetMAC0AndFlags(false);
+}
+
+void CPU::NewRec::AArch64Compiler::Compile_cop2_AVSZ(bool avsz4)
+{
+  // MAC0 = ZSF3 * (SZ1 + SZ2 + SZ3) or ZSF4 * (SZ0 + SZ1 + SZ2 + SZ3), OTZ = MAC0 >> 12
+  armAsm->ldrh(RWARG1, PTR(&g_state.gte_regs.SZ1));
+  armAsm->ldrh(RWARG2, PTR(&g_state.gte_regs.SZ2));
+  armAsm->add(RWARG1, RWARG1, RWARG2);
+  armAsm->ldrh(RWARG2, PTR(&g_state.gte_regs.SZ3));
+  armAsm->add(RWARG1, RWARG1, RWARG2);
+  if (avsz4)
+  {
+    armAsm->ldrh(RWARG2, PTR(&g_state.gte_regs.SZ0));
+    armAsm->add(RWARG1, RWARG1, RWARG2);
+  }
+  armAsm->ldrsh(RWARG2, PTR(avsz4 ? &g_state.gte_regs.ZSF4 : &g_state.gte_regs.ZSF3));
+  armAsm->smull(RXSCRATCH, RWARG1, RWARG2);
+
+  Compile_cop2_SetMAC0AndFlags(true);
+}
+
+void CPU::NewRec::AArch64Compiler::Compile_cop2_SetMAC0AndFlags(bool set_otz)
+{
+  // RXSCRATCH holds the 64-bit MAC0 result. FLAG is rebuilt from scratch, so it never needs to be read.
+  armAsm->str(RWSCRATCH, PTR(&g_state.gte_regs.MAC0));
+
+  armEmitMov(armAsm, RXARG2, static_cast<u64>(INT64_C(0x7FFFFFFF)));
+  armAsm->cmp(RXSCRATCH, RXARG2);
+  armAsm->cset(RWARG1, gt);
+  armAsm->lsl(RWARG1, RWARG1, 16); // mac0_overflow
+  armEmitMov(armAsm, RXARG2, static_cast<u64>(INT64_C(-0x80000000)));
+  armAsm->cmp(RXSCRATCH, RXARG2);
+  armAsm->cset(RWARG2, lt);
+  armAsm->orr(RWARG1, RWARG1, Operand(RWARG2, LSL, 15)); // mac0_underflow
+
+  if (set_otz)
+  {
+    armAsm->asr(RXSCRATCH, RXSCRATCH, 12);
+    armEmitMov(armAsm, RXARG2, 0xFFFF);
+    armAsm->cmp(RXSCRATCH, RXARG2);
+    armAsm->cset(RWARG3, hi);
+    armAsm->orr(RWARG1, RWARG1, Operand(RWARG3, LSL, 18)); // sz1_otz_saturated
+
+    armAsm->cmp(RXSCRATCH, 0);
+    armAsm->csel(RXSCRATCH, xzr, RXSCRATCH, lt);
+    armAsm->cmp(RXSCRATCH, RXARG2);
+    armAsm->csel(RXSCRATCH, RXARG2, RXSCRATCH, gt);
+    armAsm->str(RWSCRATCH, PTR(&g_state.gte_regs.dr32[7]));
+  }
+
+  // error bit
+  armAsm->cmp(RWARG1, 0);
+  armAsm->cset(RWARG2, ne);
+  armAsm->orr(RWARG1, RWARG1, Operand(RWARG2, LSL, 31));
+  armAsm->str(RWARG1, PTR(&g_state.gte_regs.FLAG.bits));
+}
+
+void CPU::NewRec::AArch64Compiler::Compile_cop2_RTP(bool rtpt, u8 shift, bool lm)
+{
+  // Caller-saved registers have been flushed, so w0-w17 are all free to use here.
+  const WRegister flag = w3;
+  const XRegister mac123_max = x4;
+  const XRegister mac123_min = x5;
+  const XRegister mac0_max = x6;
+  const XRegister mac0_min = x7;
+  const WRegister ir_max = w8;
+  const WRegister ir_min = w9;
+  const WRegister sz_max = w10;
+  const XRegister acc = x11;
+  const XRegister unr = x12;
+
+  const auto set_flag_if = [this, &flag](Condition cond, u32 bit) {
+    armAsm->cset(w17, cond);
+    armAsm->orr(flag, flag, Operand(w17, LSL, bit));
+  };
+  const auto check_range = [this, &set_flag_if](const Register& value, const Register& max, const Register& min,
+                                               u32 overflow_bit, u32 underflow_bit) {
+    armAsm->cmp(value, max);
+    set_flag_if(gt, overflow_bit);
+    armAsm->cmp(value, min);
+    set_flag_if(lt, underflow_bit);
+  };
+  const auto saturate = [this, &set_flag_if](const WRegister& value, const WRegister& max, const WRegister& min,
+                                             u32 bit) {
+    armAsm->cmp(value, max);
+    set_flag_if(gt, bit);
+    armAsm->csel(value, max, value, gt);
+    armAsm->cmp(value, min);
+    set_flag_if(lt, bit);
+    armAsm->csel(value, min, value, lt);
+  };
+
+  // FLAG is rebuilt from scratch, so it never needs to be read.
+  armAsm->mov(flag, wzr);
+  armEmitMov(armAsm, mac123_max, static_cast<u64>(INT64_C(0x7FFFFFFFFFF)));
+  armEmitMov(armAsm, mac123_min, static_cast<u64>(INT64_C(-0x80000000000)));
+  armEmitMov(armAsm, mac0_max, static_cast<u64>(INT64_C(0x7FFFFFFF)));
+  armEmitMov(armAsm, mac0_min, static_cast<u64>(INT64_C(-0x80000000)));
+  armEmitMov(armAsm, ir_max, 0x7FFF);
+  armEmitMov(armAsm, ir_min, lm ? 0 : static_cast<u32>(-0x8000));
+  armEmitMov(armAsm, sz_max, 0xFFFF);
+
+  const ::s16* vertices[3] = {g_state.gte_regs.V0, g_state.gte_regs.V1, g_state.gte_regs.V2};
+  const u32 num_vertices = rtpt ? 3 : 1;
+  for (u32 v = 0; v < num_vertices; v++)
+  {
+    const ::s16* V = vertices[v];
+
+    // MAC1-3 = (TR*1000h + RT*V) SAR (sf*12), each partial sum is checked and sign-extended to 44 bits.
+    for (u32 i = 0; i < 3; i++)
+    {
+      armAsm->ldrsw(acc, PTR(&g_state.gte_regs.TR[i]));
+      armAsm->lsl(acc, acc, 12);
+      for (u32 j = 0; j < 3; j++)
+      {
+        armAsm->ldrsh(w0, PTR(&g_state.gte_regs.RT[i][j]));
+        armAsm->ldrsh(w1, PTR(&V[j]));
+        armAsm->smaddl(acc, w0, w1, acc);
+        check_range(acc, mac123_max, mac123_min, 30 - i, 27 - i); // macN_overflow, macN_underflow
+        if (j < 2)
+          armAsm->sbfx(acc, acc, 0, 44);
+      }
+
+      if (shift != 0)
+        armAsm->asr(x0, acc, shift);
+      else
+        armAsm->mov(x0, acc);
+      armAsm->str(w0, PTR(&g_state.gte_regs.dr32[25 + i]));
+
+      if (i < 2)
+      {
+        saturate(w0, ir_max, ir_min, 24 - i); // irN_saturated
+        armAsm->str(w0, PTR(&g_state.gte_regs.dr32[9 + i]));
+        continue;
+      }
+
+      // IR3 is saturated from MAC3, but the flag comes from MAC3 SAR 12, without lm. See GTE::RTPS().
+      armAsm->asr(x1, acc, 12);
+      armAsm->cmp(w1, ir_max);
+      set_flag_if(gt, 22); // ir3_saturated
+      armAsm->cmn(w1, 0x8000);
+      set_flag_if(lt, 22);
+      armAsm->cmp(w0, ir_max);
+      armAsm->csel(w0, ir_max, w0, gt);
+      armAsm->cmp(w0, ir_min);
+      armAsm->csel(w0, ir_min, w0, lt);
+      armAsm->str(w0, PTR(&g_state.gte_regs.dr32[11]));
+
+      // SZ3 = MAC3 SAR ((1-sf)*12), pushed into the Z FIFO.
+      saturate(w1, sz_max, wzr, 18); // sz1_otz_saturated
+      for (u32 k = 16; k < 19; k++)
+      {
+        armAsm->ldr(w2, PTR(&g_state.gte_regs.dr32[k + 1]));
+        armAsm->str(w2, PTR(&g_state.gte_regs.dr32[k]));
+      }
+      armAsm->str(w1, PTR(&g_state.gte_regs.dr32[19]));
+    }
+
+    // unr = UNRDivide(H, SZ3), w1 still holds SZ3.
+    Label divide_overflow, divide_done;
+    armEmitMov(armAsm, w15, 0x1FFFF);
+    armAsm->ldrh(w13, PTR(&g_state.gte_regs.H));
+    armAsm->lsl(w2, w1, 1);
+    armAsm->cmp(w2, w13);
+    armAsm->b(&divide_overflow, ls);
+
+    armAsm->clz(w2, w1);
+    armAsm->sub(w2, w2, 16);
+    armAsm->lslv(w13, w13, w2);
+    armAsm->lslv(w1, w1, w2);
+    armAsm->orr(w1, w1, 0x8000);
+    armAsm->and_(w2, w1, 0x7FFF);
+    armAsm->add(w2, w2, 0x40);
+    armAsm->lsr(w2, w2, 7);
+    armMoveAddressToReg(armAsm, x16, GTE::GetUNRTable());
+    armAsm->ldrb(w2, MemOperand(x16, x2));
+    armAsm->add(w2, w2, 0x101);
+    armAsm->neg(w14, w2);
+    armAsm->mul(w14, w1, w14);
+    armAsm->add(w14, w14, 0x80);
+    armAsm->asr(w14, w14, 8);
+    armAsm->add(w14, w14, 0x20000);
+    armAsm->mul(w14, w2, w14);
+    armAsm->add(w14, w14, 0x80);
+    armAsm->asr(w14, w14, 8);
+    armAsm->umull(unr, w13, w14);
+    armAsm->add(unr, unr, 0x8000);
+    armAsm->lsr(unr, unr, 16);
+    armAsm->cmp(unr.W(), w15);
+    armAsm->csel(unr.W(), w15, unr.W(), hi);
+    armAsm->b(&divide_done);
+
+    armAsm->bind(&divide_overflow);
+    armAsm->orr(flag, flag, 1u << 17); // divide_overflow
+    armAsm->mov(unr.W(), w15);
+    armAsm->bind(&divide_done);
+
+    // SX2 = (unr * IR1 + OFX) SAR 16, SY2 = (unr * IR2 + OFY) SAR 16, pushed into the XY FIFO.
+    armEmitMov(armAsm, w14, 0x3FF);
+    armEmitMov(armAsm, w15, static_cast<u32>(-0x400));
+    armAsm->ldrsw(x0, PTR(&g_state.gte_regs.OFX));
+    armAsm->ldr(w2, PTR(&g_state.gte_regs.dr32[9]));
+    armAsm->smaddl(x0, unr.W(), w2, x0);
+    check_range(x0, mac0_max, mac0_min, 16, 15); // mac0_overflow, mac0_underflow
+    armAsm->asr(x0, x0, 16);
+    saturate(w0, w14, w15, 14); // sx2_saturated
+    armAsm->ldrsw(x1, PTR(&g_state.gte_regs.OFY));
+    armAsm->ldr(w2, PTR(&g_state.gte_regs.dr32[10]));
+    armAsm->smaddl(x1, unr.W(), w2, x1);
+    check_range(x1, mac0_max, mac0_min, 16, 15);
+    armAsm->asr(x1, x1, 16);
+    saturate(w1, w14, w15, 13); // sy2_saturated
+    armAsm->ldr(w2, PTR(&g_state.gte_regs.dr32[13]));
+    armAsm->str(w2, PTR(&g_state.gte_regs.dr32[12]));
+    armAsm->ldr(w2, PTR(&g_state.gte_regs.dr32[14]));
+    armAsm->str(w2, PTR(&g_state.gte_regs.dr32[13]));
+    armAsm->and_(w0, w0, 0xFFFF);
+    armAsm->orr(w0, w0, Operand(w1, LSL, 16));
+    armAsm->str(w0, PTR(&g_state.gte_regs.dr32[14]));
+  }
+
+  // MAC0 = unr * DQA + DQB, IR0 = MAC0 SAR 12, for the last vertex only.
+  armAsm->ldrsh(w0, PTR(&g_state.gte_regs.DQA));
+  armAsm->ldrsw(x1, PTR(&g_state.gte_regs.DQB));
+  armAsm->smaddl(x0, unr.W(), w0, x1);
+  check_range(x0, mac0_max, mac0_min, 16, 15);
+  armAsm->str(w0, PTR(&g_state.gte_regs.MAC0));
+  armAsm->asr(x0, x0, 12);
+  armEmitMov(armAsm, w14, 0x1000);
+  saturate(w0, w14, wzr, 12); // ir0_saturated
+  armAsm->str(w0, PTR(&g_state.gte_regs.dr32[8]));
+
+  // error bit
+  armEmitMov(armAsm, w0, 0x7F87E000);
+  armAsm->tst(flag, w0);
+  set_flag_if(ne, 31);
+  armAsm->str(flag, PTR(&g_state.gte_regs.FLAG.bits));
+}
+
 u32 CPU::NewRec::CompileLoadStoreThunk(void* thunk_code, u32 thunk_space, void* code_address, u32 code_size,
                                        ptrdiff_t rw_diff, TickCount cycles_to_add, TickCount cycles_to_remove,
                                        u32 gpr_bitmask, u8 address_register, u8 data_register, MemoryAccessSize size,
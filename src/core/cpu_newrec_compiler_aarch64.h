@@ -123,6 +123,10 @@ protected:
   void Compile_mfc2(CompileFlags cf) override;
   void Compile_mtc2(CompileFlags cf) override;
   void Compile_cop2(CompileFlags cf) override;
+  void Compile_cop2_NCLIP();
+  void Compile_cop2_AVSZ(bool avsz4);
+  void Compile_cop2_SetMAC0AndFlags(bool set_otz);
+  void Compile_cop2_RTP(bool rtpt, u8 shift, bool lm);
 
   void GeneratePGXPCallWithMIPSRegs(const void* func, u32 arg1val, Reg arg2reg = Reg::count,
                                     Reg arg3reg = Reg::count) override;
@@ -2127,6 +2127,21 @@ void CPU::NewRec::X64Compiler::Compile_cop2(CompileFlags cf)
   TickCount func_ticks;
   GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
 
+  // The short depth/winding instructions are cheaper to emit inline than to call out to, and only touch scratch
+  // registers, so nothing needs to be flushed. PGXP culling needs the precise vertices, so leave that to the handler.
+  const GTE::Instruction gte_inst{inst->bits};
+  const bool inline_nclip = (gte_inst.command == 0x06 && !(g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling));
+  if (inline_nclip || gte_inst.command == 0x2D || gte_inst.command == 0x2E)
+  {
+    if (inline_nclip)
+      Compile_cop2_NCLIP();
+    else
+      Compile_cop2_AVSZ(gte_inst.command == 0x2E);
+
+    AddGTETicks(func_ticks);
+    return;
+  }
+
   Flush(FLUSH_FOR_C_CALL);
   cg->mov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
   cg->call(reinterpret_cast<const void*>(func));
@@ -2134,6 +2149,88 @@ void CPU::NewRec::X64Compiler::Compile_cop2(CompileFlags cf)
   AddGTETicks(func_ticks);
 }
 
+void CPU::NewRec::X64Compiler::Compile_cop2_NCLIP()
+{
+  // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1), same as the six-product form in the interpreter.
+  const s16* sxy[3] = {g_state.gte_regs.SXY0, g_state.gte_regs.SXY1, g_state.gte_regs.SXY2};
+  for (u32 i = 0; i < 3; i++)
+  {
+    cg->movsx(RXARG1, cg->word[PTR(&sxy[(i + 1) % 3][1])]);
+    cg->movsx(RXARG2, cg->word[PTR(&sxy[(i + 2) % 3][1])]);
+    cg->sub(RXARG1, RXARG2);
+    cg->movsx(RXARG2, cg->word[PTR(&sxy[i][0])]);
+    cg->imul(RXARG1, RXARG2);
+    if (i == 0)
+      cg->mov(RXRET, RXARG1);
+    else
+      cg->add(RXRET, RXARG1);
+  }
+
+  Compile_cop2_SetMAC0AndFlags(false);
+}
+
+void CPU::NewRec::X64Compiler::Compile_cop2_AVSZ(bool avsz4)
+{
+  // MAC0 = ZSF3 * (SZ1 + SZ2 + SZ3) or ZSF4 * (SZ0 + SZ1 + SZ2 + SZ3), OTZ = MAC0 >> 12
+  cg->movzx(RWRET, cg->word[PTR(&g_state.gte_regs.SZ1)]);
+  cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ2)]);
+  cg->add(RWRET, RWARG1);
+  cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ3)]);
+  cg->add(RWRET, RWARG1);
+  if (avsz4)
+  {
+    cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ0)]);
+    cg->add(RWRET, RWARG1);
+  }
+  cg->movsx(RXARG1, cg->word[PTR(avsz4 ? &g_state.gte_regs.ZSF4 : &g_state.gte_regs.ZSF3)]);
+  cg->imul(RXRET, RXARG1);
+
+  Compile_cop2_SetMAC0AndFlags(true);
+}
+
+void CPU::NewRec::X64Compiler::Compile_cop2_SetMAC0AndFlags(bool set_otz)
+{
+  // RXRET holds the 64-bit MAC0 result. FLAG is rebuilt from scratch, so it never needs to be read.
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.MAC0)], RWRET);
+
+  cg->xor_(RWARG1, RWARG1);
+  cg->cmp(RXRET, 0x7FFFFFFF);
+  cg->setg(RWARG1.cvt8());
+  cg->shl(RWARG1, 16); // mac0_overflow
+  cg->xor_(RWARG2, RWARG2);
+  cg->cmp(RXRET, -0x7FFFFFFF - 1);
+  cg->setl(RWARG2.cvt8());
+  cg->shl(RWARG2, 15); // mac0_underflow
+  cg->or_(RWARG1, RWARG2);
+
+  if (set_otz)
+  {
+    cg->mov(RXARG2, RXRET);
+    cg->sar(RXARG2, 12);
+    cg->xor_(RWARG3, RWARG3);
+    cg->cmp(RXARG2, 0xFFFF);
+    cg->seta(RWARG3.cvt8());
+    cg->shl(RWARG3, 18); // sz1_otz_saturated
+    cg->or_(RWARG1, RWARG3);
+
+    cg->xor_(RWRET, RWRET);
+    cg->test(RXARG2, RXARG2);
+    cg->cmovs(RXARG2, RXRET);
+    cg->mov(RWRET, 0xFFFF);
+    cg->cmp(RXARG2, RXRET);
+    cg->cmovg(RXARG2, RXRET);
+    cg->mov(cg->dword[PTR(&g_state.gte_regs.dr32[7])], RWARG2);
+  }
+
+  // error bit
+  cg->xor_(RWARG2, RWARG2);
+  cg->test(RWARG1, RWARG1);
+  cg->setnz(RWARG2.cvt8());
+  cg->shl(RWARG2, 31);
+  cg->or_(RWARG1, RWARG2);
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.FLAG.bits)], RWARG1);
+}
+
 u32 CPU::NewRec::CompileLoadStoreThunk(void* thunk_code, u32 thunk_space, void* code_address, u32 code_size,
                                        TickCount cycles_to_add, TickCount cycles_to_remove, u32 gpr_bitmask,
                                        u8 address_register, u8 data_register, MemoryAccessSize size, bool is_signed,
@@ -809,13 +809,21 @@ TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count
     {
       if (g_gpu->BeginDMAWrite()) [[likely]]
       {
-        u8* ram_pointer = Bus::g_ram;
-        for (u32 i = 0; i < word_count; i++)
+        if (increment == sizeof(u32) && (address + (word_count * sizeof(u32))) <= (mask + 1)) [[likely]]
         {
-          u32 value;
-          std::memcpy(&value, &ram_pointer[address], sizeof(u32));
-          g_gpu->DMAWrite(address, value);
-          address = (address + increment) & mask;
+          // forward and doesn't wrap, so the whole block can go in at once
+          g_gpu->DMAWriteBlock(address, src_pointer, word_count);
+        }
+        else
+        {
+          u8* ram_pointer = Bus::g_ram;
+          for (u32 i = 0; i < word_count; i++)
+          {
+            u32 value;
+            std::memcpy(&value, &ram_pointer[address], sizeof(u32));
+            g_gpu->DMAWrite(address, value);
+            address = (address + increment) & mask;
+          }
         }
         g_gpu->EndDMAWrite();
       }
@@ -3355,6 +3355,10 @@ void FullscreenUI::DrawConsoleSettingsPage()
     bsi, FSUI_ICONSTR(ICON_FA_FAST_FORWARD, "Readahead Sectors"),
     FSUI_CSTR("Reduces hitches in emulation by reading/decompressing CD data asynchronously on a worker thread."),
     "CDROM", "ReadaheadSectors", Settings::DEFAULT_CDROM_READAHEAD_SECTORS, 0, 32, FSUI_CSTR("%d sectors"));
+  DrawIntRangeSetting(
+    bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "CHD Prefetch Hunks"),
+    FSUI_CSTR("Decompresses CHD images ahead of the read position on worker threads, reducing stutter when streaming."),
+    "CDROM", "CHDPrefetchHunks", Settings::DEFAULT_CDROM_CHD_PREFETCH_HUNKS, 0, 16, FSUI_CSTR("%d hunks"));
 
   DrawToggleSetting(
     bsi, FSUI_ICONSTR(ICON_FA_DOWNLOAD, "Preload Images to RAM"),
@@ -3467,6 +3471,13 @@ void FullscreenUI::DrawEmulationSettingsPage()
     bsi, FSUI_ICONSTR(ICON_FA_GLASS_WHISKEY, "Rewind Save Slots"),
     FSUI_CSTR("How many saves will be kept for rewinding. Higher values have greater memory requirements."), "Main",
     "RewindSaveSlots", 10, 1, 10000, FSUI_CSTR("%d Frames"));
+  DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_MEMORY, "Delta Encode Rewind States"),
+                    FSUI_CSTR("Stores older rewind states as differences between saves. Reduces RAM usage, not VRAM."),
+                    "Main", "RewindDeltaStates", false);
+  DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COGS, "Compress Rewind States"),
+                    FSUI_CSTR("Compresses delta encoded rewind states on a background thread."), "Main",
+                    "RewindCompressStates", false,
+                    GetEffectiveBoolSetting(bsi, "Main", "RewindDeltaStates", false));
 
   const s32 runahead_frames = GetEffectiveIntSetting(bsi, "Main", "RunaheadFrameCount", 0);
   const bool runahead_enabled = (runahead_frames > 0);
@@ -6982,6 +6993,7 @@ bool FullscreenUI::IsLeaderboardsWindowOpen()
 // TRANSLATION-STRING-AREA-BEGIN
 TRANSLATE_NOOP("FullscreenUI", "%.2f Seconds");
 TRANSLATE_NOOP("FullscreenUI", "%d Frames");
+TRANSLATE_NOOP("FullscreenUI", "%d hunks");
 TRANSLATE_NOOP("FullscreenUI", "%d sectors");
 TRANSLATE_NOOP("FullscreenUI", "-");
 TRANSLATE_NOOP("FullscreenUI", "1 Frame");
@@ -7098,6 +7110,7 @@ TRANSLATE_NOOP("FullscreenUI", "Behavior");
 TRANSLATE_NOOP("FullscreenUI", "Borderless Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Buffer Size");
 TRANSLATE_NOOP("FullscreenUI", "CD-ROM Emulation");
+TRANSLATE_NOOP("FullscreenUI", "CHD Prefetch Hunks");
 TRANSLATE_NOOP("FullscreenUI", "CPU Emulation");
 TRANSLATE_NOOP("FullscreenUI", "CPU Mode");
 TRANSLATE_NOOP("FullscreenUI", "Cancel");
@@ -7123,6 +7136,8 @@ TRANSLATE_NOOP("FullscreenUI", "Close Menu");
 TRANSLATE_NOOP("FullscreenUI", "Compatibility Rating");
 TRANSLATE_NOOP("FullscreenUI", "Compatibility: ");
 TRANSLATE_NOOP("FullscreenUI", "Completely exits the application, returning you to your desktop.");
+TRANSLATE_NOOP("FullscreenUI", "Compress Rewind States");
+TRANSLATE_NOOP("FullscreenUI", "Compresses delta encoded rewind states on a background thread.");
 TRANSLATE_NOOP("FullscreenUI", "Configuration");
 TRANSLATE_NOOP("FullscreenUI", "Confirm Power Off");
 TRANSLATE_NOOP("FullscreenUI", "Console Settings");
@@ -7153,6 +7168,7 @@ TRANSLATE_NOOP("FullscreenUI", "Crop Mode");
 TRANSLATE_NOOP("FullscreenUI", "Culling Correction");
 TRANSLATE_NOOP("FullscreenUI", "Current Game");
 TRANSLATE_NOOP("FullscreenUI", "Debugging Settings");
+TRANSLATE_NOOP("FullscreenUI", "Decompresses CHD images ahead of the read position on worker threads, reducing stutter when streaming.");
 TRANSLATE_NOOP("FullscreenUI", "Default");
 TRANSLATE_NOOP("FullscreenUI", "Default Boot");
 TRANSLATE_NOOP("FullscreenUI", "Default View");
@@ -7161,6 +7177,7 @@ TRANSLATE_NOOP("FullscreenUI", "Default: Enabled");
 TRANSLATE_NOOP("FullscreenUI", "Deinterlacing Mode");
 TRANSLATE_NOOP("FullscreenUI", "Delete Save");
 TRANSLATE_NOOP("FullscreenUI", "Delete State");
+TRANSLATE_NOOP("FullscreenUI", "Delta Encode Rewind States");
 TRANSLATE_NOOP("FullscreenUI", "Depth Buffer");
 TRANSLATE_NOOP("FullscreenUI", "Desktop Mode");
 TRANSLATE_NOOP("FullscreenUI", "Details");
@@ -7552,6 +7569,7 @@ TRANSLATE_NOOP("FullscreenUI", "Start Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Start Game");
 TRANSLATE_NOOP("FullscreenUI", "Start a game from a disc in your PC's DVD drive.");
 TRANSLATE_NOOP("FullscreenUI", "Start the console without any disc inserted.");
+TRANSLATE_NOOP("FullscreenUI", "Stores older rewind states as differences between saves. Significantly reduces memory usage.");
 TRANSLATE_NOOP("FullscreenUI", "Stores the current settings to an input profile.");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Display Vertically");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Mode");
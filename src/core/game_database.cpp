@@ -9,18 +9,25 @@
 #include "util/imgui_manager.h"
 
 #include "common/assert.h"
-#include "common/byte_stream.h"
+#include "common/error.h"
+#include "common/file_system.h"
 #include "common/heterogeneous_containers.h"
 #include "common/log.h"
+#include "common/memmap.h"
 #include "common/path.h"
 #include "common/string_util.h"
 #include "common/timer.h"
 
 #include "ryml.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <type_traits>
 
@@ -33,19 +40,119 @@ namespace GameDatabase {
 enum : u32
 {
   GAME_DATABASE_CACHE_SIGNATURE = 0x45434C48,
-  GAME_DATABASE_CACHE_VERSION = 7,
+  GAME_DATABASE_CACHE_VERSION = 8,
 };
 
-static Entry* GetMutableEntry(const std::string_view& serial);
+namespace {
+
+// The cache is a flat image which is used in-place, either mapped from disk or built in memory from the YAML:
+//   CacheHeader
+//   CacheEntry[num_entries], sorted by serial
+//   CacheCode[num_codes], sorted by code
+//   CacheString[num_set_serials], disc set members referenced by the entries
+//   char[strings_size], string pool, not null terminated
+// Lookups binary search the tables, and only the entries which are found get decoded into an Entry.
+struct CacheHeader
+{
+  u32 signature;
+  u32 version;
+  u64 gamedb_timestamp;
+  u32 file_size;
+  u32 num_entries;
+  u32 entries_offset;
+  u32 num_codes;
+  u32 codes_offset;
+  u32 num_set_serials;
+  u32 set_serials_offset;
+  u32 strings_size;
+  u32 strings_offset;
+  u32 reserved;
+};
+static_assert(sizeof(CacheHeader) == 56);
+
+struct CacheString
+{
+  u32 offset;
+  u32 length;
+};
+
+enum CacheEntryFlags : u32
+{
+  CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET = (1u << 0),
+  CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET = (1u << 1),
+  CACHE_HAS_DISPLAY_LINE_START_OFFSET = (1u << 2),
+  CACHE_HAS_DISPLAY_LINE_END_OFFSET = (1u << 3),
+  CACHE_HAS_DMA_MAX_SLICE_TICKS = (1u << 4),
+  CACHE_HAS_DMA_HALT_TICKS = (1u << 5),
+  CACHE_HAS_GPU_FIFO_SIZE = (1u << 6),
+  CACHE_HAS_GPU_MAX_RUN_AHEAD = (1u << 7),
+  CACHE_HAS_GPU_PGXP_TOLERANCE = (1u << 8),
+  CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD = (1u << 9),
+  CACHE_HAS_GPU_LINE_DETECT_MODE = (1u << 10),
+};
+
+struct CacheEntry
+{
+  CacheString serial;
+  CacheString title;
+  CacheString genre;
+  CacheString developer;
+  CacheString publisher;
+  CacheString disc_set_name;
+  u64 release_date;
+  u32 first_set_serial;
+  u32 num_set_serials;
+  u32 traits;
+  u32 flags;
+  u32 dma_max_slice_ticks;
+  u32 dma_halt_ticks;
+  u32 gpu_fifo_size;
+  u32 gpu_max_run_ahead;
+  float gpu_pgxp_tolerance;
+  float gpu_pgxp_depth_threshold;
+  s16 display_active_start_offset;
+  s16 display_active_end_offset;
+  s8 display_line_start_offset;
+  s8 display_line_end_offset;
+  u16 supported_controllers;
+  u8 min_players;
+  u8 max_players;
+  u8 min_blocks;
+  u8 max_blocks;
+  u8 compatibility;
+  u8 gpu_line_detect_mode;
+  u8 reserved[2];
+};
+static_assert(sizeof(CacheEntry) == 112);
+static_assert(static_cast<u32>(Trait::Count) <= 32, "Traits fit in cache entry");
+
+struct CacheCode
+{
+  CacheString code;
+  u32 entry_index;
+};
+static_assert(sizeof(CacheCode) == 12);
+
+} // namespace
+
+using CodeLookupMap = PreferUnorderedStringMap<u32>;
+
 static const Entry* GetEntryForId(const std::string_view& code);
+static std::string_view GetCacheString(const CacheString& str);
+static const Entry* GetDecodedEntry(u32 index);
+static void DecodeEntry(const CacheEntry& centry, Entry* entry);
 
 static bool LoadFromCache();
-static bool SaveToCache();
+static bool SaveToCache(const std::vector<u8>& image);
+static bool SetDatabaseImage(const u8* data, size_t size, u64 gamedb_ts);
+static std::vector<u8> BuildDatabaseImage(const std::vector<Entry>& entries, const CodeLookupMap& code_lookup,
+                                          u64 gamedb_ts);
 
 static void SetRymlCallbacks();
-static bool LoadGameDBYaml();
+static bool LoadGameDBYaml(std::vector<Entry>* entries, CodeLookupMap* code_lookup);
 static bool ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value);
-static bool ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, std::string_view serial);
+static bool ParseYamlCodes(CodeLookupMap* code_lookup, u32 index, const ryml::ConstNodeRef& value,
+                           std::string_view serial);
 static bool LoadTrackHashes();
 
 static constexpr const std::array<const char*, static_cast<int>(CompatibilityRating::Count)>
@@ -91,8 +198,18 @@ static constexpr const char* DISCDB_YAML_FILENAME = "discdb.yaml";
 static bool s_loaded = false;
 static bool s_track_hashes_loaded = false;
 
-static std::vector<GameDatabase::Entry> s_entries;
-static PreferUnorderedStringMap<u32> s_code_lookup;
+// Database image, pointing either into s_mapped_cache or s_image_buffer (when mapping isn't supported).
+static const void* s_mapped_cache = nullptr;
+static size_t s_mapped_cache_size = 0;
+static std::vector<u8> s_image_buffer;
+static std::span<const CacheEntry> s_cache_entries;
+static std::span<const CacheCode> s_cache_codes;
+static std::span<const CacheString> s_cache_set_serials;
+static std::string_view s_cache_strings;
+
+// Entries are decoded on first use. The game list looks them up from several threads.
+static std::mutex s_decoded_entries_mutex;
+static std::vector<std::unique_ptr<Entry>> s_decoded_entries;
 
 static TrackHashesMap s_track_hashes_map;
 } // namespace GameDatabase
@@ -221,23 +338,68 @@ void GameDatabase::EnsureLoaded()
 
   if (!LoadFromCache())
   {
-    s_entries = {};
-    s_code_lookup = {};
+    const u64 gamedb_ts = Host::GetResourceFileTimestamp(GAMEDB_YAML_FILENAME, false).value_or(0);
+
+    std::vector<Entry> entries;
+    CodeLookupMap code_lookup;
+    LoadGameDBYaml(&entries, &code_lookup);
 
-    LoadGameDBYaml();
-    SaveToCache();
+    // Prefer using the mapping of the new cache, since the kernel can drop the pages when they're not in use.
+    std::vector<u8> image = BuildDatabaseImage(entries, code_lookup, gamedb_ts);
+    if (!SaveToCache(image) || !LoadFromCache())
+    {
+      s_image_buffer = std::move(image);
+      if (!SetDatabaseImage(s_image_buffer.data(), s_image_buffer.size(), gamedb_ts))
+        Panic("Failed to use freshly built game database image.");
+    }
   }
 
-  Log_InfoFmt("Database load of {} entries took {:.0f}ms.", s_entries.size(), timer.GetTimeMilliseconds());
+  Log_InfoFmt("Database load of {} entries took {:.0f}ms.", s_cache_entries.size(), timer.GetTimeMilliseconds());
 }
 
 void GameDatabase::Unload()
 {
-  s_entries = {};
-  s_code_lookup = {};
+  s_decoded_entries.clear();
+  s_cache_entries = {};
+  s_cache_codes = {};
+  s_cache_set_serials = {};
+  s_cache_strings = {};
+  s_image_buffer = {};
+  if (s_mapped_cache)
+  {
+    MemMap::UnmapFile(s_mapped_cache, s_mapped_cache_size);
+    s_mapped_cache = nullptr;
+    s_mapped_cache_size = 0;
+  }
+
   s_loaded = false;
 }
 
+std::string_view GameDatabase::GetCacheString(const CacheString& str)
+{
+  // bounds are checked here rather than at load time, so the whole image doesn't have to be touched
+  if (str.offset > s_cache_strings.size() || str.length > (s_cache_strings.size() - str.offset))
+  {
+    Log_ErrorFmt("Game database cache string at {} is out of range", str.offset);
+    return {};
+  }
+
+  return s_cache_strings.substr(str.offset, str.length);
+}
+
+const GameDatabase::Entry* GameDatabase::GetDecodedEntry(u32 index)
+{
+  std::unique_lock lock(s_decoded_entries_mutex);
+  std::unique_ptr<Entry>& entry = s_decoded_entries[index];
+  if (!entry)
+  {
+    entry = std::make_unique<Entry>();
+    DecodeEntry(s_cache_entries[index], entry.get());
+  }
+
+  return entry.get();
+}
+
 const GameDatabase::Entry* GameDatabase::GetEntryForId(const std::string_view& code)
 {
   if (code.empty())
@@ -245,8 +407,17 @@ const GameDatabase::Entry* GameDatabase::GetEntryForId(const std::string_view& c
 
   EnsureLoaded();
 
-  auto iter = s_code_lookup.find(code);
-  return (iter != s_code_lookup.end()) ? &s_entries[iter->second] : nullptr;
+  const auto iter = std::lower_bound(s_cache_codes.begin(), s_cache_codes.end(), code,
+                                     [](const CacheCode& lhs, std::string_view rhs) {
+                                       return (GetCacheString(lhs.code) < rhs);
+                                     });
+  if (iter == s_cache_codes.end() || GetCacheString(iter->code) != code ||
+      iter->entry_index >= static_cast<u32>(s_cache_entries.size()))
+  {
+    return nullptr;
+  }
+
+  return GetDecodedEntry(iter->entry_index);
 }
 
 std::string GameDatabase::GetSerialForDisc(CDImage* image)
@@ -310,18 +481,14 @@ const GameDatabase::Entry* GameDatabase::GetEntryForSerial(const std::string_vie
 {
   EnsureLoaded();
 
-  return GetMutableEntry(serial);
-}
-
-GameDatabase::Entry* GameDatabase::GetMutableEntry(const std::string_view& serial)
-{
-  for (Entry& entry : s_entries)
-  {
-    if (entry.serial == serial)
-      return &entry;
-  }
+  const auto iter = std::lower_bound(s_cache_entries.begin(), s_cache_entries.end(), serial,
+                                     [](const CacheEntry& lhs, std::string_view rhs) {
+                                       return (GetCacheString(lhs.serial) < rhs);
+                                     });
+  if (iter == s_cache_entries.end() || GetCacheString(iter->serial) != serial)
+    return nullptr;
 
-  return nullptr;
+  return GetDecodedEntry(static_cast<u32>(iter - s_cache_entries.begin()));
 }
 
 const char* GameDatabase::GetCompatibilityRatingName(CompatibilityRating rating)
@@ -669,213 +836,283 @@ void GameDatabase::Entry::ApplySettings(Settings& settings, bool display_osd_mes
 #undef BIT_FOR
 }
 
-template<typename T>
-bool ReadOptionalFromStream(ByteStream* stream, std::optional<T>* dest)
+static std::string GetCacheFile()
 {
-  bool has_value;
-  if (!stream->Read2(&has_value, sizeof(has_value)))
-    return false;
-
-  if (!has_value)
-    return true;
-
-  T value;
-  if (!stream->Read2(&value, sizeof(T)))
-    return false;
-
-  *dest = value;
-  return true;
+  return Path::Combine(EmuFolders::Cache, "gamedb.cache");
 }
 
-template<typename T>
-bool WriteOptionalToStream(ByteStream* stream, const std::optional<T>& src)
+bool GameDatabase::LoadFromCache()
 {
-  const bool has_value = src.has_value();
-  if (!stream->Write2(&has_value, sizeof(has_value)))
-    return false;
+  const std::string filename = GetCacheFile();
+  const u64 gamedb_ts = Host::GetResourceFileTimestamp(GAMEDB_YAML_FILENAME, false).value_or(0);
 
-  if (!has_value)
-    return true;
+  Error error;
+  size_t size;
+  const void* data = MemMap::MapFileReadOnly(filename.c_str(), &size, &error);
+  if (!data)
+  {
+    // Not every platform can map files, so read it in instead. Still much faster than parsing the YAML.
+    Log_DevFmt("Cache could not be mapped, reading it instead: {}", error.GetDescription());
+    std::optional<std::vector<u8>> image = FileSystem::ReadBinaryFile(filename.c_str(), &error);
+    if (!image.has_value())
+    {
+      Log_DevFmt("Cache could not be read, loading full database: {}", error.GetDescription());
+      return false;
+    }
 
-  return stream->Write2(&src.value(), sizeof(T));
-}
+    s_image_buffer = std::move(image.value());
+    if (!SetDatabaseImage(s_image_buffer.data(), s_image_buffer.size(), gamedb_ts))
+    {
+      s_image_buffer = {};
+      return false;
+    }
 
-static std::string GetCacheFile()
-{
-  return Path::Combine(EmuFolders::Cache, "gamedb.cache");
-}
+    return true;
+  }
 
-bool GameDatabase::LoadFromCache()
-{
-  std::unique_ptr<ByteStream> stream(
-    ByteStream::OpenFile(GetCacheFile().c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED));
-  if (!stream)
+  if (!SetDatabaseImage(static_cast<const u8*>(data), size, gamedb_ts))
   {
-    Log_DevPrintf("Cache does not exist, loading full database.");
+    MemMap::UnmapFile(data, size);
     return false;
   }
 
-  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
+  s_mapped_cache = data;
+  s_mapped_cache_size = size;
+  return true;
+}
 
-  u32 signature, version, num_entries, num_codes;
-  u64 file_gamedb_ts;
-  if (!stream->ReadU32(&signature) || !stream->ReadU32(&version) || !stream->ReadU64(&file_gamedb_ts) ||
-      !stream->ReadU32(&num_entries) || !stream->ReadU32(&num_codes) || signature != GAME_DATABASE_CACHE_SIGNATURE ||
-      version != GAME_DATABASE_CACHE_VERSION)
+bool GameDatabase::SetDatabaseImage(const u8* data, size_t size, u64 gamedb_ts)
+{
+  if (size < sizeof(CacheHeader))
   {
-    Log_DevPrintf("Cache header is corrupted or version mismatch.");
+    Log_DevPrint("Cache header is truncated.");
     return false;
   }
 
-  if (gamedb_ts != file_gamedb_ts)
+  CacheHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.signature != GAME_DATABASE_CACHE_SIGNATURE || header.version != GAME_DATABASE_CACHE_VERSION ||
+      header.file_size != size)
   {
-    Log_DevPrintf("Cache is out of date, recreating.");
+    Log_DevPrint("Cache header is corrupted or version mismatch.");
     return false;
   }
 
-  s_entries.reserve(num_entries);
-
-  for (u32 i = 0; i < num_entries; i++)
+  if (header.gamedb_timestamp != gamedb_ts)
   {
-    Entry& entry = s_entries.emplace_back();
-
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    u8 compatibility;
-    u32 num_disc_set_serials;
-
-    if (!stream->ReadSizePrefixedString(&entry.serial) || !stream->ReadSizePrefixedString(&entry.title) ||
-        !stream->ReadSizePrefixedString(&entry.genre) || !stream->ReadSizePrefixedString(&entry.developer) ||
-        !stream->ReadSizePrefixedString(&entry.publisher) || !stream->ReadU64(&entry.release_date) ||
-        !stream->ReadU8(&entry.min_players) || !stream->ReadU8(&entry.max_players) ||
-        !stream->ReadU8(&entry.min_blocks) || !stream->ReadU8(&entry.max_blocks) ||
-        !stream->ReadU16(&entry.supported_controllers) || !stream->ReadU8(&compatibility) ||
-        compatibility >= static_cast<u8>(GameDatabase::CompatibilityRating::Count) ||
-        !stream->Read2(bits.data(), num_bytes) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_active_start_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_active_end_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_line_start_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_line_end_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.dma_max_slice_ticks) ||
-        !ReadOptionalFromStream(stream.get(), &entry.dma_halt_ticks) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_fifo_size) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_max_run_ahead) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_pgxp_tolerance) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_pgxp_depth_threshold) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_line_detect_mode) ||
-        !stream->ReadSizePrefixedString(&entry.disc_set_name) || !stream->ReadU32(&num_disc_set_serials))
-    {
-      Log_DevPrintf("Cache entry is corrupted.");
-      return false;
-    }
-
-    if (num_disc_set_serials > 0)
-    {
-      entry.disc_set_serials.reserve(num_disc_set_serials);
-      for (u32 j = 0; j < num_disc_set_serials; j++)
-      {
-        if (!stream->ReadSizePrefixedString(&entry.disc_set_serials.emplace_back()))
-        {
-          Log_DevPrintf("Cache entry is corrupted.");
-          return false;
-        }
-      }
-    }
-
-    entry.compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility);
-    entry.traits.reset();
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
-    {
-      if ((bits[j / 8] & (1u << (j % 8))) != 0)
-        entry.traits[j] = true;
-    }
+    Log_DevPrint("Cache is out of date, recreating.");
+    return false;
   }
 
-  for (u32 i = 0; i < num_codes; i++)
+  const auto table_valid = [size](u32 offset, u32 count, size_t element_size, size_t alignment) {
+    return ((offset % alignment) == 0 && offset <= size && count <= ((size - offset) / element_size));
+  };
+  if (!table_valid(header.entries_offset, header.num_entries, sizeof(CacheEntry), alignof(CacheEntry)) ||
+      !table_valid(header.codes_offset, header.num_codes, sizeof(CacheCode), alignof(CacheCode)) ||
+      !table_valid(header.set_serials_offset, header.num_set_serials, sizeof(CacheString), alignof(CacheString)) ||
+      !table_valid(header.strings_offset, header.strings_size, sizeof(char), alignof(char)))
   {
-    std::string code;
-    u32 index;
-    if (!stream->ReadSizePrefixedString(&code) || !stream->ReadU32(&index) ||
-        index >= static_cast<u32>(s_entries.size()))
-    {
-      Log_DevPrintf("Cache code entry is corrupted.");
-      return false;
-    }
-
-    s_code_lookup.emplace(std::move(code), index);
+    Log_DevPrint("Cache table is out of range.");
+    return false;
   }
 
+  s_cache_entries = std::span<const CacheEntry>(reinterpret_cast<const CacheEntry*>(data + header.entries_offset),
+                                                header.num_entries);
+  s_cache_codes =
+    std::span<const CacheCode>(reinterpret_cast<const CacheCode*>(data + header.codes_offset), header.num_codes);
+  s_cache_set_serials = std::span<const CacheString>(
+    reinterpret_cast<const CacheString*>(data + header.set_serials_offset), header.num_set_serials);
+  s_cache_strings = std::string_view(reinterpret_cast<const char*>(data + header.strings_offset), header.strings_size);
+  s_decoded_entries.clear();
+  s_decoded_entries.resize(header.num_entries);
   return true;
 }
 
-bool GameDatabase::SaveToCache()
+void GameDatabase::DecodeEntry(const CacheEntry& centry, Entry* entry)
 {
-  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
+  entry->serial = GetCacheString(centry.serial);
+  entry->title = GetCacheString(centry.title);
+  entry->genre = GetCacheString(centry.genre);
+  entry->developer = GetCacheString(centry.developer);
+  entry->publisher = GetCacheString(centry.publisher);
+  entry->release_date = centry.release_date;
+  entry->min_players = centry.min_players;
+  entry->max_players = centry.max_players;
+  entry->min_blocks = centry.min_blocks;
+  entry->max_blocks = centry.max_blocks;
+  entry->supported_controllers = centry.supported_controllers;
+  entry->compatibility = (centry.compatibility < static_cast<u8>(CompatibilityRating::Count)) ?
+                           static_cast<CompatibilityRating>(centry.compatibility) :
+                           CompatibilityRating::Unknown;
+  entry->traits = decltype(entry->traits)(centry.traits);
+
+  const auto decode_optional = [&centry](auto& dest, u32 flag, auto value) {
+    if (centry.flags & flag)
+      dest = value;
+  };
+  decode_optional(entry->display_active_start_offset, CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET,
+                  centry.display_active_start_offset);
+  decode_optional(entry->display_active_end_offset, CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET,
+                  centry.display_active_end_offset);
+  decode_optional(entry->display_line_start_offset, CACHE_HAS_DISPLAY_LINE_START_OFFSET,
+                  centry.display_line_start_offset);
+  decode_optional(entry->display_line_end_offset, CACHE_HAS_DISPLAY_LINE_END_OFFSET, centry.display_line_end_offset);
+  decode_optional(entry->dma_max_slice_ticks, CACHE_HAS_DMA_MAX_SLICE_TICKS, centry.dma_max_slice_ticks);
+  decode_optional(entry->dma_halt_ticks, CACHE_HAS_DMA_HALT_TICKS, centry.dma_halt_ticks);
+  decode_optional(entry->gpu_fifo_size, CACHE_HAS_GPU_FIFO_SIZE, centry.gpu_fifo_size);
+  decode_optional(entry->gpu_max_run_ahead, CACHE_HAS_GPU_MAX_RUN_AHEAD, centry.gpu_max_run_ahead);
+  decode_optional(entry->gpu_pgxp_tolerance, CACHE_HAS_GPU_PGXP_TOLERANCE, centry.gpu_pgxp_tolerance);
+  decode_optional(entry->gpu_pgxp_depth_threshold, CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD,
+                  centry.gpu_pgxp_depth_threshold);
+  if ((centry.flags & CACHE_HAS_GPU_LINE_DETECT_MODE) &&
+      centry.gpu_line_detect_mode < static_cast<u8>(GPULineDetectMode::Count))
+  {
+    entry->gpu_line_detect_mode = static_cast<GPULineDetectMode>(centry.gpu_line_detect_mode);
+  }
 
-  std::unique_ptr<ByteStream> stream(
-    ByteStream::OpenFile(GetCacheFile().c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE |
-                                                   BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_STREAMED));
-  if (!stream)
-    return false;
+  entry->disc_set_name = GetCacheString(centry.disc_set_name);
+  if (centry.first_set_serial <= s_cache_set_serials.size() &&
+      centry.num_set_serials <= (s_cache_set_serials.size() - centry.first_set_serial))
+  {
+    entry->disc_set_serials.reserve(centry.num_set_serials);
+    for (const CacheString& serial : s_cache_set_serials.subspan(centry.first_set_serial, centry.num_set_serials))
+      entry->disc_set_serials.emplace_back(GetCacheString(serial));
+  }
+}
 
-  bool result = stream->WriteU32(GAME_DATABASE_CACHE_SIGNATURE);
-  result = result && stream->WriteU32(GAME_DATABASE_CACHE_VERSION);
-  result = result && stream->WriteU64(static_cast<u64>(gamedb_ts));
+std::vector<u8> GameDatabase::BuildDatabaseImage(const std::vector<Entry>& entries, const CodeLookupMap& code_lookup,
+                                                 u64 gamedb_ts)
+{
+  std::string strings;
+  PreferUnorderedStringMap<CacheString> string_map;
+  const auto add_string = [&strings, &string_map](std::string_view str) {
+    // lots of repeated developers/publishers/genres
+    const auto iter = string_map.find(str);
+    if (iter != string_map.end())
+      return iter->second;
+
+    const CacheString ret = {static_cast<u32>(strings.size()), static_cast<u32>(str.size())};
+    strings.append(str);
+    string_map.emplace(str, ret);
+    return ret;
+  };
 
-  result = result && stream->WriteU32(static_cast<u32>(s_entries.size()));
-  result = result && stream->WriteU32(static_cast<u32>(s_code_lookup.size()));
+  std::vector<u32> order(entries.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(),
+                   [&entries](u32 lhs, u32 rhs) { return (entries[lhs].serial < entries[rhs].serial); });
 
-  for (const Entry& entry : s_entries)
+  std::vector<u32> sorted_index(entries.size());
+  std::vector<CacheEntry> cache_entries;
+  std::vector<CacheString> set_serials;
+  cache_entries.reserve(entries.size());
+  for (const u32 index : order)
   {
-    result = result && stream->WriteSizePrefixedString(entry.serial);
-    result = result && stream->WriteSizePrefixedString(entry.title);
-    result = result && stream->WriteSizePrefixedString(entry.genre);
-    result = result && stream->WriteSizePrefixedString(entry.developer);
-    result = result && stream->WriteSizePrefixedString(entry.publisher);
-    result = result && stream->WriteU64(entry.release_date);
-    result = result && stream->WriteU8(entry.min_players);
-    result = result && stream->WriteU8(entry.max_players);
-    result = result && stream->WriteU8(entry.min_blocks);
-    result = result && stream->WriteU8(entry.max_blocks);
-    result = result && stream->WriteU16(entry.supported_controllers);
-    result = result && stream->WriteU8(static_cast<u8>(entry.compatibility));
-
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    bits.fill(0);
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
+    const Entry& entry = entries[index];
+    sorted_index[index] = static_cast<u32>(cache_entries.size());
+
+    CacheEntry& centry = cache_entries.emplace_back();
+    std::memset(&centry, 0, sizeof(centry));
+    centry.serial = add_string(entry.serial);
+    centry.title = add_string(entry.title);
+    centry.genre = add_string(entry.genre);
+    centry.developer = add_string(entry.developer);
+    centry.publisher = add_string(entry.publisher);
+    centry.disc_set_name = add_string(entry.disc_set_name);
+    centry.release_date = entry.release_date;
+    centry.first_set_serial = static_cast<u32>(set_serials.size());
+    centry.num_set_serials = static_cast<u32>(entry.disc_set_serials.size());
+    for (const std::string& serial : entry.disc_set_serials)
+      set_serials.push_back(add_string(serial));
+    centry.traits = static_cast<u32>(entry.traits.to_ulong());
+    centry.supported_controllers = entry.supported_controllers;
+    centry.min_players = entry.min_players;
+    centry.max_players = entry.max_players;
+    centry.min_blocks = entry.min_blocks;
+    centry.max_blocks = entry.max_blocks;
+    centry.compatibility = static_cast<u8>(entry.compatibility);
+
+    const auto encode_optional = [&centry](const auto& src, u32 flag, auto& dest) {
+      if (src.has_value())
+      {
+        centry.flags |= flag;
+        dest = src.value();
+      }
+    };
+    encode_optional(entry.display_active_start_offset, CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET,
+                    centry.display_active_start_offset);
+    encode_optional(entry.display_active_end_offset, CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET,
+                    centry.display_active_end_offset);
+    encode_optional(entry.display_line_start_offset, CACHE_HAS_DISPLAY_LINE_START_OFFSET,
+                    centry.display_line_start_offset);
+    encode_optional(entry.display_line_end_offset, CACHE_HAS_DISPLAY_LINE_END_OFFSET, centry.display_line_end_offset);
+    encode_optional(entry.dma_max_slice_ticks, CACHE_HAS_DMA_MAX_SLICE_TICKS, centry.dma_max_slice_ticks);
+    encode_optional(entry.dma_halt_ticks, CACHE_HAS_DMA_HALT_TICKS, centry.dma_halt_ticks);
+    encode_optional(entry.gpu_fifo_size, CACHE_HAS_GPU_FIFO_SIZE, centry.gpu_fifo_size);
+    encode_optional(entry.gpu_max_run_ahead, CACHE_HAS_GPU_MAX_RUN_AHEAD, centry.gpu_max_run_ahead);
+    encode_optional(entry.gpu_pgxp_tolerance, CACHE_HAS_GPU_PGXP_TOLERANCE, centry.gpu_pgxp_tolerance);
+    encode_optional(entry.gpu_pgxp_depth_threshold, CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD,
+                    centry.gpu_pgxp_depth_threshold);
+    if (entry.gpu_line_detect_mode.has_value())
     {
-      if (entry.traits[j])
-        bits[j / 8] |= (1u << (j % 8));
+      centry.flags |= CACHE_HAS_GPU_LINE_DETECT_MODE;
+      centry.gpu_line_detect_mode = static_cast<u8>(entry.gpu_line_detect_mode.value());
     }
+  }
 
-    result = result && stream->Write2(bits.data(), num_bytes);
-
-    result = result && WriteOptionalToStream(stream.get(), entry.display_active_start_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_active_end_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_line_start_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_line_end_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.dma_max_slice_ticks);
-    result = result && WriteOptionalToStream(stream.get(), entry.dma_halt_ticks);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_fifo_size);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_max_run_ahead);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_pgxp_tolerance);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_pgxp_depth_threshold);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_line_detect_mode);
-
-    result = result && stream->WriteSizePrefixedString(entry.disc_set_name);
-    result = result && stream->WriteU32(static_cast<u32>(entry.disc_set_serials.size()));
-    for (const std::string& serial : entry.disc_set_serials)
-      result = result && stream->WriteSizePrefixedString(serial);
+  std::vector<CacheCode> codes;
+  codes.reserve(code_lookup.size());
+  for (const auto& [code, index] : code_lookup)
+    codes.push_back(CacheCode{add_string(code), sorted_index[index]});
+
+  const std::string_view strings_view = strings;
+  std::sort(codes.begin(), codes.end(), [strings_view](const CacheCode& lhs, const CacheCode& rhs) {
+    return (strings_view.substr(lhs.code.offset, lhs.code.length) <
+            strings_view.substr(rhs.code.offset, rhs.code.length));
+  });
+
+  CacheHeader header = {};
+  header.signature = GAME_DATABASE_CACHE_SIGNATURE;
+  header.version = GAME_DATABASE_CACHE_VERSION;
+  header.gamedb_timestamp = gamedb_ts;
+  header.num_entries = static_cast<u32>(cache_entries.size());
+  header.entries_offset = sizeof(CacheHeader);
+  header.num_codes = static_cast<u32>(codes.size());
+  header.codes_offset = header.entries_offset + header.num_entries * static_cast<u32>(sizeof(CacheEntry));
+  header.num_set_serials = static_cast<u32>(set_serials.size());
+  header.set_serials_offset = header.codes_offset + header.num_codes * static_cast<u32>(sizeof(CacheCode));
+  header.strings_size = static_cast<u32>(strings.size());
+  header.strings_offset = header.set_serials_offset + header.num_set_serials * static_cast<u32>(sizeof(CacheString));
+  header.file_size = header.strings_offset + header.strings_size;
+
+  std::vector<u8> image(header.file_size);
+  std::memcpy(image.data(), &header, sizeof(header));
+  std::memcpy(image.data() + header.entries_offset, cache_entries.data(), cache_entries.size() * sizeof(CacheEntry));
+  std::memcpy(image.data() + header.codes_offset, codes.data(), codes.size() * sizeof(CacheCode));
+  std::memcpy(image.data() + header.set_serials_offset, set_serials.data(), set_serials.size() * sizeof(CacheString));
+  std::memcpy(image.data() + header.strings_offset, strings.data(), strings.size());
+  return image;
+}
+
+bool GameDatabase::SaveToCache(const std::vector<u8>& image)
+{
+  // write to a temporary file first, another instance may have the current cache mapped
+  const std::string filename = GetCacheFile();
+  const std::string temp_filename = filename + ".tmp";
+  if (!FileSystem::WriteBinaryFile(temp_filename.c_str(), image.data(), image.size()))
+  {
+    Log_ErrorFmt("Failed to write game database cache '{}'", temp_filename);
+    return false;
   }
 
-  for (const auto& it : s_code_lookup)
+  Error error;
+  if (!FileSystem::RenamePath(temp_filename.c_str(), filename.c_str(), &error))
   {
-    result = result && stream->WriteSizePrefixedString(it.first);
-    result = result && stream->WriteU32(it.second);
+    Log_ErrorFmt("Failed to replace game database cache: {}", error.GetDescription());
+    FileSystem::DeleteFile(temp_filename.c_str());
+    return false;
   }
 
-  result = result && stream->Flush();
   return true;
 }
 
@@ -890,7 +1127,7 @@ void GameDatabase::SetRymlCallbacks()
     [](const char* msg, size_t msg_size) { Log_ErrorFmt("C4 error: {}", std::string_view(msg, msg_size)); });
 }
 
-bool GameDatabase::LoadGameDBYaml()
+bool GameDatabase::LoadGameDBYaml(std::vector<Entry>* entries, CodeLookupMap* code_lookup)
 {
   const std::optional<std::string> gamedb_data = Host::ReadResourceFileToString(GAMEDB_YAML_FILENAME, false);
   if (!gamedb_data.has_value())
@@ -903,24 +1140,23 @@ bool GameDatabase::LoadGameDBYaml()
 
   const ryml::Tree tree = ryml::parse_in_arena(to_csubstr(GAMEDB_YAML_FILENAME), to_csubstr(gamedb_data.value()));
   const ryml::ConstNodeRef root = tree.rootref();
-  s_entries.reserve(root.num_children());
+  entries->reserve(root.num_children());
 
   for (const ryml::ConstNodeRef& current : root.children())
   {
-    // TODO: binary sort
-    const u32 index = static_cast<u32>(s_entries.size());
-    Entry& entry = s_entries.emplace_back();
+    const u32 index = static_cast<u32>(entries->size());
+    Entry& entry = entries->emplace_back();
     if (!ParseYamlEntry(&entry, current))
     {
-      s_entries.pop_back();
+      entries->pop_back();
       continue;
     }
 
-    ParseYamlCodes(index, current, entry.serial);
+    ParseYamlCodes(code_lookup, index, current, entry.serial);
   }
 
   ryml::reset_callbacks();
-  return !s_entries.empty();
+  return !entries->empty();
 }
 
 bool GameDatabase::ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value)
@@ -1108,20 +1344,21 @@ bool GameDatabase::ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value)
   return true;
 }
 
-bool GameDatabase::ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, std::string_view serial)
+bool GameDatabase::ParseYamlCodes(CodeLookupMap* code_lookup, u32 index, const ryml::ConstNodeRef& value,
+                                  std::string_view serial)
 {
   const ryml::ConstNodeRef& codes = value.find_child(to_csubstr("codes"));
   if (!codes.valid() || !codes.has_children())
   {
     // use serial instead
-    auto iter = s_code_lookup.find(serial);
-    if (iter != s_code_lookup.end())
+    auto iter = code_lookup->find(serial);
+    if (iter != code_lookup->end())
     {
       Log_WarningFmt("Duplicate code '{}'", serial);
       return false;
     }
 
-    s_code_lookup.emplace(serial, index);
+    code_lookup->emplace(serial, index);
     return true;
   }
 
@@ -1135,14 +1372,14 @@ bool GameDatabase::ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, st
       continue;
     }
 
-    auto iter = s_code_lookup.find(current_code_str);
-    if (iter != s_code_lookup.end())
+    auto iter = code_lookup->find(current_code_str);
+    if (iter != code_lookup->end())
     {
       Log_WarningFmt("Duplicate code '{}' in {}", current_code_str, serial);
       continue;
     }
 
-    s_code_lookup.emplace(current_code_str, index);
+    code_lookup->emplace(current_code_str, index);
     added++;
   }
 
@@ -19,12 +19,17 @@
 #include "common/path.h"
 #include "common/progress_callback.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -48,6 +53,12 @@ enum : u32
   PLAYED_TIME_TOTAL_TIME_LENGTH = 20, // uint64
   PLAYED_TIME_LINE_LENGTH =
     PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
+
+  // Scanning is mostly waiting on I/O, too many threads just thrash network shares.
+  MAX_AUTO_SCAN_THREADS = 4,
+  MAX_SCAN_THREADS = 32,
+  SCAN_MERGE_BATCH_SIZE = 32,
+  SCAN_MERGE_INTERVAL_MS = 100,
 };
 
 struct PlayedTimeEntry
@@ -56,10 +67,18 @@ struct PlayedTimeEntry
   std::time_t total_played_time;
 };
 
+struct ScanFileInfo
+{
+  std::string path;
+  std::time_t timestamp;
+};
+
 } // namespace
 
 using CacheMap = PreferUnorderedStringMap<Entry>;
 using PlayedTimeMap = PreferUnorderedStringMap<PlayedTimeEntry>;
+using EntryIndexMap = PreferUnorderedStringMap<u32>;
+using EntryMultiIndexMap = PreferUnorderedStringMap<std::vector<u32>>;
 
 static_assert(std::is_same_v<decltype(Entry::hash), System::GameHash>);
 
@@ -67,13 +86,21 @@ static bool GetExeListEntry(const std::string& path, Entry* entry);
 static bool GetPsfListEntry(const std::string& path, Entry* entry);
 static bool GetDiscListEntry(const std::string& path, Entry* entry);
 
+static std::string GetIndexKey(std::string_view str);
+static void AddEntry(Entry entry, const PlayedTimeMap& played_time_map);
+static void ClearEntries(std::vector<Entry>* old_entries);
+
 static bool GetGameListEntryFromCache(const std::string& path, Entry* entry);
 static void ScanDirectory(const char* path, bool recursive, bool only_cache,
                           const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
+                          std::vector<ScanFileInfo>* scan_files, PreferUnorderedStringSet* scan_keys,
                           ProgressCallback* progress);
 static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
-static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                     const PlayedTimeMap& played_time_map);
+static u32 GetScanThreadCount();
+static void ScanFiles(std::vector<ScanFileInfo> files, const PlayedTimeMap& played_time_map,
+                      ProgressCallback* progress);
+static void MergeScannedEntries(std::vector<Entry>& entries, const PlayedTimeMap& played_time_map,
+                                ProgressCallback* progress);
 
 static std::string GetCacheFilename();
 static void LoadCache();
@@ -92,6 +119,8 @@ static PlayedTimeEntry UpdatePlayedTimeFile(const std::string& path, const std::
 } // namespace GameList
 
 static std::vector<GameList::Entry> s_entries;
+static GameList::EntryIndexMap s_path_index;
+static GameList::EntryMultiIndexMap s_serial_index;
 static std::recursive_mutex s_mutex;
 static GameList::CacheMap s_cache_map;
 static std::unique_ptr<ByteStream> s_cache_write_stream;
@@ -484,6 +513,7 @@ static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const
 
 void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
                              const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
+                             std::vector<ScanFileInfo>* scan_files, PreferUnorderedStringSet* scan_keys,
                              ProgressCallback* progress)
 {
   Log_InfoPrintf("Scanning %s%s", path, recursive ? " (recursively)" : "");
@@ -498,35 +528,26 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
   if (files.empty())
     return;
 
-  progress->PushState();
-  progress->SetProgressRange(static_cast<u32>(files.size()));
-  progress->SetProgressValue(0);
-
-  u32 files_scanned = 0;
+  // cache lookups are cheap, so do them all here, and leave the files which need to be opened for the workers
+  std::unique_lock lock(s_mutex);
   for (FILESYSTEM_FIND_DATA& ffd : files)
   {
-    files_scanned++;
+    if (progress->IsCancelled())
+      break;
 
-    if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) ||
-        IsPathExcluded(excluded_paths, ffd.FileName))
+    if (!GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName) ||
+        GetEntryForPath(ffd.FileName.c_str()) ||
+        AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
     {
       continue;
     }
 
-    std::unique_lock lock(s_mutex);
-    if (GetEntryForPath(ffd.FileName.c_str()) ||
-        AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
-    {
+    // directories can overlap, don't scan the same file twice
+    if (!scan_keys->insert(GetIndexKey(ffd.FileName)).second)
       continue;
-    }
 
-    progress->SetFormattedStatusText("Scanning '%s'...", FileSystem::GetDisplayNameFromPath(ffd.FileName).c_str());
-    ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map);
-    progress->SetProgressValue(files_scanned);
+    scan_files->push_back(ScanFileInfo{std::move(ffd.FileName), ffd.ModificationTime});
   }
-
-  progress->SetProgressValue(files_scanned);
-  progress->PopState();
 }
 
 bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map)
@@ -535,38 +556,148 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
   if (!GetGameListEntryFromCache(path, &entry) || entry.last_modified_time != timestamp)
     return false;
 
-  auto iter = played_time_map.find(entry.serial);
-  if (iter != played_time_map.end())
-  {
-    entry.last_played_time = iter->second.last_played_time;
-    entry.total_played_time = iter->second.total_played_time;
-  }
-
-  s_entries.push_back(std::move(entry));
+  AddEntry(std::move(entry), played_time_map);
   return true;
 }
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                        const PlayedTimeMap& played_time_map)
+u32 GameList::GetScanThreadCount()
 {
-  // don't block UI while scanning
-  lock.unlock();
+  const u32 threads = Host::GetBaseUIntSettingValue("GameList", "ScanThreads", 0);
+  if (threads > 0)
+    return std::min<u32>(threads, MAX_SCAN_THREADS);
 
-  Log_DevPrintf("Scanning '%s'...", path.c_str());
+  return std::clamp<u32>(std::thread::hardware_concurrency(), 1, MAX_AUTO_SCAN_THREADS);
+}
 
-  Entry entry;
-  if (!PopulateEntryFromPath(path, &entry))
-    return false;
+void GameList::ScanFiles(std::vector<ScanFileInfo> files, const PlayedTimeMap& played_time_map,
+                         ProgressCallback* progress)
+{
+  const u32 num_files = static_cast<u32>(files.size());
+  const u32 num_threads = std::min(GetScanThreadCount(), num_files);
+  Log_InfoPrintf("Scanning %u files with %u threads", num_files, num_threads);
+
+  progress->PushState();
+  progress->SetProgressRange(num_files);
+  progress->SetProgressValue(0);
+
+  // The database is loaded on first use, which can't happen on several threads at once.
+  GameDatabase::EnsureLoaded();
+
+  std::mutex results_mutex;
+  std::condition_variable results_cv;
+  std::vector<Entry> results;
+  u32 num_finished = 0;
+  std::atomic<u32> next_file{0};
+  std::atomic_bool cancelled{false};
 
-  entry.path = std::move(path);
-  entry.last_modified_time = timestamp;
+  const auto worker = [&]() {
+    Threading::SetNameOfCurrentThread("Game List Scanner");
+
+    for (;;)
+    {
+      const u32 index = next_file.fetch_add(1, std::memory_order_relaxed);
+      if (index >= num_files || cancelled.load(std::memory_order_relaxed))
+        break;
+
+      ScanFileInfo& file = files[index];
+      Log_DevPrintf("Scanning '%s'...", file.path.c_str());
+
+      Entry entry;
+      const bool populated = PopulateEntryFromPath(file.path, &entry);
+      if (populated)
+      {
+        entry.path = std::move(file.path);
+        entry.last_modified_time = file.timestamp;
+      }
 
+      std::unique_lock lock(results_mutex);
+      if (populated)
+        results.push_back(std::move(entry));
+      num_finished++;
+      if (results.size() >= SCAN_MERGE_BATCH_SIZE || num_finished == num_files)
+        results_cv.notify_one();
+    }
+  };
+
+  std::vector<Threading::Thread> threads;
+  threads.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+    threads.emplace_back(worker);
+
+  // Merge in batches, so the UI isn't fighting the scanner for the lock on every file.
+  std::vector<Entry> batch;
+  for (;;)
+  {
+    u32 finished;
+    {
+      std::unique_lock lock(results_mutex);
+      results_cv.wait_for(lock, std::chrono::milliseconds(SCAN_MERGE_INTERVAL_MS),
+                          [&results, &num_finished, num_files]() {
+                            return (results.size() >= SCAN_MERGE_BATCH_SIZE || num_finished == num_files);
+                          });
+      batch.swap(results);
+      finished = num_finished;
+    }
+
+    MergeScannedEntries(batch, played_time_map, progress);
+    progress->SetProgressValue(finished);
+
+    if (finished == num_files)
+      break;
+
+    if (progress->IsCancelled())
+    {
+      cancelled.store(true, std::memory_order_relaxed);
+      break;
+    }
+  }
+
+  for (Threading::Thread& thread : threads)
+    thread.Join();
+
+  // files which were in-flight when the scan was cancelled are still worth keeping
+  MergeScannedEntries(results, played_time_map, progress);
+
+  progress->PopState();
+}
+
+void GameList::MergeScannedEntries(std::vector<Entry>& entries, const PlayedTimeMap& played_time_map,
+                                   ProgressCallback* progress)
+{
+  if (entries.empty())
+    return;
+
+  // cache stream is only touched by the calling thread
   if (s_cache_write_stream || OpenCacheForWriting())
   {
-    if (!WriteEntryToCache(&entry))
-      Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    for (const Entry& entry : entries)
+    {
+      if (!WriteEntryToCache(&entry))
+        Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    }
   }
 
+  progress->SetFormattedStatusText("Scanning '%s'...",
+                                   FileSystem::GetDisplayNameFromPath(entries.back().path).c_str());
+
+  std::unique_lock lock(s_mutex);
+  for (Entry& entry : entries)
+    AddEntry(std::move(entry), played_time_map);
+  entries.clear();
+}
+
+std::string GameList::GetIndexKey(std::string_view str)
+{
+  // matches the case-insensitivity of the old linear searches
+  std::string ret;
+  ret.reserve(str.length());
+  for (const char ch : str)
+    ret.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
+  return ret;
+}
+
+void GameList::AddEntry(Entry entry, const PlayedTimeMap& played_time_map)
+{
   auto iter = played_time_map.find(entry.serial);
   if (iter != played_time_map.end())
   {
@@ -574,9 +705,20 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
     entry.total_played_time = iter->second.total_played_time;
   }
 
-  lock.lock();
+  // first entry wins, same as the linear search did
+  const u32 index = static_cast<u32>(s_entries.size());
+  s_path_index.emplace(GetIndexKey(entry.path), index);
+  s_serial_index[GetIndexKey(entry.serial)].push_back(index);
+
   s_entries.push_back(std::move(entry));
-  return true;
+}
+
+void GameList::ClearEntries(std::vector<Entry>* old_entries)
+{
+  old_entries->swap(s_entries);
+  s_entries.clear();
+  s_path_index.clear();
+  s_serial_index.clear();
 }
 
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
@@ -591,34 +733,25 @@ const GameList::Entry* GameList::GetEntryByIndex(u32 index)
 
 const GameList::Entry* GameList::GetEntryForPath(const char* path)
 {
-  const size_t path_length = std::strlen(path);
-  for (const Entry& entry : s_entries)
-  {
-    if (entry.path.size() == path_length && StringUtil::Strcasecmp(entry.path.c_str(), path) == 0)
-      return &entry;
-  }
-
-  return nullptr;
+  const auto iter = s_path_index.find(GetIndexKey(path));
+  return (iter != s_path_index.end()) ? &s_entries[iter->second] : nullptr;
 }
 
 const GameList::Entry* GameList::GetEntryBySerial(std::string_view serial)
 {
-  for (const Entry& entry : s_entries)
-  {
-    if (entry.serial.length() == serial.length() &&
-        StringUtil::Strncasecmp(entry.serial.c_str(), serial.data(), serial.length()) == 0)
-    {
-      return &entry;
-    }
-  }
-
-  return nullptr;
+  const auto iter = s_serial_index.find(GetIndexKey(serial));
+  return (iter != s_serial_index.end()) ? &s_entries[iter->second.front()] : nullptr;
 }
 
 const GameList::Entry* GameList::GetEntryBySerialAndHash(std::string_view serial, u64 hash)
 {
-  for (const Entry& entry : s_entries)
+  const auto iter = s_serial_index.find(GetIndexKey(serial));
+  if (iter == s_serial_index.end())
+    return nullptr;
+
+  for (const u32 index : iter->second)
   {
+    const Entry& entry = s_entries[index];
     if (entry.serial == serial && entry.hash == hash)
       return &entry;
   }
@@ -660,7 +793,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
   std::vector<Entry> old_entries;
   {
     std::unique_lock lock(s_mutex);
-    old_entries.swap(s_entries);
+    ClearEntries(&old_entries);
   }
 
   const std::vector<std::string> excluded_paths(Host::GetBaseStringListSetting("GameList", "ExcludedPaths"));
@@ -677,6 +810,10 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
     progress->SetProgressRange(static_cast<u32>(dirs.size() + recursive_dirs.size()));
     progress->SetProgressValue(0);
 
+    // find everything first, so the uncached files from all directories can be spread across the scan threads
+    std::vector<ScanFileInfo> scan_files;
+    PreferUnorderedStringSet scan_keys;
+
     // we manually count it here, because otherwise pop state updates it itself
     int directory_counter = 0;
     for (const std::string& dir : dirs)
@@ -684,7 +821,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
       if (progress->IsCancelled())
         break;
 
-      ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, progress);
+      ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, &scan_files, &scan_keys, progress);
       progress->SetProgressValue(++directory_counter);
     }
     for (const std::string& dir : recursive_dirs)
@@ -692,9 +829,12 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
       if (progress->IsCancelled())
         break;
 
-      ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, progress);
+      ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, &scan_files, &scan_keys, progress);
       progress->SetProgressValue(++directory_counter);
     }
+
+    if (!scan_files.empty() && !progress->IsCancelled())
+      ScanFiles(std::move(scan_files), played_time, progress);
   }
 
   // don't need unused cache entries
@@ -957,8 +1097,13 @@ void GameList::AddPlayedTimeForSerial(const std::string& serial, std::time_t las
                     static_cast<unsigned>(pt.total_played_time));
 
   std::unique_lock<std::recursive_mutex> lock(s_mutex);
-  for (GameList::Entry& entry : s_entries)
+  const auto iter = s_serial_index.find(GetIndexKey(serial));
+  if (iter == s_serial_index.end())
+    return;
+
+  for (const u32 index : iter->second)
   {
+    GameList::Entry& entry = s_entries[index];
     if (entry.serial != serial)
       continue;
 
@@ -975,8 +1120,13 @@ void GameList::ClearPlayedTimeForSerial(const std::string& serial)
   UpdatePlayedTimeFile(GetPlayedTimeFile(), serial, 0, 0);
 
   std::unique_lock<std::recursive_mutex> lock(s_mutex);
-  for (GameList::Entry& entry : s_entries)
+  const auto iter = s_serial_index.find(GetIndexKey(serial));
+  if (iter == s_serial_index.end())
+    return;
+
+  for (const u32 index : iter->second)
   {
+    GameList::Entry& entry = s_entries[index];
     if (entry.serial != serial)
       continue;
 
@@ -991,8 +1141,13 @@ std::time_t GameList::GetCachedPlayedTimeForSerial(const std::string& serial)
     return 0;
 
   std::unique_lock<std::recursive_mutex> lock(s_mutex);
-  for (GameList::Entry& entry : s_entries)
+  const auto iter = s_serial_index.find(GetIndexKey(serial));
+  if (iter == s_serial_index.end())
+    return 0;
+
+  for (const u32 index : iter->second)
   {
+    const GameList::Entry& entry = s_entries[index];
     if (entry.serial == serial)
       return entry.total_played_time;
   }
@@ -1080,11 +1235,16 @@ GameList::GetMatchingEntriesForSerial(const std::span<const std::string> serials
 
   for (const std::string& serial : serials)
   {
+    const auto iter = s_serial_index.find(GetIndexKey(serial));
+    if (iter == s_serial_index.end())
+      continue;
+
     const Entry* matching_entry = nullptr;
     bool has_multiple_entries = false;
 
-    for (const Entry& entry : s_entries)
+    for (const u32 index : iter->second)
     {
+      const Entry& entry = s_entries[index];
       if (entry.serial != serial)
         continue;
 
@@ -1104,8 +1264,9 @@ GameList::GetMatchingEntriesForSerial(const std::span<const std::string> serials
     }
 
     // Have to add all matching files.
-    for (const Entry& entry : s_entries)
+    for (const u32 index : iter->second)
     {
+      const Entry& entry = s_entries[index];
       if (entry.serial != serial)
         continue;
 
@@ -7,6 +7,7 @@
 #include "host.h"
 #include "imgui.h"
 #include "interrupt_controller.h"
+#include "perf_sections.h"
 #include "settings.h"
 #include "system.h"
 #include "timers.h"
@@ -28,6 +29,7 @@
 
 #include "IconsFontAwesome5.h"
 #include "fmt/format.h"
+#include "xxhash.h"
 
 #include <cmath>
 #include <thread>
@@ -76,6 +78,7 @@ bool GPU::Initialize()
     [](void* param, TickCount ticks, TickCount ticks_late) { static_cast<GPU*>(param)->CommandTickEvent(ticks); }, this,
     true);
   m_fifo_size = g_settings.gpu_fifo_size;
+  m_fifo_track_addresses = g_settings.gpu_pgxp_enable;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
   m_console_is_pal = System::IsPALRegion();
   UpdateCRTCConfig();
@@ -97,6 +100,12 @@ void GPU::UpdateSettings(const Settings& old_settings)
 
   m_force_progressive_scan = g_settings.gpu_disable_interlacing;
   m_fifo_size = g_settings.gpu_fifo_size;
+  if (m_fifo_track_addresses != g_settings.gpu_pgxp_enable)
+  {
+    // Words queued while tracking was off have no address, so don't leave stale ones behind for them.
+    m_fifo_track_addresses = g_settings.gpu_pgxp_enable;
+    m_fifo_addresses.fill(0);
+  }
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
 
   if (m_force_ntsc_timings != g_settings.gpu_force_ntsc_timings || m_console_is_pal != System::IsPALRegion())
@@ -301,7 +310,29 @@ bool GPU::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_displ
   sw.Do(&m_vram_transfer.col);
   sw.Do(&m_vram_transfer.row);
 
-  sw.Do(&m_fifo);
+  // FIFO entries are serialized with their source address in the upper 32 bits, as they were when it held u64s.
+  u32 fifo_size = m_fifo.GetSize();
+  sw.Do(&fifo_size);
+  if (sw.IsReading())
+  {
+    m_fifo.Clear();
+    for (u32 i = 0; i < fifo_size; i++)
+    {
+      u64 entry = 0;
+      sw.Do(&entry);
+      m_fifo_addresses[GetFifoTailIndex()] = Truncate32(entry >> 32);
+      m_fifo.Push(Truncate32(entry));
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < fifo_size; i++)
+    {
+      u64 entry = ZeroExtend64(FifoPeek(i)) | (m_fifo_track_addresses ? (ZeroExtend64(FifoPeekAddress(i)) << 32) : 0);
+      sw.Do(&entry);
+    }
+  }
+
   sw.Do(&m_blit_buffer);
   sw.Do(&m_blit_remaining_words);
   sw.Do(&m_render_command.bits);
@@ -465,6 +496,8 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
+      if (m_fifo_track_addresses)
+        m_fifo_addresses[GetFifoTailIndex()] = 0;
       m_fifo.Push(value);
       ExecuteCommands();
       return;
@@ -481,6 +514,8 @@ void GPU::WriteRegister(u32 offset, u32 value)
 
 void GPU::DMARead(u32* words, u32 word_count)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::GPU);
+
   if (m_GPUSTAT.dma_direction != DMADirection::GPUREADtoCPU)
   {
     Log_ErrorPrintf("Invalid DMA direction from GPU DMA read");
@@ -492,6 +527,24 @@ void GPU::DMARead(u32* words, u32 word_count)
     words[i] = ReadGPUREAD();
 }
 
+void GPU::DMAWriteBlock(u32 address, const u32* words, u32 word_count)
+{
+  PerfSections::Scope perf_scope(PerfSections::Section::GPU);
+
+  if (m_fifo_track_addresses)
+  {
+    u32 index = GetFifoTailIndex();
+    for (u32 i = 0; i < word_count; i++)
+    {
+      m_fifo_addresses[index] = address;
+      index = (index + 1) % MAX_FIFO_SIZE;
+      address += sizeof(u32);
+    }
+  }
+
+  m_fifo.PushRange(words, word_count);
+}
+
 void GPU::EndDMAWrite()
 {
   ExecuteCommands();
@@ -893,6 +946,8 @@ bool GPU::IsCommandCompletionPending() const
 
 void GPU::CRTCTickEvent(TickCount ticks)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::GPU);
+
   // convert cpu/master clock to GPU ticks, accounting for partial cycles because of the non-integer divider
   {
     const TickCount gpu_ticks = SystemTicksToCRTCTicks(ticks, &m_crtc_state.fractional_ticks);
@@ -2489,6 +2544,23 @@ bool GPU::RenderScreenshotToBuffer(u32 width, u32 height, const Common::Rectangl
   return true;
 }
 
+bool GPU::ReadDisplayToBuffer(u32* out_width, u32* out_height, std::vector<u32>* out_pixels, u32* out_stride,
+                              GPUTexture::Format* out_format)
+{
+  if (!m_display_texture || m_display_texture_view_width <= 0 || m_display_texture_view_height <= 0)
+    return false;
+
+  const u32 width = static_cast<u32>(m_display_texture_view_width);
+  const u32 height = static_cast<u32>(m_display_texture_view_height);
+  const Common::Rectangle<s32> draw_rect(0, 0, static_cast<s32>(width), static_cast<s32>(height));
+  if (!RenderScreenshotToBuffer(width, height, draw_rect, false, out_pixels, out_stride, out_format))
+    return false;
+
+  *out_width = width;
+  *out_height = height;
+  return true;
+}
+
 bool GPU::RenderScreenshotToFile(std::string filename, DisplayScreenshotMode mode, u8 quality, bool compress_on_thread,
                                  bool show_osd_message)
 {
@@ -2594,6 +2666,39 @@ bool GPU::DumpVRAMToFile(const char* filename)
   }
 }
 
+std::array<u64, 2> GPU::HashDisplayedVRAM()
+{
+  if (IsDisplayDisabled())
+    return {};
+
+  // 24-bit modes start at the X register, and are packed at 3 bytes per pixel.
+  const bool is_24bit = m_GPUSTAT.display_area_color_depth_24;
+  const u32 vram_x = is_24bit ? m_crtc_state.regs.X : m_crtc_state.display_vram_left;
+  const u32 vram_y = m_crtc_state.display_vram_top;
+  const u32 skip_bytes = is_24bit ? ((m_crtc_state.display_vram_left - m_crtc_state.regs.X) * 3) : 0;
+  static constexpr u32 VRAM_ROW_BYTES = VRAM_WIDTH * sizeof(u16);
+  const u32 row_bytes = std::min<u32>(m_crtc_state.display_vram_width * (is_24bit ? 3 : 2), VRAM_ROW_BYTES);
+  const u32 height = m_crtc_state.display_vram_height;
+  ReadVRAM(vram_x, vram_y, std::min<u32>((skip_bytes + row_bytes + 1) / 2, VRAM_WIDTH), height);
+
+  const u32 start_offset = ((vram_x * sizeof(u16)) + skip_bytes) % VRAM_ROW_BYTES;
+  const u32 first_part = std::min(row_bytes, VRAM_ROW_BYTES - start_offset);
+
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  for (u32 row = 0; row < height; row++)
+  {
+    // wrap around both axes like the scanout does
+    const u8* row_ptr = reinterpret_cast<const u8*>(&g_vram[((vram_y + row) % VRAM_HEIGHT) * VRAM_WIDTH]);
+    XXH3_128bits_update(&state, row_ptr + start_offset, first_part);
+    if (first_part < row_bytes)
+      XXH3_128bits_update(&state, row_ptr, row_bytes - first_part);
+  }
+
+  const XXH128_hash_t hash = XXH3_128bits_digest(&state);
+  return {hash.high64, hash.low64};
+}
+
 bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride, const void* buffer, bool remove_alpha)
 {
   RGBA8Image image(width, height);
@@ -2736,7 +2841,9 @@ void GPU::UpdateStatistics(u32 frame_count)
   UPDATE_COUNTER(num_vertices);
   UPDATE_COUNTER(num_primitives);
 
-  // UPDATE_COUNTER(num_read_texture_updates);
+  UPDATE_COUNTER(num_read_texture_updates);
+  UPDATE_COUNTER(num_read_texture_pixels_copied);
+  UPDATE_COUNTER(num_read_texture_pixels_skipped);
   // UPDATE_COUNTER(num_ubo_updates);
 
   UPDATE_GPU_STAT(buffer_streamed);
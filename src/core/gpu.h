@@ -58,6 +58,7 @@ public:
   enum : u32
   {
     MAX_FIFO_SIZE = 4096,
+    MAX_FIFO_SPAN_SIZE = 16,
     DOT_TIMER_INDEX = 0,
     HBLANK_TIMER_INDEX = 1,
     MAX_RESOLUTION_SCALE = 32,
@@ -120,8 +121,11 @@ public:
   ALWAYS_INLINE bool BeginDMAWrite() const { return (m_GPUSTAT.dma_direction == DMADirection::CPUtoGP0); }
   ALWAYS_INLINE void DMAWrite(u32 address, u32 value)
   {
-    m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
+    if (m_fifo_track_addresses)
+      m_fifo_addresses[GetFifoTailIndex()] = address;
+    m_fifo.Push(value);
   }
+  void DMAWriteBlock(u32 address, const u32* words, u32 word_count);
   void EndDMAWrite();
 
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
@@ -189,6 +193,10 @@ public:
   // Dumps raw VRAM to a file.
   bool DumpVRAMToFile(const char* filename);
 
+  /// Returns a 128-bit hash of the VRAM area being scanned out, for regression testing. Cheaper than dumping the
+  /// display texture, and independent of the renderer's output format. Zero if the display is disabled.
+  std::array<u64, 2> HashDisplayedVRAM();
+
   // Ensures all buffered vertices are drawn.
   virtual void FlushRender();
 
@@ -208,6 +216,10 @@ public:
   bool RenderScreenshotToBuffer(u32 width, u32 height, const Common::Rectangle<s32>& draw_rect, bool postfx,
                                 std::vector<u32>* out_pixels, u32* out_stride, GPUTexture::Format* out_format);
 
+  /// Reads back the display texture at its native size, without post-processing or aspect ratio correction.
+  bool ReadDisplayToBuffer(u32* out_width, u32* out_height, std::vector<u32>* out_pixels, u32* out_stride,
+                           GPUTexture::Format* out_format);
+
   /// Helper function to save screenshot to PNG.
   bool RenderScreenshotToFile(std::string filename, DisplayScreenshotMode mode, u8 quality, bool compress_on_thread,
                               bool show_osd_message);
@@ -555,17 +567,31 @@ protected:
     u16 row;
   } m_vram_transfer = {};
 
-  HeapFIFOQueue<u64, MAX_FIFO_SIZE> m_fifo;
+  HeapFIFOQueue<u32, MAX_FIFO_SIZE> m_fifo;
   std::vector<u32> m_blit_buffer;
   u32 m_blit_remaining_words;
   GPURenderCommand m_render_command{};
 
-  ALWAYS_INLINE u32 FifoPop() { return Truncate32(m_fifo.Pop()); }
-  ALWAYS_INLINE u32 FifoPeek() { return Truncate32(m_fifo.Peek()); }
-  ALWAYS_INLINE u32 FifoPeek(u32 i) { return Truncate32(m_fifo.Peek(i)); }
+  // RAM address each FIFO slot was DMA'ed from, indexed by ring position. Only maintained when PGXP is enabled.
+  std::array<u32, MAX_FIFO_SIZE> m_fifo_addresses{};
+  std::array<u32, MAX_FIFO_SPAN_SIZE> m_fifo_span_buffer{};
+
+  ALWAYS_INLINE u32 FifoPop() { return m_fifo.Pop(); }
+  ALWAYS_INLINE u32 FifoPeek() { return m_fifo.Peek(); }
+  ALWAYS_INLINE u32 FifoPeek(u32 i) { return m_fifo.Peek(i); }
+  ALWAYS_INLINE u32 FifoPeekAddress(u32 i) const { return m_fifo_addresses[(GetFifoHeadIndex() + i) % MAX_FIFO_SIZE]; }
+  ALWAYS_INLINE u32 GetFifoHeadIndex() const
+  {
+    return static_cast<u32>(m_fifo.GetReadPointer() - m_fifo.GetDataPointer());
+  }
+  ALWAYS_INLINE u32 GetFifoTailIndex() { return static_cast<u32>(m_fifo.GetWritePointer() - m_fifo.GetDataPointer()); }
+
+  /// Returns the next count words in the FIFO as a contiguous span, without removing them.
+  const u32* FifoPeekSpan(u32 count);
 
   TickCount m_max_run_ahead = 128;
   u32 m_fifo_size = 128;
+  bool m_fifo_track_addresses = false;
 
   void ClearDisplayTexture();
   void SetDisplayTexture(GPUTexture* texture, s32 view_x, s32 view_y, s32 view_width, s32 view_height);
@@ -617,7 +643,9 @@ protected:
     u32 num_vertices;
     u32 num_primitives;
 
-    // u32 num_read_texture_updates;
+    u32 num_read_texture_updates;
+    u64 num_read_texture_pixels_copied;
+    u64 num_read_texture_pixels_skipped;
     // u32 num_ubo_updates;
   };
 
@@ -7,6 +7,8 @@
 #include "common/timer.h"
 #include "settings.h"
 #include "util/state_wrapper.h"
+#include <algorithm>
+#include <utility>
 Log_SetChannel(GPUBackend);
 
 std::unique_ptr<GPUBackend> g_gpu_backend;
@@ -17,6 +19,8 @@ GPUBackend::~GPUBackend() = default;
 
 bool GPUBackend::Initialize(bool force_thread)
 {
+  m_wake_threshold = g_settings.gpu_thread_wake_threshold;
+
   if (force_thread || g_settings.gpu_use_thread)
     StartGPUThread();
 
@@ -33,6 +37,8 @@ void GPUBackend::UpdateSettings()
 {
   Sync(true);
 
+  m_wake_threshold = g_settings.gpu_thread_wake_threshold;
+
   if (m_use_gpu_thread != g_settings.gpu_use_thread)
   {
     if (!g_settings.gpu_use_thread)
@@ -109,11 +115,16 @@ void* GPUBackend::AllocateCommand(GPUBackendCommandType command, u32 size)
     if (read_ptr > write_ptr)
     {
       u32 available_size = read_ptr - write_ptr;
-      while (available_size < (size + sizeof(GPUBackendCommandType)))
+      if (available_size < (size + sizeof(GPUBackendCommandType)))
       {
-        WakeGPUThread();
-        read_ptr = m_command_fifo_read_ptr.load();
-        available_size = (read_ptr > write_ptr) ? (read_ptr - write_ptr) : (COMMAND_QUEUE_SIZE - write_ptr);
+        // FIFO is full, make sure the GPU thread is draining it. Waking is a no-op if it's already running.
+        m_producer_stalls++;
+        do
+        {
+          WakeGPUThread();
+          read_ptr = m_command_fifo_read_ptr.load();
+          available_size = (read_ptr > write_ptr) ? (read_ptr - write_ptr) : (COMMAND_QUEUE_SIZE - write_ptr);
+        } while (available_size < (size + sizeof(GPUBackendCommandType)));
       }
     }
     else
@@ -158,18 +169,30 @@ void GPUBackend::PushCommand(GPUBackendCommand* cmd)
     const u32 new_write_ptr = m_command_fifo_write_ptr.fetch_add(cmd->size) + cmd->size;
     DebugAssert(new_write_ptr <= COMMAND_QUEUE_SIZE);
     UNREFERENCED_VARIABLE(new_write_ptr);
-    if (GetPendingCommandSize() >= THRESHOLD_TO_WAKE_GPU)
+    if (GetPendingCommandSize() >= m_wake_threshold)
       WakeGPUThread();
   }
 }
 
+GPUBackend::Counters GPUBackend::GetAndResetCounters()
+{
+  Counters ret;
+  ret.producer_stalls = std::exchange(m_producer_stalls, 0);
+  ret.consumer_parks = m_consumer_parks.exchange(0, std::memory_order_relaxed);
+  ret.wakeups = std::exchange(m_wakeups, 0);
+  return ret;
+}
+
 void GPUBackend::WakeGPUThread()
 {
-  std::unique_lock<std::mutex> lock(m_sync_mutex);
-  if (!m_gpu_thread_sleeping.load())
+  // Whoever clears the sleeping flag owns the wakeup, so the semaphore is posted exactly once per park.
+  // The check has to be sequentially consistent with the write pointer update, otherwise we can miss the GPU thread
+  // going to sleep at the same time as it misses the new command.
+  if (!m_gpu_thread_sleeping.load() || !m_gpu_thread_sleeping.exchange(false))
     return;
 
-  m_wake_gpu_thread_cv.notify_one();
+  m_wakeups++;
+  m_wake_gpu_thread_semaphore.Post();
 }
 
 void GPUBackend::StartGPUThread()
@@ -195,7 +218,10 @@ void GPUBackend::StopGPUThread()
 void GPUBackend::Sync(bool allow_sleep)
 {
   if (!m_use_gpu_thread)
+  {
+    FlushRender();
     return;
+  }
 
   GPUBackendSyncCommand* cmd =
     static_cast<GPUBackendSyncCommand*>(AllocateCommand(GPUBackendCommandType::Sync, sizeof(GPUBackendSyncCommand)));
@@ -208,7 +234,11 @@ void GPUBackend::Sync(bool allow_sleep)
 
 void GPUBackend::RunGPULoop()
 {
-  static constexpr double SPIN_TIME_NS = 1 * 1000000;
+  // The spin window adapts: it grows when commands show up while spinning, and shrinks when we end up parking anyway.
+  static constexpr double MIN_SPIN_TIME_NS = 50 * 1000;
+  static constexpr double MAX_SPIN_TIME_NS = 1 * 1000000;
+  double spin_time_ns = MAX_SPIN_TIME_NS;
+  bool spinning = false;
   Common::Timer::Value last_command_time = 0;
 
   for (;;)
@@ -218,13 +248,29 @@ void GPUBackend::RunGPULoop()
     if (read_ptr == write_ptr)
     {
       const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
-      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < SPIN_TIME_NS)
+      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < spin_time_ns)
+      {
+        spinning = true;
         continue;
+      }
 
-      std::unique_lock<std::mutex> lock(m_sync_mutex);
+      if (spinning)
+        spin_time_ns = std::max(spin_time_ns * 0.5, MIN_SPIN_TIME_NS);
+      spinning = false;
+
+      // Publish the flag before re-checking the FIFO, so either we see the new command or the CPU thread sees us.
       m_gpu_thread_sleeping.store(true);
-      m_wake_gpu_thread_cv.wait(lock, [this]() { return m_gpu_loop_done.load() || GetPendingCommandSize() > 0; });
-      m_gpu_thread_sleeping.store(false);
+      if (m_gpu_loop_done.load() || GetPendingCommandSize() > 0)
+      {
+        // If the CPU thread cleared the flag first, it has posted the semaphore and we need to consume it.
+        if (!m_gpu_thread_sleeping.exchange(false))
+          m_wake_gpu_thread_semaphore.Wait();
+      }
+      else
+      {
+        m_consumer_parks.fetch_add(1, std::memory_order_relaxed);
+        m_wake_gpu_thread_semaphore.Wait();
+      }
 
       if (m_gpu_loop_done.load())
         break;
@@ -232,6 +278,12 @@ void GPUBackend::RunGPULoop()
         continue;
     }
 
+    if (spinning)
+    {
+      spin_time_ns = std::min(spin_time_ns * 2.0, MAX_SPIN_TIME_NS);
+      spinning = false;
+    }
+
     if (write_ptr < read_ptr)
       write_ptr = COMMAND_QUEUE_SIZE;
 
@@ -254,6 +306,7 @@ void GPUBackend::RunGPULoop()
         case GPUBackendCommandType::Sync:
         {
           DebugAssert(read_ptr == write_ptr);
+          FlushRender();
           m_sync_semaphore.Post();
           allow_sleep = static_cast<const GPUBackendSyncCommand*>(cmd)->allow_sleep;
         }
@@ -6,10 +6,7 @@
 #include "common/threading.h"
 #include "gpu_types.h"
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <thread>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -40,6 +37,16 @@ public:
   void PushCommand(GPUBackendCommand* cmd);
   void Sync(bool allow_sleep);
 
+  struct Counters
+  {
+    u32 producer_stalls; // CPU thread waited for space in the command FIFO.
+    u32 consumer_parks;  // GPU thread ran out of commands and went to sleep.
+    u32 wakeups;         // CPU thread had to signal the sleeping GPU thread.
+  };
+
+  /// Returns the FIFO counters accumulated since the last call, and resets them.
+  Counters GetAndResetCounters();
+
   /// Processes all pending GPU commands.
   void RunGPULoop();
 
@@ -66,22 +73,24 @@ protected:
   Common::Rectangle<u32> m_drawing_area{};
 
   Threading::KernelSemaphore m_sync_semaphore;
+  Threading::KernelSemaphore m_wake_gpu_thread_semaphore;
   std::atomic_bool m_gpu_thread_sleeping{false};
   std::atomic_bool m_gpu_loop_done{false};
   Threading::Thread m_gpu_thread;
   bool m_use_gpu_thread = false;
 
-  std::mutex m_sync_mutex;
-  std::condition_variable m_sync_cpu_thread_cv;
-  std::condition_variable m_wake_gpu_thread_cv;
-  bool m_sync_done = false;
-
   enum : u32
   {
     COMMAND_QUEUE_SIZE = 4 * 1024 * 1024,
-    THRESHOLD_TO_WAKE_GPU = 256
   };
 
+  // Pending bytes before the CPU thread wakes a sleeping GPU thread, so wakeups are batched.
+  u32 m_wake_threshold = 0;
+
+  u32 m_producer_stalls = 0;
+  u32 m_wakeups = 0;
+  std::atomic<u32> m_consumer_parks{0};
+
   FixedHeapArray<u8, COMMAND_QUEUE_SIZE> m_command_fifo_data;
   alignas(HOST_CACHE_LINE_SIZE) std::atomic<u32> m_command_fifo_read_ptr{0};
   alignas(HOST_CACHE_LINE_SIZE) std::atomic<u32> m_command_fifo_write_ptr{0};
@@ -6,6 +6,7 @@
 #include "common/string_util.h"
 #include "gpu.h"
 #include "interrupt_controller.h"
+#include "perf_sections.h"
 #include "system.h"
 #include "texture_replacements.h"
 
@@ -28,6 +29,18 @@ static constexpr u32 ReplaceZero(u32 value, u32 value_for_zero)
   return value == 0 ? value_for_zero : value;
 }
 
+const u32* GPU::FifoPeekSpan(u32 count)
+{
+  DebugAssert(count <= m_fifo.GetSize() && count <= MAX_FIFO_SPAN_SIZE);
+  if (m_fifo.GetContiguousSize() >= count) [[likely]]
+    return m_fifo.GetReadPointer();
+
+  // wraps around the end of the ring, so linearize it
+  for (u32 i = 0; i < count; i++)
+    m_fifo_span_buffer[i] = FifoPeek(i);
+  return m_fifo_span_buffer.data();
+}
+
 void GPU::TryExecuteCommands()
 {
   while (m_pending_command_ticks <= m_max_run_ahead && !m_fifo.IsEmpty())
@@ -47,9 +60,9 @@ void GPU::TryExecuteCommands()
       {
         DebugAssert(m_blit_remaining_words > 0);
         const u32 words_to_copy = std::min(m_blit_remaining_words, m_fifo.GetSize());
-        m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-        for (u32 i = 0; i < words_to_copy; i++)
-          m_blit_buffer.push_back(FifoPop());
+        const size_t blit_buffer_pos = m_blit_buffer.size();
+        m_blit_buffer.resize(blit_buffer_pos + words_to_copy);
+        m_fifo.PopRange(m_blit_buffer.data() + blit_buffer_pos, words_to_copy);
         m_blit_remaining_words -= words_to_copy;
 
         Log_DebugPrintf("VRAM write burst of %u words, %u words remaining", words_to_copy, m_blit_remaining_words);
@@ -82,9 +95,9 @@ void GPU::TryExecuteCommands()
         const u32 words_to_copy = std::min(terminator_index, m_fifo.GetSize());
         if (words_to_copy > 0)
         {
-          m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-          for (u32 i = 0; i < words_to_copy; i++)
-            m_blit_buffer.push_back(FifoPop());
+          const size_t blit_buffer_pos = m_blit_buffer.size();
+          m_blit_buffer.resize(blit_buffer_pos + words_to_copy);
+          m_fifo.PopRange(m_blit_buffer.data() + blit_buffer_pos, words_to_copy);
         }
 
         Log_DebugPrintf("Added %u words to polyline", words_to_copy);
@@ -106,6 +119,8 @@ void GPU::TryExecuteCommands()
 
 void GPU::ExecuteCommands()
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::GPU);
+
   const bool was_executing_from_event = std::exchange(m_executing_commands, true);
 
   TryExecuteCommands();
@@ -436,11 +451,8 @@ bool GPU::HandleRenderPolyLineCommand()
   m_fifo.RemoveOne();
 
   const u32 words_to_pop = min_words - 1;
-  // m_blit_buffer.resize(words_to_pop);
-  // FifoPopRange(m_blit_buffer.data(), words_to_pop);
-  m_blit_buffer.reserve(words_to_pop);
-  for (u32 i = 0; i < words_to_pop; i++)
-    m_blit_buffer.push_back(Truncate32(FifoPop()));
+  m_blit_buffer.resize(words_to_pop);
+  m_fifo.PopRange(m_blit_buffer.data(), words_to_pop);
 
   // polyline goes via a different path through the blit buffer
   m_blitter_state = BlitterState::DrawingPolyLine;
@@ -15,6 +15,7 @@
 
 #include "common/align.h"
 #include "common/assert.h"
+#include "common/bitutils.h"
 #include "common/log.h"
 #include "common/scoped_guard.h"
 #include "common/string_util.h"
@@ -580,16 +581,44 @@ bool GPU_HW::IsUsingDownsampling() const
   return (m_downsample_mode != GPUDownsampleMode::Disabled && !m_GPUSTAT.display_area_color_depth_24);
 }
 
+ALWAYS_INLINE_RELEASE u32 GPU_HW::GetVRAMPageMask(const Common::Rectangle<u32>& rect)
+{
+  const u32 right = std::min<u32>(rect.right, VRAM_WIDTH);
+  const u32 bottom = std::min<u32>(rect.bottom, VRAM_HEIGHT);
+  if (rect.left >= right || rect.top >= bottom)
+    return 0;
+
+  const u32 first_x = rect.left / VRAM_PAGE_WIDTH;
+  const u32 last_x = (right - 1) / VRAM_PAGE_WIDTH;
+  const u32 row_mask = ((2u << last_x) - 1u) & ~((1u << first_x) - 1u);
+
+  u32 mask = 0;
+  for (u32 y = rect.top / VRAM_PAGE_HEIGHT; y <= (bottom - 1) / VRAM_PAGE_HEIGHT; y++)
+    mask |= row_mask << (y * VRAM_PAGES_WIDE);
+
+  return mask;
+}
+
+ALWAYS_INLINE_RELEASE Common::Rectangle<u32> GPU_HW::GetVRAMPageRectangle(u32 page)
+{
+  return Common::Rectangle<u32>::FromExtents((page % VRAM_PAGES_WIDE) * VRAM_PAGE_WIDTH,
+                                             (page / VRAM_PAGES_WIDE) * VRAM_PAGE_HEIGHT, VRAM_PAGE_WIDTH,
+                                             VRAM_PAGE_HEIGHT);
+}
+
 void GPU_HW::SetFullVRAMDirtyRectangle()
 {
-  m_vram_dirty_draw_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  for (u32 i = 0; i < NUM_VRAM_PAGES; i++)
+    m_vram_dirty_page_rects[i] = GetVRAMPageRectangle(i);
+  m_vram_dirty_pages = static_cast<u32>((UINT64_C(1) << NUM_VRAM_PAGES) - 1);
   m_draw_mode.SetTexturePageChanged();
 }
 
 void GPU_HW::ClearVRAMDirtyRectangle()
 {
-  m_vram_dirty_draw_rect.SetInvalid();
-  m_vram_dirty_write_rect.SetInvalid();
+  for (Common::Rectangle<u32>& rect : m_vram_dirty_page_rects)
+    rect.SetInvalid();
+  m_vram_dirty_pages = 0;
 }
 
 std::tuple<u32, u32> GPU_HW::GetEffectiveDisplayResolution(bool scaled /* = true */)
@@ -1327,32 +1356,37 @@ GPU_HW::BatchRenderMode GPU_HW::BatchConfig::GetRenderMode() const
                                                               BatchRenderMode::TransparentAndOpaque;
 }
 
-void GPU_HW::UpdateVRAMReadTexture(bool drawn, bool written)
+void GPU_HW::UpdateVRAMReadTexture(const Common::Rectangle<u32>& rect)
 {
-  GL_SCOPE("UpdateVRAMReadTexture()");
+  GL_SCOPE_FMT("UpdateVRAMReadTexture({},{} => {},{})", rect.left, rect.top, rect.right, rect.bottom);
 
-  const auto update = [this](Common::Rectangle<u32>& rect, u8 dbit) {
-    if (m_texpage_dirty & dbit)
-    {
-      m_texpage_dirty &= ~dbit;
-      if (!m_texpage_dirty)
-        GL_INS_FMT("{} texpage is no longer dirty", (dbit & TEXPAGE_DIRTY_DRAWN_RECT) ? "DRAW" : "WRITE");
-    }
+  // Only pages which overlap the area being sampled are copied, the rest wait until they're needed.
+  u32 update_pages = 0;
+  u32 update_area = 0;
+  Common::Rectangle<u32> update_rect;
+  Common::Rectangle<u32> dirty_bounds;
+  for (u32 mask = m_vram_dirty_pages; mask != 0; mask &= (mask - 1))
+  {
+    const u32 page = CountTrailingZeros(mask);
+    const Common::Rectangle<u32>& page_rect = m_vram_dirty_page_rects[page];
+    dirty_bounds.Include(page_rect);
+    if (!page_rect.Intersects(rect))
+      continue;
+
+    update_pages |= (1u << page);
+    update_area += page_rect.GetWidth() * page_rect.GetHeight();
+    update_rect.Include(page_rect);
+  }
+  if (update_pages == 0)
+    return;
 
-    const auto scaled_rect = rect * m_resolution_scale;
+  const auto copy = [this](const Common::Rectangle<u32>& copy_rect) {
+    const auto scaled_rect = copy_rect * m_resolution_scale;
     if (m_vram_texture->IsMultisampled())
     {
-      if (g_gpu_device->GetFeatures().partial_msaa_resolve)
-      {
-        g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), scaled_rect.left, scaled_rect.top, 0, 0,
-                                           m_vram_texture.get(), scaled_rect.left, scaled_rect.top,
-                                           scaled_rect.GetWidth(), scaled_rect.GetHeight());
-      }
-      else
-      {
-        g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), 0, 0, 0, 0, m_vram_texture.get(), 0, 0,
-                                           m_vram_texture->GetWidth(), m_vram_texture->GetHeight());
-      }
+      g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), scaled_rect.left, scaled_rect.top, 0, 0,
+                                         m_vram_texture.get(), scaled_rect.left, scaled_rect.top,
+                                         scaled_rect.GetWidth(), scaled_rect.GetHeight());
     }
     else
     {
@@ -1360,39 +1394,51 @@ void GPU_HW::UpdateVRAMReadTexture(bool drawn, bool written)
                                       m_vram_texture.get(), scaled_rect.left, scaled_rect.top, 0, 0,
                                       scaled_rect.GetWidth(), scaled_rect.GetHeight());
     }
-
-    // m_counters.num_read_texture_updates++;
-    rect.SetInvalid();
   };
 
-  if (drawn)
+  u32 copied_area;
+  if (m_vram_texture->IsMultisampled() && !g_gpu_device->GetFeatures().partial_msaa_resolve)
   {
-    DebugAssert(m_vram_dirty_draw_rect.Valid());
-    GL_INS_FMT("Updating draw rect {},{} => {},{} ({}x{})", m_vram_dirty_draw_rect.left, m_vram_dirty_draw_rect.right,
-               m_vram_dirty_draw_rect.top, m_vram_dirty_draw_rect.bottom, m_vram_dirty_draw_rect.GetWidth(),
-               m_vram_dirty_draw_rect.GetHeight());
-
-    u8 dbits = TEXPAGE_DIRTY_DRAWN_RECT;
-    if (written && m_vram_dirty_draw_rect.Intersects(m_vram_dirty_write_rect))
+    // have to resolve everything, so every page is clean afterwards
+    GL_INS("Resolving all of VRAM");
+    g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), 0, 0, 0, 0, m_vram_texture.get(), 0, 0,
+                                       m_vram_texture->GetWidth(), m_vram_texture->GetHeight());
+    update_pages = m_vram_dirty_pages;
+    copied_area = VRAM_WIDTH * VRAM_HEIGHT;
+  }
+  else if ((update_rect.GetWidth() * update_rect.GetHeight()) <= (update_area + update_area / 4))
+  {
+    // neighbouring pages, e.g. a framebuffer, are cheaper to copy in one go
+    GL_INS_FMT("Updating {},{} => {},{} ({}x{}) from pages {:08X}", update_rect.left, update_rect.top,
+               update_rect.right, update_rect.bottom, update_rect.GetWidth(), update_rect.GetHeight(), update_pages);
+    copy(update_rect);
+    copied_area = update_rect.GetWidth() * update_rect.GetHeight();
+  }
+  else
+  {
+    for (u32 mask = update_pages; mask != 0; mask &= (mask - 1))
     {
-      DebugAssert(m_vram_dirty_write_rect.Valid());
-      GL_INS_FMT("Including write rect {},{} => {},{} ({}x{})", m_vram_dirty_write_rect.left,
-                 m_vram_dirty_write_rect.right, m_vram_dirty_write_rect.top, m_vram_dirty_write_rect.bottom,
-                 m_vram_dirty_write_rect.GetWidth(), m_vram_dirty_write_rect.GetHeight());
-      m_vram_dirty_draw_rect.Include(m_vram_dirty_write_rect);
-      m_vram_dirty_write_rect.SetInvalid();
-      dbits = TEXPAGE_DIRTY_DRAWN_RECT | TEXPAGE_DIRTY_WRITTEN_RECT;
-      written = false;
+      const Common::Rectangle<u32>& page_rect = m_vram_dirty_page_rects[CountTrailingZeros(mask)];
+      GL_INS_FMT("Updating page {},{} => {},{} ({}x{})", page_rect.left, page_rect.top, page_rect.right,
+                 page_rect.bottom, page_rect.GetWidth(), page_rect.GetHeight());
+      copy(page_rect);
     }
-
-    update(m_vram_dirty_draw_rect, dbits);
+    copied_area = update_area;
   }
-  if (written)
+
+  m_counters.num_read_texture_updates++;
+  m_counters.num_read_texture_pixels_copied += copied_area;
+  m_counters.num_read_texture_pixels_skipped +=
+    std::max<u32>(dirty_bounds.GetWidth() * dirty_bounds.GetHeight(), copied_area) - copied_area;
+
+  m_vram_dirty_pages &= ~update_pages;
+  for (u32 mask = update_pages; mask != 0; mask &= (mask - 1))
+    m_vram_dirty_page_rects[CountTrailingZeros(mask)].SetInvalid();
+
+  if (m_texpage_dirty && (m_vram_dirty_pages & m_texpage_page_mask) == 0)
   {
-    GL_INS_FMT("Updating write rect {},{} => {},{} ({}x{})", m_vram_dirty_write_rect.left,
-               m_vram_dirty_write_rect.right, m_vram_dirty_write_rect.top, m_vram_dirty_write_rect.bottom,
-               m_vram_dirty_write_rect.GetWidth(), m_vram_dirty_write_rect.GetHeight());
-    update(m_vram_dirty_write_rect, TEXPAGE_DIRTY_WRITTEN_RECT);
+    GL_INS("Texpage is no longer dirty");
+    m_texpage_dirty = false;
   }
 }
 
@@ -1922,12 +1968,15 @@ void GPU_HW::LoadVertices()
       std::array<std::array<s32, 2>, 4> native_vertex_positions;
       std::array<u16, 4> native_texcoords;
       bool valid_w = g_settings.gpu_pgxp_texture_correction;
+      const u32 num_words = num_vertices * (1 + BoolToUInt32(textured)) + (num_vertices - 1) * BoolToUInt32(shaded);
+      const u32* words = FifoPeekSpan(num_words);
+      u32 word_index = 0;
       for (u32 i = 0; i < num_vertices; i++)
       {
-        const u32 color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
-        const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
-        const u16 texcoord = textured ? Truncate16(FifoPop()) : 0;
+        const u32 color = (shaded && i > 0) ? (words[word_index++] & UINT32_C(0x00FFFFFF)) : first_color;
+        const u32 pos_index = word_index++;
+        const GPUVertexPosition vp{words[pos_index]};
+        const u16 texcoord = textured ? Truncate16(words[word_index++]) : 0;
         const s32 native_x = m_drawing_offset.x + vp.x;
         const s32 native_y = m_drawing_offset.y + vp.y;
         native_vertex_positions[i][0] = native_x;
@@ -1938,11 +1987,12 @@ void GPU_HW::LoadVertices()
 
         if (pgxp)
         {
-          valid_w &= CPU::PGXP::GetPreciseVertex(Truncate32(maddr_and_pos >> 32), vp.bits, native_x, native_y,
+          valid_w &= CPU::PGXP::GetPreciseVertex(FifoPeekAddress(pos_index), vp.bits, native_x, native_y,
                                                  m_drawing_offset.x, m_drawing_offset.y, &vertices[i].x, &vertices[i].y,
                                                  &vertices[i].w);
         }
       }
+      m_fifo.Remove(num_words);
       if (pgxp)
       {
         if (!valid_w)
@@ -2010,7 +2060,7 @@ void GPU_HW::LoadVertices()
         const u32 clip_bottom =
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-        m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        MarkVRAMDirty(Common::Rectangle<u32>(clip_left, clip_top, clip_right, clip_bottom));
         AddDrawTriangleTicks(native_vertex_positions[0][0], native_vertex_positions[0][1],
                              native_vertex_positions[1][0], native_vertex_positions[1][1],
                              native_vertex_positions[2][0], native_vertex_positions[2][1], rc.shading_enable,
@@ -2048,7 +2098,7 @@ void GPU_HW::LoadVertices()
           const u32 clip_bottom =
             static_cast<u32>(std::clamp<s32>(max_y_123, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-          m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+          MarkVRAMDirty(Common::Rectangle<u32>(clip_left, clip_top, clip_right, clip_bottom));
           AddDrawTriangleTicks(native_vertex_positions[2][0], native_vertex_positions[2][1],
                                native_vertex_positions[1][0], native_vertex_positions[1][1],
                                native_vertex_positions[3][0], native_vertex_positions[3][1], rc.shading_enable,
@@ -2194,7 +2244,7 @@ void GPU_HW::LoadVertices()
       const u32 clip_bottom =
         static_cast<u32>(std::clamp<s32>(pos_y + rectangle_height, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-      m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+      MarkVRAMDirty(Common::Rectangle<u32>(clip_left, clip_top, clip_right, clip_bottom));
       AddDrawRectangleTicks(clip_right - clip_left, clip_bottom - clip_top, rc.texture_enable, rc.transparency_enable);
 
       if (m_sw_renderer)
@@ -2257,7 +2307,7 @@ void GPU_HW::LoadVertices()
         const u32 clip_bottom =
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-        m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        MarkVRAMDirty(Common::Rectangle<u32>(clip_left, clip_top, clip_right, clip_bottom));
         AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
         // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -2324,7 +2374,7 @@ void GPU_HW::LoadVertices()
             const u32 clip_bottom =
               static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
-            m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+            MarkVRAMDirty(Common::Rectangle<u32>(clip_left, clip_top, clip_right, clip_bottom));
             AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
             // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -2393,9 +2443,33 @@ bool GPU_HW::BlitVRAMReplacementTexture(const TextureReplacementTexture* tex, u3
   return true;
 }
 
-void GPU_HW::IncludeVRAMDirtyRectangle(Common::Rectangle<u32>& rect, const Common::Rectangle<u32>& new_rect)
+ALWAYS_INLINE_RELEASE void GPU_HW::MarkVRAMDirty(const Common::Rectangle<u32>& rect)
+{
+  u32 mask = GetVRAMPageMask(rect);
+  m_vram_dirty_pages |= mask;
+  for (; mask != 0; mask &= (mask - 1))
+  {
+    const u32 page = CountTrailingZeros(mask);
+    const Common::Rectangle<u32> page_rect = GetVRAMPageRectangle(page);
+    m_vram_dirty_page_rects[page].Include(
+      rect.Clamped(page_rect.left, page_rect.top, page_rect.right, page_rect.bottom));
+  }
+}
+
+bool GPU_HW::IsVRAMDirty(const Common::Rectangle<u32>& rect) const
+{
+  for (u32 mask = GetVRAMPageMask(rect) & m_vram_dirty_pages; mask != 0; mask &= (mask - 1))
+  {
+    if (m_vram_dirty_page_rects[CountTrailingZeros(mask)].Intersects(rect))
+      return true;
+  }
+
+  return false;
+}
+
+void GPU_HW::IncludeVRAMDirtyRectangle(const Common::Rectangle<u32>& new_rect)
 {
-  rect.Include(new_rect);
+  MarkVRAMDirty(new_rect);
 
   // the vram area can include the texture page, but the game can leave it as-is. in this case, set it as dirty so the
   // shadow texture is updated
@@ -2434,41 +2508,19 @@ ALWAYS_INLINE_RELEASE void GPU_HW::CheckForTexPageOverlap(u32 texpage, u32 min_u
   {
     m_current_uv_range.Include(vram_min_u, vram_max_u + 1, vram_min_v, vram_max_v + 1);
 
-    bool update_drawn = false, update_written = false;
-    if (m_texpage_dirty & TEXPAGE_DIRTY_DRAWN_RECT)
-    {
-      DebugAssert(m_vram_dirty_draw_rect.Valid());
-      update_drawn = m_current_uv_range.Intersects(m_vram_dirty_draw_rect);
-      if (update_drawn)
-      {
-        GL_INS_FMT("Updating VRAM cache due to UV {{{},{} => {},{}}} intersection with dirty DRAW {{{},{} => {},{}}}",
-                   m_current_uv_range.left, m_current_uv_range.top, m_current_uv_range.right, m_current_uv_range.bottom,
-                   m_vram_dirty_draw_rect.left, m_vram_dirty_draw_rect.top, m_vram_dirty_draw_rect.right,
-                   m_vram_dirty_draw_rect.bottom);
-      }
-    }
-    if (m_texpage_dirty & TEXPAGE_DIRTY_WRITTEN_RECT)
+    if (IsVRAMDirty(m_current_uv_range))
     {
-      DebugAssert(m_vram_dirty_write_rect.Valid());
-      update_written = m_current_uv_range.Intersects(m_vram_dirty_write_rect);
-      if (update_written)
-      {
-        GL_INS_FMT("Updating VRAM cache due to UV {{{},{} => {},{}}} intersection with dirty WRITE {{{},{} => {},{}}}",
-                   m_current_uv_range.left, m_current_uv_range.top, m_current_uv_range.right, m_current_uv_range.bottom,
-                   m_vram_dirty_write_rect.left, m_vram_dirty_write_rect.top, m_vram_dirty_write_rect.right,
-                   m_vram_dirty_write_rect.bottom);
-      }
-    }
+      GL_INS_FMT("Updating VRAM cache due to UV {{{},{} => {},{}}} intersection with dirty pages {:08X}",
+                 m_current_uv_range.left, m_current_uv_range.top, m_current_uv_range.right, m_current_uv_range.bottom,
+                 m_vram_dirty_pages & m_texpage_page_mask);
 
-    if (update_drawn || update_written)
-    {
       if (m_batch_index_count > 0)
       {
         FlushRender();
         EnsureVertexBufferSpaceForCurrentCommand();
       }
 
-      UpdateVRAMReadTexture(update_drawn, update_written);
+      UpdateVRAMReadTexture(m_current_uv_range);
     }
   }
 }
@@ -2632,17 +2684,10 @@ void GPU_HW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
     m_sw_renderer->PushCommand(cmd);
   }
 
-  GL_INS_FMT("Dirty draw area before: {},{} => {},{} ({}x{})", m_vram_dirty_draw_rect.left, m_vram_dirty_draw_rect.top,
-             m_vram_dirty_draw_rect.right, m_vram_dirty_draw_rect.bottom, m_vram_dirty_draw_rect.GetWidth(),
-             m_vram_dirty_draw_rect.GetHeight());
-
+  GL_INS_FMT("Dirty pages before: {:08X}", m_vram_dirty_pages);
   IncludeVRAMDirtyRectangle(
-    m_vram_dirty_draw_rect,
     Common::Rectangle<u32>::FromExtents(x, y, width, height).Clamped(0, 0, VRAM_WIDTH, VRAM_HEIGHT));
-
-  GL_INS_FMT("Dirty draw area after: {},{} => {},{} ({}x{})", m_vram_dirty_draw_rect.left, m_vram_dirty_draw_rect.top,
-             m_vram_dirty_draw_rect.right, m_vram_dirty_draw_rect.bottom, m_vram_dirty_draw_rect.GetWidth(),
-             m_vram_dirty_draw_rect.GetHeight());
+  GL_INS_FMT("Dirty pages after: {:08X}", m_vram_dirty_pages);
 
   const bool is_oversized = (((x + width) > VRAM_WIDTH || (y + height) > VRAM_HEIGHT));
   g_gpu_device->SetPipeline(
@@ -2755,7 +2800,7 @@ void GPU_HW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, b
 
   const Common::Rectangle<u32> bounds = GetVRAMTransferBounds(x, y, width, height);
   DebugAssert(bounds.right <= VRAM_WIDTH && bounds.bottom <= VRAM_HEIGHT);
-  IncludeVRAMDirtyRectangle(m_vram_dirty_write_rect, bounds);
+  IncludeVRAMDirtyRectangle(bounds);
 
   if (check_mask)
   {
@@ -2856,14 +2901,13 @@ void GPU_HW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32
      ((dst_y % VRAM_HEIGHT) + height) > VRAM_HEIGHT);
   const Common::Rectangle<u32> src_bounds = GetVRAMTransferBounds(src_x, src_y, width, height);
   const Common::Rectangle<u32> dst_bounds = GetVRAMTransferBounds(dst_x, dst_y, width, height);
-  const bool intersect_with_draw = m_vram_dirty_draw_rect.Intersects(src_bounds);
-  const bool intersect_with_write = m_vram_dirty_write_rect.Intersects(src_bounds);
+  const bool src_dirty = IsVRAMDirty(src_bounds);
 
   if (use_shader || IsUsingMultisampling())
   {
-    if (intersect_with_draw || intersect_with_write)
-      UpdateVRAMReadTexture(intersect_with_draw, intersect_with_write);
-    IncludeVRAMDirtyRectangle(m_vram_dirty_draw_rect, dst_bounds);
+    if (src_dirty)
+      UpdateVRAMReadTexture(src_bounds);
+    IncludeVRAMDirtyRectangle(dst_bounds);
 
     struct VRAMCopyUBOData
     {
@@ -2911,23 +2955,11 @@ void GPU_HW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32
   if (!g_gpu_device->GetFeatures().texture_copy_to_self || overlaps_with_self)
   {
     src_tex = m_vram_read_texture.get();
-    if (intersect_with_draw || intersect_with_write)
-      UpdateVRAMReadTexture(intersect_with_draw, intersect_with_write);
+    if (src_dirty)
+      UpdateVRAMReadTexture(src_bounds);
   }
 
-  Common::Rectangle<u32>* update_rect;
-  if (intersect_with_draw || intersect_with_write)
-  {
-    update_rect = intersect_with_draw ? &m_vram_dirty_draw_rect : &m_vram_dirty_write_rect;
-  }
-  else
-  {
-    const bool use_write =
-      (m_vram_dirty_write_rect.Valid() && m_vram_dirty_draw_rect.Valid() &&
-       m_vram_dirty_write_rect.GetDistance(dst_bounds) < m_vram_dirty_draw_rect.GetDistance(dst_bounds));
-    update_rect = use_write ? &m_vram_dirty_write_rect : &m_vram_dirty_draw_rect;
-  }
-  IncludeVRAMDirtyRectangle(*update_rect, dst_bounds);
+  IncludeVRAMDirtyRectangle(dst_bounds);
 
   if (m_GPUSTAT.check_mask_before_draw)
   {
@@ -2974,26 +3006,22 @@ void GPU_HW::DispatchRenderCommand()
       {
         const Common::Rectangle<u32> palette_rect =
           m_draw_mode.palette_reg.GetRectangle(m_draw_mode.mode_reg.texture_mode);
-        const bool update_drawn = palette_rect.Intersects(m_vram_dirty_draw_rect);
-        const bool update_written = palette_rect.Intersects(m_vram_dirty_write_rect);
-        if (update_drawn || update_written)
+        if (IsVRAMDirty(palette_rect))
         {
           GL_INS("Palette in VRAM dirty area, flushing cache");
           if (!IsFlushed())
             FlushRender();
 
-          UpdateVRAMReadTexture(update_drawn, update_written);
+          UpdateVRAMReadTexture(palette_rect);
         }
       }
 
-      const Common::Rectangle<u32> page_rect = m_draw_mode.mode_reg.GetTexturePageRectangle();
-      u8 new_texpage_dirty = m_vram_dirty_draw_rect.Intersects(page_rect) ? TEXPAGE_DIRTY_DRAWN_RECT : 0;
-      new_texpage_dirty |= m_vram_dirty_write_rect.Intersects(page_rect) ? TEXPAGE_DIRTY_WRITTEN_RECT : 0;
-
-      if (new_texpage_dirty != 0)
+      // texture pages are aligned to VRAM pages, so any dirty page in the mask overlaps the texture page
+      m_texpage_page_mask = GetVRAMPageMask(m_draw_mode.mode_reg.GetTexturePageRectangle());
+      if ((m_vram_dirty_pages & m_texpage_page_mask) != 0)
       {
         GL_INS("Texpage is in dirty area, checking UV ranges");
-        m_texpage_dirty = new_texpage_dirty;
+        m_texpage_dirty = true;
         m_compute_uv_range = true;
         m_current_uv_range.SetInvalid();
       }
@@ -3002,7 +3030,7 @@ void GPU_HW::DispatchRenderCommand()
         m_compute_uv_range = m_clamp_uvs;
         if (m_texpage_dirty)
           GL_INS("Texpage is no longer dirty");
-        m_texpage_dirty = 0;
+        m_texpage_dirty = false;
       }
     }
 
@@ -3119,9 +3147,7 @@ void GPU_HW::FlushRender()
   GL_SCOPE_FMT("Hardware Draw {}", ++s_draw_number);
 #endif
 
-  GL_INS_FMT("Dirty draw area: {},{} => {},{} ({}x{})", m_vram_dirty_draw_rect.left, m_vram_dirty_draw_rect.top,
-             m_vram_dirty_draw_rect.right, m_vram_dirty_draw_rect.bottom, m_vram_dirty_draw_rect.GetWidth(),
-             m_vram_dirty_draw_rect.GetHeight());
+  GL_INS_FMT("Dirty VRAM pages: {:08X}", m_vram_dirty_pages);
 
   if (m_batch_ubo_dirty)
   {
@@ -3164,7 +3190,7 @@ void GPU_HW::UpdateDisplay()
   {
     if (IsUsingMultisampling())
     {
-      UpdateVRAMReadTexture(true, true);
+      UpdateVRAMReadTexture(Common::Rectangle<u32>(0, 0, VRAM_WIDTH, VRAM_HEIGHT));
       SetDisplayTexture(m_vram_read_texture.get(), 0, 0, m_vram_read_texture->GetWidth(),
                         m_vram_read_texture->GetHeight());
     }
@@ -3500,6 +3526,13 @@ void GPU_HW::DrawRendererStats()
                        "Cache");
     ImGui::NextColumn();
 
+    ImGui::TextUnformatted("Read Texture Updates:");
+    ImGui::NextColumn();
+    ImGui::Text("%u (%u KB copied, %u KB avoided)", m_stats.num_read_texture_updates,
+                static_cast<u32>((m_stats.num_read_texture_pixels_copied * sizeof(u16)) / 1024),
+                static_cast<u32>((m_stats.num_read_texture_pixels_skipped * sizeof(u16)) / 1024));
+    ImGui::NextColumn();
+
     ImGui::Columns(1);
   }
 }
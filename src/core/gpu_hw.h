@@ -59,11 +59,15 @@ private:
     MAX_VERTICES_FOR_RECTANGLE = 6 * (((MAX_PRIMITIVE_WIDTH + (TEXTURE_PAGE_WIDTH - 1)) / TEXTURE_PAGE_WIDTH) + 1u) *
                                  (((MAX_PRIMITIVE_HEIGHT + (TEXTURE_PAGE_HEIGHT - 1)) / TEXTURE_PAGE_HEIGHT) + 1u)
   };
-  enum : u8
+  enum : u32
   {
-    TEXPAGE_DIRTY_DRAWN_RECT = (1 << 0),
-    TEXPAGE_DIRTY_WRITTEN_RECT = (1 << 1),
+    VRAM_PAGE_WIDTH = 64,
+    VRAM_PAGE_HEIGHT = 256,
+    VRAM_PAGES_WIDE = VRAM_WIDTH / VRAM_PAGE_WIDTH,
+    VRAM_PAGES_HIGH = VRAM_HEIGHT / VRAM_PAGE_HEIGHT,
+    NUM_VRAM_PAGES = VRAM_PAGES_WIDE * VRAM_PAGES_HIGH,
   };
+  static_assert(NUM_VRAM_PAGES <= 32, "Dirty pages must fit in a u32 mask");
 
   static_assert(GPUDevice::MIN_TEXEL_BUFFER_ELEMENTS >= (VRAM_WIDTH * VRAM_HEIGHT));
 
@@ -131,7 +135,7 @@ private:
   void PrintSettingsToLog();
   void CheckSettings();
 
-  void UpdateVRAMReadTexture(bool drawn, bool written);
+  void UpdateVRAMReadTexture(const Common::Rectangle<u32>& rect);
   void UpdateDepthBufferFromMaskBit();
   void ClearDepthBuffer();
   void SetScissor();
@@ -146,9 +150,14 @@ private:
   bool IsUsingMultisampling() const;
   bool IsUsingDownsampling() const;
 
+  static u32 GetVRAMPageMask(const Common::Rectangle<u32>& rect);
+  static Common::Rectangle<u32> GetVRAMPageRectangle(u32 page);
+
   void SetFullVRAMDirtyRectangle();
   void ClearVRAMDirtyRectangle();
-  void IncludeVRAMDirtyRectangle(Common::Rectangle<u32>& rect, const Common::Rectangle<u32>& new_rect);
+  void MarkVRAMDirty(const Common::Rectangle<u32>& rect);
+  void IncludeVRAMDirtyRectangle(const Common::Rectangle<u32>& rect);
+  bool IsVRAMDirty(const Common::Rectangle<u32>& rect) const;
   void CheckForTexPageOverlap(u32 texpage, u32 min_u, u32 min_v, u32 max_u, u32 max_v);
 
   bool IsFlushed() const;
@@ -243,7 +252,7 @@ private:
   bool m_pgxp_depth_buffer : 1 = false;
   bool m_allow_shader_blend : 1 = false;
   bool m_prefer_shader_blend : 1 = false;
-  u8 m_texpage_dirty = 0;
+  bool m_texpage_dirty : 1 = false;
 
   BatchConfig m_batch;
 
@@ -251,9 +260,11 @@ private:
   bool m_batch_ubo_dirty = true;
   BatchUBOData m_batch_ubo_data = {};
 
-  // Bounding box of VRAM area that the GPU has drawn into.
-  Common::Rectangle<u32> m_vram_dirty_draw_rect;
-  Common::Rectangle<u32> m_vram_dirty_write_rect;
+  // VRAM which has been drawn or written to since it was last copied to the read texture, tracked per 64x256 page.
+  // Pages line up with texture page addresses, so sampling one page only copies the dirty area of that page.
+  std::array<Common::Rectangle<u32>, NUM_VRAM_PAGES> m_vram_dirty_page_rects;
+  u32 m_vram_dirty_pages = 0;
+  u32 m_texpage_page_mask = 0;
   Common::Rectangle<u32> m_current_uv_range;
 
   std::unique_ptr<GPUPipeline> m_wireframe_pipeline;
@@ -5,12 +5,15 @@
 #include "system.h"
 
 #include "util/gpu_device.h"
+#include "util/imgui_manager.h"
 
 #include "common/align.h"
 #include "common/assert.h"
 #include "common/intrin.h"
 #include "common/log.h"
 
+#include "imgui.h"
+
 #include <algorithm>
 
 Log_SetChannel(GPU_SW);
@@ -462,6 +465,7 @@ void GPU_SW::UpdateDisplay()
 {
   // fill display texture
   m_backend.Sync(true);
+  m_last_frame_counters = m_backend.GetAndResetCounters();
 
   if (!g_settings.debugging.show_vram)
   {
@@ -521,6 +525,37 @@ void GPU_SW::UpdateDisplay()
   }
 }
 
+void GPU_SW::DrawRendererStats()
+{
+  if (ImGui::CollapsingHeader("Renderer Statistics", ImGuiTreeNodeFlags_DefaultOpen))
+  {
+    ImGui::Columns(2);
+    ImGui::SetColumnWidth(0, 200.0f * Host::GetOSDScale());
+
+    ImGui::TextUnformatted("GPU Thread:");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted(m_backend.GetThread() ? "Enabled" : "Disabled");
+    ImGui::NextColumn();
+
+    ImGui::TextUnformatted("FIFO Stalls (last frame):");
+    ImGui::NextColumn();
+    ImGui::Text("%u", m_last_frame_counters.producer_stalls);
+    ImGui::NextColumn();
+
+    ImGui::TextUnformatted("Thread Parks (last frame):");
+    ImGui::NextColumn();
+    ImGui::Text("%u", m_last_frame_counters.consumer_parks);
+    ImGui::NextColumn();
+
+    ImGui::TextUnformatted("Thread Wakeups (last frame):");
+    ImGui::NextColumn();
+    ImGui::Text("%u", m_last_frame_counters.wakeups);
+    ImGui::NextColumn();
+
+    ImGui::Columns(1);
+  }
+}
+
 void GPU_SW::FillBackendCommandParameters(GPUBackendCommand* cmd) const
 {
   cmd->params.bits = 0;
@@ -562,16 +597,18 @@ void GPU_SW::DispatchRenderCommand()
       const u32 first_color = rc.color_for_first_vertex;
       const bool shaded = rc.shading_enable;
       const bool textured = rc.texture_enable;
+      const u32 num_words = num_vertices * (1 + BoolToUInt32(textured)) + (num_vertices - 1) * BoolToUInt32(shaded);
+      const u32* words = FifoPeekSpan(num_words);
       for (u32 i = 0; i < num_vertices; i++)
       {
         GPUBackendDrawPolygonCommand::Vertex* vert = &cmd->vertices[i];
-        vert->color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
-        const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
+        vert->color = (shaded && i > 0) ? (*(words++) & UINT32_C(0x00FFFFFF)) : first_color;
+        const GPUVertexPosition vp{*(words++)};
         vert->x = m_drawing_offset.x + vp.x;
         vert->y = m_drawing_offset.y + vp.y;
-        vert->texcoord = textured ? Truncate16(FifoPop()) : 0;
+        vert->texcoord = textured ? Truncate16(*(words++)) : 0;
       }
+      m_fifo.Remove(num_words);
 
       if (!IsDrawingAreaIsValid())
         return;
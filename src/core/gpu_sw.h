@@ -53,6 +53,8 @@ protected:
 
   void DispatchRenderCommand() override;
 
+  void DrawRendererStats() override;
+
   void FillBackendCommandParameters(GPUBackendCommand* cmd) const;
   void FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) const;
 
@@ -64,4 +66,5 @@ protected:
   std::unique_ptr<GPUTexture> m_upload_texture;
 
   GPU_SW_Backend m_backend;
+  GPUBackend::Counters m_last_frame_counters = {};
 };
@@ -3,11 +3,20 @@
 
 #include "gpu.h"
 #include "gpu_sw_backend.h"
+#include "settings.h"
 #include "system.h"
 
 #include "util/gpu_device.h"
 
+#include "common/align.h"
+#include "common/intrin.h"
+#include "common/log.h"
+#include "common/small_string.h"
+
 #include <algorithm>
+#include <cstring>
+
+Log_SetChannel(GPU_SW_Backend);
 
 GPU_SW_Backend::GPU_SW_Backend() = default;
 
@@ -15,7 +24,23 @@ GPU_SW_Backend::~GPU_SW_Backend() = default;
 
 bool GPU_SW_Backend::Initialize(bool force_thread)
 {
-  return GPUBackend::Initialize(force_thread);
+  if (!GPUBackend::Initialize(force_thread))
+    return false;
+
+  StartWorkerThreads(g_settings.gpu_sw_threads);
+  return true;
+}
+
+void GPU_SW_Backend::UpdateSettings()
+{
+  GPUBackend::UpdateSettings();
+
+  // Sync() above has already flushed any pending batch, so the workers are idle.
+  if (GetWorkerCountForThreads(g_settings.gpu_sw_threads) != m_num_workers)
+  {
+    StopWorkerThreads();
+    StartWorkerThreads(g_settings.gpu_sw_threads);
+  }
 }
 
 void GPU_SW_Backend::Reset()
@@ -23,36 +48,77 @@ void GPU_SW_Backend::Reset()
   GPUBackend::Reset();
 }
 
+void GPU_SW_Backend::Shutdown()
+{
+  GPUBackend::Shutdown();
+  FlushBatch();
+  StopWorkerThreads();
+}
+
 void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
 {
-  const GPURenderCommand rc{cmd->rc.bits};
-  const bool dithering_enable = rc.IsDitheringEnabled() && cmd->draw_mode.dither_enable;
+  if (IsBatchingDraws())
+    QueueDrawCommand(cmd);
+  else
+    DrawCommand(cmd, m_drawing_area);
+}
 
-  const DrawTriangleFunction DrawFunction = GetDrawTriangleFunction(
-    rc.shading_enable, rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable, dithering_enable);
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+{
+  if (IsBatchingDraws())
+    QueueDrawCommand(cmd);
+  else
+    DrawCommand(cmd, m_drawing_area);
+}
 
-  (this->*DrawFunction)(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
-  if (rc.quad_polygon)
-    (this->*DrawFunction)(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
+{
+  if (IsBatchingDraws())
+    QueueDrawCommand(cmd);
+  else
+    DrawCommand(cmd, m_drawing_area);
 }
 
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::DrawCommand(const GPUBackendDrawCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const GPURenderCommand rc{cmd->rc.bits};
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+    {
+      const GPUBackendDrawPolygonCommand* pcmd = static_cast<const GPUBackendDrawPolygonCommand*>(cmd);
+      const DrawTriangleFunction DrawFunction = GetDrawTriangleFunction(
+        rc.shading_enable, rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable, cmd->IsDitheringEnabled());
 
-  const DrawRectangleFunction DrawFunction =
-    GetDrawRectangleFunction(rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable);
+      (this->*DrawFunction)(pcmd, clip, &pcmd->vertices[0], &pcmd->vertices[1], &pcmd->vertices[2]);
+      if (rc.quad_polygon)
+        (this->*DrawFunction)(pcmd, clip, &pcmd->vertices[2], &pcmd->vertices[1], &pcmd->vertices[3]);
+    }
+    break;
 
-  (this->*DrawFunction)(cmd);
-}
+    case GPUBackendCommandType::DrawRectangle:
+    {
+      const DrawRectangleFunction DrawFunction =
+        GetDrawRectangleFunction(rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable);
 
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
-{
-  const DrawLineFunction DrawFunction =
-    GetDrawLineFunction(cmd->rc.shading_enable, cmd->rc.transparency_enable, cmd->IsDitheringEnabled());
+      (this->*DrawFunction)(static_cast<const GPUBackendDrawRectangleCommand*>(cmd), clip);
+    }
+    break;
+
+    case GPUBackendCommandType::DrawLine:
+    {
+      const GPUBackendDrawLineCommand* lcmd = static_cast<const GPUBackendDrawLineCommand*>(cmd);
+      const DrawLineFunction DrawFunction =
+        GetDrawLineFunction(rc.shading_enable, rc.transparency_enable, cmd->IsDitheringEnabled());
+
+      for (u16 i = 1; i < lcmd->num_vertices; i++)
+        (this->*DrawFunction)(lcmd, clip, &lcmd->vertices[i - 1], &lcmd->vertices[i]);
+    }
+    break;
 
-  for (u16 i = 1; i < cmd->num_vertices; i++)
-    (this->*DrawFunction)(cmd, &cmd->vertices[i - 1], &cmd->vertices[i]);
+    default:
+      break;
+  }
 }
 
 constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
@@ -74,6 +140,50 @@ constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
 
 static constexpr GPU_SW_Backend::DitherLUT s_dither_lut = GPU_SW_Backend::ComputeDitherLUT();
 
+ALWAYS_INLINE_RELEASE u16 GPU_SW_Backend::SampleTexture(const GPUBackendDrawCommand* cmd, u8 texcoord_x,
+                                                        u8 texcoord_y) const
+{
+  // Apply texture window
+  texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
+  texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
+
+  u16 texture_color;
+  switch (cmd->draw_mode.texture_mode)
+  {
+    case GPUTextureMode::Palette4Bit:
+    {
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
+
+      texture_color =
+        GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
+    break;
+
+    case GPUTextureMode::Palette8Bit:
+    {
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
+      texture_color =
+        GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
+    break;
+
+    default:
+    {
+      texture_color = GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
+                               (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+    }
+    break;
+  }
+
+  return texture_color;
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
 void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
                                                       u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
@@ -81,43 +191,8 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
   VRAMPixel color;
   if constexpr (texture_enable)
   {
-    // Apply texture window
-    texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
-    texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
-
     VRAMPixel texture_color;
-    switch (cmd->draw_mode.texture_mode)
-    {
-      case GPUTextureMode::Palette4Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
-
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      case GPUTextureMode::Palette8Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      default:
-      {
-        texture_color.bits = GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
-                                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-      }
-      break;
-    }
+    texture_color.bits = SampleTexture(cmd, texcoord_x, texcoord_y);
 
     if (texture_color.bits == 0)
       return;
@@ -218,7 +293,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
 }
 
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const s32 origin_x = cmd->x;
   const s32 origin_y = cmd->y;
@@ -228,7 +303,7 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(m_drawing_area.top) || y > static_cast<s32>(m_drawing_area.bottom) ||
+    if (y < static_cast<s32>(clip.top) || y > static_cast<s32>(clip.bottom) ||
         (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)))
     {
       continue;
@@ -239,7 +314,7 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
     for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
     {
       const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(m_drawing_area.left) || x > static_cast<s32>(m_drawing_area.right))
+      if (x < static_cast<s32>(clip.left) || x > static_cast<s32>(clip.right))
         continue;
 
       const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
@@ -356,10 +431,404 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::AddIDeltas_DY(i_group& ig, const i_de
   }
 }
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+
+// Spans are shaded eight pixels at a time, as two vectors of four 32-bit lanes. 32-bit lanes are used so that the
+// blending below is bit-identical to ShadePixel(), which depends on carries/borrows past bit 15.
+#define VECTOR_SPAN_SHADING 1
+static constexpr u32 VECTOR_SPAN_PIXELS = 8;
+
+#if defined(CPU_ARCH_SSE)
+
+using SpanVector = __m128i;
+
+ALWAYS_INLINE static SpanVector SpanVectorSet(u32 v)
+{
+  return _mm_set1_epi32(static_cast<s32>(v));
+}
+ALWAYS_INLINE static SpanVector SpanVectorSet(u32 v0, u32 v1, u32 v2, u32 v3)
+{
+  return _mm_setr_epi32(static_cast<s32>(v0), static_cast<s32>(v1), static_cast<s32>(v2), static_cast<s32>(v3));
+}
+ALWAYS_INLINE static SpanVector SpanVectorLoad(const u32* ptr)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+ALWAYS_INLINE static void SpanVectorStore(u32* ptr, SpanVector v)
+{
+  _mm_store_si128(reinterpret_cast<__m128i*>(ptr), v);
+}
+ALWAYS_INLINE static SpanVector SpanVectorAdd(SpanVector a, SpanVector b)
+{
+  return _mm_add_epi32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorSub(SpanVector a, SpanVector b)
+{
+  return _mm_sub_epi32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorAnd(SpanVector a, SpanVector b)
+{
+  return _mm_and_si128(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorOr(SpanVector a, SpanVector b)
+{
+  return _mm_or_si128(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorXor(SpanVector a, SpanVector b)
+{
+  return _mm_xor_si128(a, b);
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSrl(SpanVector v)
+{
+  return _mm_srli_epi32(v, n);
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSra(SpanVector v)
+{
+  return _mm_srai_epi32(v, n);
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSll(SpanVector v)
+{
+  return _mm_slli_epi32(v, n);
+}
+ALWAYS_INLINE static SpanVector SpanVectorCmpEq(SpanVector a, SpanVector b)
+{
+  return _mm_cmpeq_epi32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorCmpGtS(SpanVector a, SpanVector b)
+{
+  return _mm_cmpgt_epi32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorSelect(SpanVector mask, SpanVector a, SpanVector b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Only valid when both operands and the product fit in 16 bits, SSE2 has no 32-bit multiply.
+ALWAYS_INLINE static SpanVector SpanVectorMul16(SpanVector a, SpanVector b)
+{
+  return _mm_mullo_epi16(a, b);
+}
+
+ALWAYS_INLINE static void SpanVectorLoadPixels(const u16* ptr, SpanVector* lo, SpanVector* hi)
+{
+  const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  *lo = _mm_unpacklo_epi16(pixels, _mm_setzero_si128());
+  *hi = _mm_unpackhi_epi16(pixels, _mm_setzero_si128());
+}
+ALWAYS_INLINE static void SpanVectorStorePixels(u16* ptr, SpanVector lo, SpanVector hi)
+{
+  // Sign-extend so that the saturating pack leaves all 16 bits intact.
+  lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+  hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), _mm_packs_epi32(lo, hi));
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+using SpanVector = uint32x4_t;
+
+ALWAYS_INLINE static SpanVector SpanVectorSet(u32 v)
+{
+  return vdupq_n_u32(v);
+}
+ALWAYS_INLINE static SpanVector SpanVectorSet(u32 v0, u32 v1, u32 v2, u32 v3)
+{
+  alignas(VECTOR_ALIGNMENT) const u32 values[4] = {v0, v1, v2, v3};
+  return vld1q_u32(values);
+}
+ALWAYS_INLINE static SpanVector SpanVectorLoad(const u32* ptr)
+{
+  return vld1q_u32(ptr);
+}
+ALWAYS_INLINE static void SpanVectorStore(u32* ptr, SpanVector v)
+{
+  vst1q_u32(ptr, v);
+}
+ALWAYS_INLINE static SpanVector SpanVectorAdd(SpanVector a, SpanVector b)
+{
+  return vaddq_u32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorSub(SpanVector a, SpanVector b)
+{
+  return vsubq_u32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorAnd(SpanVector a, SpanVector b)
+{
+  return vandq_u32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorOr(SpanVector a, SpanVector b)
+{
+  return vorrq_u32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorXor(SpanVector a, SpanVector b)
+{
+  return veorq_u32(a, b);
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSrl(SpanVector v)
+{
+  return vshrq_n_u32(v, n);
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSra(SpanVector v)
+{
+  return vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(v), n));
+}
+template<int n>
+ALWAYS_INLINE static SpanVector SpanVectorSll(SpanVector v)
+{
+  return vshlq_n_u32(v, n);
+}
+ALWAYS_INLINE static SpanVector SpanVectorCmpEq(SpanVector a, SpanVector b)
+{
+  return vceqq_u32(a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorCmpGtS(SpanVector a, SpanVector b)
+{
+  return vcgtq_s32(vreinterpretq_s32_u32(a), vreinterpretq_s32_u32(b));
+}
+ALWAYS_INLINE static SpanVector SpanVectorSelect(SpanVector mask, SpanVector a, SpanVector b)
+{
+  return vbslq_u32(mask, a, b);
+}
+ALWAYS_INLINE static SpanVector SpanVectorMul16(SpanVector a, SpanVector b)
+{
+  return vmulq_u32(a, b);
+}
+
+ALWAYS_INLINE static void SpanVectorLoadPixels(const u16* ptr, SpanVector* lo, SpanVector* hi)
+{
+  const uint16x8_t pixels = vld1q_u16(ptr);
+  *lo = vmovl_u16(vget_low_u16(pixels));
+  *hi = vmovl_u16(vget_high_u16(pixels));
+}
+ALWAYS_INLINE static void SpanVectorStorePixels(u16* ptr, SpanVector lo, SpanVector hi)
+{
+  vst1q_u16(ptr, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+
+#endif
+
+/// Vector equivalent of s_dither_lut, value + offset is clamped to 0..31 after dropping the low three bits.
+ALWAYS_INLINE static SpanVector SpanVectorDither(SpanVector value, SpanVector dither)
+{
+  const SpanVector zero = SpanVectorSet(0);
+  const SpanVector max = SpanVectorSet(31);
+  SpanVector dithered = SpanVectorSra<3>(SpanVectorAdd(value, dither));
+  dithered = SpanVectorSelect(SpanVectorCmpGtS(zero, dithered), zero, dithered);
+  return SpanVectorSelect(SpanVectorCmpGtS(dithered, max), max, dithered);
+}
+
+/// Vector equivalent of the blending in ShadePixel(), result is truncated to 16 bits.
+ALWAYS_INLINE static SpanVector SpanVectorBlend(GPUTransparencyMode mode, SpanVector fg, SpanVector bg)
+{
+  const SpanVector bit15 = SpanVectorSet(0x8000u);
+  SpanVector result;
+  switch (mode)
+  {
+    case GPUTransparencyMode::HalfBackgroundPlusHalfForeground:
+    {
+      bg = SpanVectorOr(bg, bit15);
+      result = SpanVectorSrl<1>(
+        SpanVectorSub(SpanVectorAdd(fg, bg), SpanVectorAnd(SpanVectorXor(fg, bg), SpanVectorSet(0x0421u))));
+    }
+    break;
+
+    case GPUTransparencyMode::BackgroundPlusForeground:
+    case GPUTransparencyMode::BackgroundPlusQuarterForeground:
+    {
+      bg = SpanVectorAnd(bg, SpanVectorSet(0x7FFFu));
+      if (mode == GPUTransparencyMode::BackgroundPlusQuarterForeground)
+        fg = SpanVectorOr(SpanVectorAnd(SpanVectorSrl<2>(fg), SpanVectorSet(0x1CE7u)), bit15);
+
+      const SpanVector sum = SpanVectorAdd(fg, bg);
+      const SpanVector carry = SpanVectorAnd(
+        SpanVectorSub(sum, SpanVectorAnd(SpanVectorXor(fg, bg), SpanVectorSet(0x8421u))), SpanVectorSet(0x8420u));
+      result = SpanVectorOr(SpanVectorSub(sum, carry), SpanVectorSub(carry, SpanVectorSrl<5>(carry)));
+    }
+    break;
+
+    case GPUTransparencyMode::BackgroundMinusForeground:
+    {
+      bg = SpanVectorOr(bg, bit15);
+      fg = SpanVectorAnd(fg, SpanVectorSet(0x7FFFu));
+
+      const SpanVector borrow_mask = SpanVectorSet(0x108420u);
+      const SpanVector diff = SpanVectorAdd(SpanVectorSub(bg, fg), borrow_mask);
+      const SpanVector borrow =
+        SpanVectorAnd(SpanVectorSub(diff, SpanVectorAnd(SpanVectorXor(bg, fg), borrow_mask)), borrow_mask);
+      result = SpanVectorAnd(SpanVectorSub(diff, borrow), SpanVectorSub(borrow, SpanVectorSrl<5>(borrow)));
+    }
+    break;
+
+    default:
+      result = fg;
+      break;
+  }
+
+  return SpanVectorAnd(result, SpanVectorSet(0xFFFFu));
+}
+
+/// Returns true if any texel or palette entry which the span could sample lies within the span itself. Texels for a
+/// group of pixels are fetched before any of them are written, so these spans must be shaded a pixel at a time.
+static bool DoesSpanOverlapTextureRead(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width)
+{
+  const auto overlaps_span = [x, width](u32 start, u32 size) {
+    return (((x - start) % VRAM_WIDTH) < size || ((start - x) % VRAM_WIDTH) < width);
+  };
+
+  if (((y - cmd->draw_mode.GetTexturePageBaseY()) % VRAM_HEIGHT) < TEXTURE_PAGE_HEIGHT &&
+      overlaps_span(cmd->draw_mode.GetTexturePageBaseX(),
+                    GPUDrawModeReg::texture_page_widths[static_cast<u8>(cmd->draw_mode.texture_mode.GetValue())]))
+  {
+    return true;
+  }
+
+  return (cmd->draw_mode.IsUsingPalette() && cmd->palette.GetYBase() == y &&
+          overlaps_span(cmd->palette.GetXBase(),
+                        (cmd->draw_mode.texture_mode == GPUTextureMode::Palette4Bit) ? 16u : 256u));
+}
+
+template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
+         bool dithering_enable>
+void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadeSpanVector(const GPUBackendDrawPolygonCommand* cmd, u32 x, u32 y,
+                                                           u32 count, i_group ig, const i_deltas& idl)
+{
+  static constexpr u32 HALF = VECTOR_SPAN_PIXELS / 2;
+
+  // Lane i of each interpolant holds the value for pixel x + i, and advances by eight pixels per iteration.
+  const auto make_lanes = [](u32 base, u32 delta, SpanVector* lanes, SpanVector* step) {
+    lanes[0] = SpanVectorSet(base, base + delta, base + delta * 2, base + delta * 3);
+    lanes[1] = SpanVectorAdd(lanes[0], SpanVectorSet(delta * HALF));
+    *step = SpanVectorSet(delta * VECTOR_SPAN_PIXELS);
+  };
+
+  SpanVector r[2], g[2], b[2], u[2], v[2];
+  SpanVector r_step, g_step, b_step, u_step, v_step;
+  make_lanes(ig.r, shading_enable ? idl.dr_dx : 0, r, &r_step);
+  make_lanes(ig.g, shading_enable ? idl.dg_dx : 0, g, &g_step);
+  make_lanes(ig.b, shading_enable ? idl.db_dx : 0, b, &b_step);
+  make_lanes(ig.u, texture_enable ? idl.du_dx : 0, u, &u_step);
+  make_lanes(ig.v, texture_enable ? idl.dv_dx : 0, v, &v_step);
+
+  // x advances by a multiple of four per half, so the dither offsets are the same for every vector in the span.
+  const s32* dither_row = DITHER_MATRIX[y & 3u];
+  const SpanVector dither =
+    dithering_enable ? SpanVectorSet(static_cast<u32>(dither_row[x & 3u]), static_cast<u32>(dither_row[(x + 1) & 3u]),
+                                     static_cast<u32>(dither_row[(x + 2) & 3u]),
+                                     static_cast<u32>(dither_row[(x + 3) & 3u])) :
+                       SpanVectorSet(0);
+
+  const GPUTransparencyMode transparency_mode = cmd->draw_mode.transparency_mode;
+  const SpanVector zero = SpanVectorSet(0);
+  const SpanVector all_ones = SpanVectorSet(0xFFFFFFFFu);
+  const SpanVector bit15 = SpanVectorSet(0x8000u);
+  const SpanVector channel_mask = SpanVectorSet(0x1Fu);
+  const SpanVector mask_and = SpanVectorSet(cmd->params.GetMaskAND());
+  const SpanVector mask_or = SpanVectorSet(cmd->params.GetMaskOR());
+
+  u16* vram_ptr = GetPixelPtr(x, y);
+  for (u32 i = 0; i < count; i += VECTOR_SPAN_PIXELS, vram_ptr += VECTOR_SPAN_PIXELS)
+  {
+    alignas(VECTOR_ALIGNMENT) u32 texels[VECTOR_SPAN_PIXELS];
+    if constexpr (texture_enable)
+    {
+      alignas(VECTOR_ALIGNMENT) u32 texcoord_x[VECTOR_SPAN_PIXELS];
+      alignas(VECTOR_ALIGNMENT) u32 texcoord_y[VECTOR_SPAN_PIXELS];
+      for (u32 j = 0; j < 2; j++)
+      {
+        SpanVectorStore(&texcoord_x[j * HALF], SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(u[j]));
+        SpanVectorStore(&texcoord_y[j * HALF], SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(v[j]));
+      }
+      for (u32 j = 0; j < VECTOR_SPAN_PIXELS; j++)
+        texels[j] = SampleTexture(cmd, Truncate8(texcoord_x[j]), Truncate8(texcoord_y[j]));
+    }
+
+    SpanVector bg[2];
+    SpanVectorLoadPixels(vram_ptr, &bg[0], &bg[1]);
+
+    SpanVector result[2];
+    for (u32 j = 0; j < 2; j++)
+    {
+      SpanVector color, write_mask;
+      if constexpr (texture_enable)
+      {
+        const SpanVector texel = SpanVectorLoad(&texels[j * HALF]);
+        write_mask = SpanVectorXor(SpanVectorCmpEq(texel, zero), all_ones);
+
+        if constexpr (raw_texture_enable)
+        {
+          color = texel;
+        }
+        else
+        {
+          const SpanVector tr = SpanVectorAnd(texel, channel_mask);
+          const SpanVector tg = SpanVectorAnd(SpanVectorSrl<5>(texel), channel_mask);
+          const SpanVector tb = SpanVectorAnd(SpanVectorSrl<10>(texel), channel_mask);
+          const SpanVector cr = SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(r[j]);
+          const SpanVector cg = SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(g[j]);
+          const SpanVector cb = SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(b[j]);
+          color = SpanVectorOr(
+            SpanVectorOr(SpanVectorDither(SpanVectorSrl<4>(SpanVectorMul16(tr, cr)), dither),
+                         SpanVectorSll<5>(SpanVectorDither(SpanVectorSrl<4>(SpanVectorMul16(tg, cg)), dither))),
+            SpanVectorOr(SpanVectorSll<10>(SpanVectorDither(SpanVectorSrl<4>(SpanVectorMul16(tb, cb)), dither)),
+                         SpanVectorAnd(texel, bit15)));
+        }
+      }
+      else
+      {
+        write_mask = all_ones;
+
+        // Non-textured transparent polygons don't set bit 15, but are treated as transparent.
+        color = SpanVectorOr(
+          SpanVectorOr(SpanVectorDither(SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(r[j]), dither),
+                       SpanVectorSll<5>(SpanVectorDither(SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(g[j]), dither))),
+          SpanVectorSll<10>(SpanVectorDither(SpanVectorSrl<COORD_FBS + COORD_POST_PADDING>(b[j]), dither)));
+        if constexpr (transparency_enable)
+          color = SpanVectorOr(color, bit15);
+      }
+
+      if constexpr (transparency_enable)
+      {
+        const SpanVector blended = SpanVectorBlend(transparency_mode, color, bg[j]);
+        if constexpr (texture_enable)
+          color = SpanVectorSelect(SpanVectorCmpEq(SpanVectorAnd(color, bit15), zero), color, blended);
+        else
+          color = SpanVectorAnd(blended, SpanVectorSet(0x7FFFu));
+      }
+
+      write_mask = SpanVectorAnd(write_mask, SpanVectorCmpEq(SpanVectorAnd(bg[j], mask_and), zero));
+      result[j] = SpanVectorSelect(write_mask, SpanVectorOr(color, mask_or), bg[j]);
+    }
+
+    SpanVectorStorePixels(vram_ptr, result[0], result[1]);
+
+    for (u32 j = 0; j < 2; j++)
+    {
+      if constexpr (shading_enable)
+      {
+        r[j] = SpanVectorAdd(r[j], r_step);
+        g[j] = SpanVectorAdd(g[j], g_step);
+        b[j] = SpanVectorAdd(b[j], b_step);
+      }
+      if constexpr (texture_enable)
+      {
+        u[j] = SpanVectorAdd(u[j], u_step);
+        v[j] = SpanVectorAdd(v[j], v_step);
+      }
+    }
+  }
+}
+
+#endif
+
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                              const i_deltas& idl)
+void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y,
+                              s32 x_start, s32 x_bound, i_group ig, const i_deltas& idl)
 {
   if (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u))
     return;
@@ -368,16 +837,16 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   s32 w = x_bound - x_start;
   s32 x = TruncateGPUVertexPosition(x_start);
 
-  if (x < static_cast<s32>(m_drawing_area.left))
+  if (x < static_cast<s32>(clip.left))
   {
-    s32 delta = static_cast<s32>(m_drawing_area.left) - x;
+    s32 delta = static_cast<s32>(clip.left) - x;
     x_ig_adjust += delta;
     x += delta;
     w -= delta;
   }
 
-  if ((x + w) > (static_cast<s32>(m_drawing_area.right) + 1))
-    w = static_cast<s32>(m_drawing_area.right) + 1 - x;
+  if ((x + w) > (static_cast<s32>(clip.right) + 1))
+    w = static_cast<s32>(clip.right) + 1 - x;
 
   if (w <= 0)
     return;
@@ -385,7 +854,21 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, x_ig_adjust);
   AddIDeltas_DY<shading_enable, texture_enable>(ig, idl, y);
 
-  do
+#ifdef VECTOR_SPAN_SHADING
+  if (w >= static_cast<s32>(VECTOR_SPAN_PIXELS) &&
+      (!texture_enable ||
+       !DoesSpanOverlapTextureRead(cmd, static_cast<u32>(x), static_cast<u32>(y), static_cast<u32>(w))))
+  {
+    const s32 vector_w = static_cast<s32>(Common::AlignDownPow2(static_cast<u32>(w), VECTOR_SPAN_PIXELS));
+    ShadeSpanVector<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+      cmd, static_cast<u32>(x), static_cast<u32>(y), static_cast<u32>(vector_w), ig, idl);
+    AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, static_cast<u32>(vector_w));
+    x += vector_w;
+    w -= vector_w;
+  }
+#endif
+
+  while (w > 0)
   {
     const u32 r = ig.r >> (COORD_FBS + COORD_POST_PADDING);
     const u32 g = ig.g >> (COORD_FBS + COORD_POST_PADDING);
@@ -398,13 +881,14 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
       Truncate8(v));
 
     x++;
+    w--;
     AddIDeltas_DX<shading_enable, texture_enable>(ig, idl);
-  } while (--w > 0);
+  }
 }
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
+void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
                                   const GPUBackendDrawPolygonCommand::Vertex* v0,
                                   const GPUBackendDrawPolygonCommand::Vertex* v1,
                                   const GPUBackendDrawPolygonCommand::Vertex* v2)
@@ -562,14 +1046,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
 
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y < static_cast<s32>(m_drawing_area.top))
+        if (y < static_cast<s32>(clip.top))
           break;
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           continue;
 
         DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-          cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+          cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
       }
     }
     else
@@ -578,14 +1062,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
       {
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           break;
 
-        if (y >= static_cast<s32>(m_drawing_area.top))
+        if (y >= static_cast<s32>(clip.top))
         {
 
           DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-            cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+            cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
         }
 
         yi++;
@@ -630,8 +1114,8 @@ static ALWAYS_INLINE_RELEASE s64 LineDivide(s64 delta, s32 dk)
 }
 
 template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                              const GPUBackendDrawLineCommand::Vertex* p1)
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                              const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1)
 {
   const s32 i_dx = std::abs(p1->x - p0->x);
   const s32 i_dy = std::abs(p1->y - p0->y);
@@ -691,8 +1175,8 @@ void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBac
     const s32 y = (cur_point.y >> Line_XY_FractBits) & 2047;
 
     if ((!cmd->params.interlaced_rendering || cmd->params.active_line_lsb != (Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(m_drawing_area.left) && x <= static_cast<s32>(m_drawing_area.right) &&
-        y >= static_cast<s32>(m_drawing_area.top) && y <= static_cast<s32>(m_drawing_area.bottom))
+        x >= static_cast<s32>(clip.left) && x <= static_cast<s32>(clip.right) && y >= static_cast<s32>(clip.top) &&
+        y <= static_cast<s32>(clip.bottom))
     {
       const u8 r = shading_enable ? static_cast<u8>(cur_point.r >> Line_RGB_FractBits) : p0->r;
       const u8 g = shading_enable ? static_cast<u8>(cur_point.g >> Line_RGB_FractBits) : p0->g;
@@ -868,10 +1352,283 @@ void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wi
   }
 }
 
-void GPU_SW_Backend::FlushRender() {}
+void GPU_SW_Backend::FlushRender()
+{
+  FlushBatch();
+}
 
 void GPU_SW_Backend::DrawingAreaChanged() {}
 
+u32 GPU_SW_Backend::GetWorkerCountForThreads(u32 num_threads)
+{
+  // The backend thread rasterizes bands too, so it counts as one of the threads.
+  return (num_threads > 1) ? std::min(num_threads - 1, MAX_WORKER_THREADS) : 0;
+}
+
+void GPU_SW_Backend::StartWorkerThreads(u32 num_threads)
+{
+  const u32 num_workers = GetWorkerCountForThreads(num_threads);
+  if (num_workers == 0)
+    return;
+
+  m_batch_data.reserve(MAX_BATCH_SIZE + sizeof(GPUBackendDrawPolygonCommand) +
+                       (sizeof(GPUBackendDrawPolygonCommand::Vertex) * 4));
+  m_batch_dirty_rect.SetInvalid();
+  m_batch_page_rect.SetInvalid();
+  m_batch_palette_rect.SetInvalid();
+  m_batch_num_commands = 0;
+
+  m_workers_shutdown.store(false);
+  m_workers = std::make_unique<WorkerThread[]>(num_workers);
+  m_num_workers = num_workers;
+  for (u32 i = 0; i < num_workers; i++)
+    m_workers[i].thread.Start([this, i]() { WorkerThreadEntryPoint(i); });
+
+  Log_InfoFmt("Software renderer using {} worker threads.", num_workers);
+}
+
+void GPU_SW_Backend::StopWorkerThreads()
+{
+  if (m_num_workers == 0)
+    return;
+
+  m_workers_shutdown.store(true);
+  for (u32 i = 0; i < m_num_workers; i++)
+    m_workers[i].wake_semaphore.Post();
+  for (u32 i = 0; i < m_num_workers; i++)
+    m_workers[i].thread.Join();
+
+  m_workers.reset();
+  m_num_workers = 0;
+  m_batch_data = {};
+  for (std::vector<u32>& bin : m_batch_bins)
+    bin = {};
+
+  Log_InfoPrint("Software renderer worker threads stopped.");
+}
+
+void GPU_SW_Backend::WorkerThreadEntryPoint(u32 index)
+{
+  Threading::SetNameOfCurrentThread(TinyString::from_format("SW Renderer Worker {}", index).c_str());
+
+  WorkerThread& worker = m_workers[index];
+  for (;;)
+  {
+    worker.wake_semaphore.Wait();
+    if (m_workers_shutdown.load())
+      break;
+
+    DrawBatchBands();
+    m_workers_done_semaphore.Post();
+  }
+}
+
+bool GPU_SW_Backend::GetDrawCommandBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds) const
+{
+  // Coordinates outside this range wrap around in the rasterizer, so we can't cheaply bound them.
+  static constexpr s32 MIN_COORD = -1024;
+  static constexpr s32 MAX_COORD = 1023;
+
+  s32 min_x, min_y, max_x, max_y;
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+    {
+      const GPUBackendDrawPolygonCommand* pcmd = static_cast<const GPUBackendDrawPolygonCommand*>(cmd);
+      min_x = max_x = pcmd->vertices[0].x;
+      min_y = max_y = pcmd->vertices[0].y;
+      for (u32 i = 1; i < pcmd->num_vertices; i++)
+      {
+        min_x = std::min(min_x, pcmd->vertices[i].x);
+        max_x = std::max(max_x, pcmd->vertices[i].x);
+        min_y = std::min(min_y, pcmd->vertices[i].y);
+        max_y = std::max(max_y, pcmd->vertices[i].y);
+      }
+
+      // Edge stepping can round a pixel past the vertices.
+      min_x--;
+      max_x++;
+    }
+    break;
+
+    case GPUBackendCommandType::DrawRectangle:
+    {
+      const GPUBackendDrawRectangleCommand* rcmd = static_cast<const GPUBackendDrawRectangleCommand*>(cmd);
+      if (rcmd->width == 0 || rcmd->height == 0)
+        return false;
+
+      // Rectangle positions are already truncated, and do not wrap.
+      const s32 left = std::max(rcmd->x, static_cast<s32>(m_drawing_area.left));
+      const s32 top = std::max(rcmd->y, static_cast<s32>(m_drawing_area.top));
+      const s32 right = std::min(rcmd->x + static_cast<s32>(rcmd->width) - 1, static_cast<s32>(m_drawing_area.right));
+      const s32 bottom =
+        std::min(rcmd->y + static_cast<s32>(rcmd->height) - 1, static_cast<s32>(m_drawing_area.bottom));
+      if (left > right || top > bottom)
+        return false;
+
+      bounds->Set(static_cast<u32>(left), static_cast<u32>(top), static_cast<u32>(right) + 1,
+                  static_cast<u32>(bottom) + 1);
+      return true;
+    }
+
+    case GPUBackendCommandType::DrawLine:
+    {
+      const GPUBackendDrawLineCommand* lcmd = static_cast<const GPUBackendDrawLineCommand*>(cmd);
+      min_x = max_x = lcmd->vertices[0].x;
+      min_y = max_y = lcmd->vertices[0].y;
+      for (u32 i = 1; i < lcmd->num_vertices; i++)
+      {
+        min_x = std::min(min_x, lcmd->vertices[i].x);
+        max_x = std::max(max_x, lcmd->vertices[i].x);
+        min_y = std::min(min_y, lcmd->vertices[i].y);
+        max_y = std::max(max_y, lcmd->vertices[i].y);
+      }
+    }
+    break;
+
+    default:
+      return false;
+  }
+
+  if (min_x < MIN_COORD || max_x > MAX_COORD || min_y < MIN_COORD || max_y > MAX_COORD)
+  {
+    bounds->Set(m_drawing_area.left, m_drawing_area.top, m_drawing_area.right + 1, m_drawing_area.bottom + 1);
+    return true;
+  }
+
+  const s32 left = std::max(min_x, static_cast<s32>(m_drawing_area.left));
+  const s32 top = std::max(min_y, static_cast<s32>(m_drawing_area.top));
+  const s32 right = std::min(max_x, static_cast<s32>(m_drawing_area.right));
+  const s32 bottom = std::min(max_y, static_cast<s32>(m_drawing_area.bottom));
+  if (left > right || top > bottom)
+    return false;
+
+  bounds->Set(static_cast<u32>(left), static_cast<u32>(top), static_cast<u32>(right) + 1,
+              static_cast<u32>(bottom) + 1);
+  return true;
+}
+
+bool GPU_SW_Backend::GetTextureReadRectangles(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* page_rc,
+                                              Common::Rectangle<u32>* palette_rc)
+{
+  if (cmd->type == GPUBackendCommandType::DrawLine || !cmd->rc.texture_enable)
+    return false;
+
+  // Pages and palettes which wrap around the edge of VRAM are treated as spanning the full width.
+  *page_rc = cmd->draw_mode.GetTexturePageRectangle();
+  if (page_rc->right > VRAM_WIDTH)
+  {
+    page_rc->left = 0;
+    page_rc->right = VRAM_WIDTH;
+  }
+
+  if (cmd->draw_mode.IsUsingPalette())
+  {
+    *palette_rc = cmd->palette.GetRectangle(cmd->draw_mode.texture_mode);
+    if (palette_rc->right > VRAM_WIDTH)
+    {
+      palette_rc->left = 0;
+      palette_rc->right = VRAM_WIDTH;
+    }
+  }
+  else
+  {
+    palette_rc->SetInvalid();
+  }
+
+  return true;
+}
+
+void GPU_SW_Backend::QueueDrawCommand(const GPUBackendDrawCommand* cmd)
+{
+  Common::Rectangle<u32> bounds;
+  if (!GetDrawCommandBounds(cmd, &bounds))
+    return;
+
+  // Bands are drawn out of order relative to each other, so a texture read can't depend on a write in the same
+  // batch, and a write can't clobber texels which an earlier draw in the batch is yet to read.
+  Common::Rectangle<u32> page_rc, palette_rc;
+  const bool textured = GetTextureReadRectangles(cmd, &page_rc, &palette_rc);
+  if (m_batch_num_commands > 0 &&
+      ((textured && (page_rc.Intersects(m_batch_dirty_rect) || palette_rc.Intersects(m_batch_dirty_rect))) ||
+       bounds.Intersects(m_batch_page_rect) || bounds.Intersects(m_batch_palette_rect)))
+  {
+    FlushBatch();
+  }
+
+  // Primitives which sample their own output depend on the serial rasterization order.
+  if (textured && (page_rc.Intersects(bounds) || palette_rc.Intersects(bounds)))
+  {
+    FlushBatch();
+    DrawCommand(cmd, m_drawing_area);
+    return;
+  }
+
+  const u32 offset = static_cast<u32>(m_batch_data.size());
+  m_batch_data.resize(offset + cmd->size);
+  std::memcpy(&m_batch_data[offset], cmd, cmd->size);
+
+  const u32 first_band = bounds.top / BAND_HEIGHT;
+  const u32 last_band = (bounds.bottom - 1) / BAND_HEIGHT;
+  for (u32 band = first_band; band <= last_band; band++)
+    m_batch_bins[band].push_back(offset);
+
+  m_batch_dirty_rect.Include(bounds);
+  if (textured)
+  {
+    m_batch_page_rect.Include(page_rc);
+    m_batch_palette_rect.Include(palette_rc);
+  }
+  m_batch_num_commands++;
+
+  if (m_batch_data.size() >= MAX_BATCH_SIZE)
+    FlushBatch();
+}
+
+void GPU_SW_Backend::FlushBatch()
+{
+  if (m_batch_num_commands == 0)
+    return;
+
+  m_batch_next_band.store(0);
+  for (u32 i = 0; i < m_num_workers; i++)
+    m_workers[i].wake_semaphore.Post();
+
+  DrawBatchBands();
+
+  for (u32 i = 0; i < m_num_workers; i++)
+    m_workers_done_semaphore.Wait();
+
+  m_batch_data.clear();
+  for (std::vector<u32>& bin : m_batch_bins)
+    bin.clear();
+  m_batch_dirty_rect.SetInvalid();
+  m_batch_page_rect.SetInvalid();
+  m_batch_palette_rect.SetInvalid();
+  m_batch_num_commands = 0;
+}
+
+void GPU_SW_Backend::DrawBatchBands()
+{
+  for (;;)
+  {
+    const u32 band = m_batch_next_band.fetch_add(1, std::memory_order_relaxed);
+    if (band >= NUM_BANDS)
+      break;
+
+    const std::vector<u32>& bin = m_batch_bins[band];
+    if (bin.empty())
+      continue;
+
+    const u32 band_top = band * BAND_HEIGHT;
+    const u32 band_bottom = band_top + BAND_HEIGHT - 1;
+    const Common::Rectangle<u32> clip(m_drawing_area.left, std::max(m_drawing_area.top, band_top),
+                                      m_drawing_area.right, std::min(m_drawing_area.bottom, band_bottom));
+    for (const u32 offset : bin)
+      DrawCommand(reinterpret_cast<const GPUBackendDrawCommand*>(&m_batch_data[offset]), clip);
+  }
+}
+
 GPU_SW_Backend::DrawLineFunction GPU_SW_Backend::GetDrawLineFunction(bool shading_enable, bool transparency_enable,
                                                                      bool dithering_enable)
 {
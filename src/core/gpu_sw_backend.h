@@ -4,6 +4,7 @@
 #pragma once
 #include "gpu_backend.h"
 #include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -14,7 +15,9 @@ public:
   ~GPU_SW_Backend() override;
 
   bool Initialize(bool force_thread) override;
+  void UpdateSettings() override;
   void Reset() override;
+  void Shutdown() override;
 
   ALWAYS_INLINE_RELEASE u16 GetPixel(const u32 x, const u32 y) const { return g_vram[VRAM_WIDTH * y + x]; }
   ALWAYS_INLINE_RELEASE const u16* GetPixelPtr(const u32 x, const u32 y) const { return &g_vram[VRAM_WIDTH * y + x]; }
@@ -98,17 +101,56 @@ protected:
   void FlushRender() override;
   void DrawingAreaChanged() override;
 
+  /// Rasterizes a draw command, only touching pixels inside the inclusive clip rectangle.
+  void DrawCommand(const GPUBackendDrawCommand* cmd, const Common::Rectangle<u32>& clip);
+
+  //////////////////////////////////////////////////////////////////////////
+  // Multi-threaded rasterization
+  //////////////////////////////////////////////////////////////////////////
+  // Draws are copied into a batch and binned by the horizontal band of VRAM rows they touch. Each band is then
+  // rasterized by a single thread in submission order, so the result is identical to drawing serially. Textured
+  // draws which sample from an area written earlier in the batch, and draws which overwrite an area sampled
+  // earlier in the batch, flush it first.
+  static constexpr u32 BAND_HEIGHT = 16;
+  static constexpr u32 NUM_BANDS = VRAM_HEIGHT / BAND_HEIGHT;
+  static constexpr u32 MAX_BATCH_SIZE = 256 * 1024;
+  static constexpr u32 MAX_WORKER_THREADS = 16;
+
+  struct WorkerThread
+  {
+    Threading::Thread thread;
+    Threading::KernelSemaphore wake_semaphore;
+  };
+
+  ALWAYS_INLINE bool IsBatchingDraws() const { return (m_num_workers > 0); }
+
+  static u32 GetWorkerCountForThreads(u32 num_threads);
+  void StartWorkerThreads(u32 num_threads);
+  void StopWorkerThreads();
+  void WorkerThreadEntryPoint(u32 index);
+
+  bool GetDrawCommandBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds) const;
+  static bool GetTextureReadRectangles(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* page_rc,
+                                       Common::Rectangle<u32>* palette_rc);
+
+  void QueueDrawCommand(const GPUBackendDrawCommand* cmd);
+  void FlushBatch();
+  void DrawBatchBands();
+
   //////////////////////////////////////////////////////////////////////////
   // Rasterization
   //////////////////////////////////////////////////////////////////////////
+  u16 SampleTexture(const GPUBackendDrawCommand* cmd, u8 texcoord_x, u8 texcoord_y) const;
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
   void ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x,
                   u8 texcoord_y);
 
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd);
+  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip);
 
-  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd);
+  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd,
+                                                         const Common::Rectangle<u32>& clip);
   DrawRectangleFunction GetDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
                                                  bool transparency_enable);
 
@@ -142,15 +184,22 @@ protected:
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                const i_deltas& idl);
+  void ShadeSpanVector(const GPUBackendDrawPolygonCommand* cmd, u32 x, u32 y, u32 count, i_group ig,
+                       const i_deltas& idl);
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
-                    const GPUBackendDrawPolygonCommand::Vertex* v1, const GPUBackendDrawPolygonCommand::Vertex* v2);
+  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y, s32 x_start,
+                s32 x_bound, i_group ig, const i_deltas& idl);
+
+  template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
+           bool dithering_enable>
+  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
+                    const GPUBackendDrawPolygonCommand::Vertex* v0, const GPUBackendDrawPolygonCommand::Vertex* v1,
+                    const GPUBackendDrawPolygonCommand::Vertex* v2);
 
   using DrawTriangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawPolygonCommand* cmd,
+                                                        const Common::Rectangle<u32>& clip,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v0,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v1,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v2);
@@ -158,11 +207,25 @@ protected:
                                                bool transparency_enable, bool dithering_enable);
 
   template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-  void DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                const GPUBackendDrawLineCommand::Vertex* p1);
+  void DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1);
 
   using DrawLineFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawLineCommand* cmd,
+                                                    const Common::Rectangle<u32>& clip,
                                                     const GPUBackendDrawLineCommand::Vertex* p0,
                                                     const GPUBackendDrawLineCommand::Vertex* p1);
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
+
+  std::unique_ptr<WorkerThread[]> m_workers;
+  u32 m_num_workers = 0;
+  std::atomic_bool m_workers_shutdown{false};
+  Threading::KernelSemaphore m_workers_done_semaphore;
+
+  std::vector<u8> m_batch_data;
+  std::array<std::vector<u32>, NUM_BANDS> m_batch_bins;
+  Common::Rectangle<u32> m_batch_dirty_rect;
+  Common::Rectangle<u32> m_batch_page_rect;
+  Common::Rectangle<u32> m_batch_palette_rect;
+  u32 m_batch_num_commands = 0;
+  std::atomic<u32> m_batch_next_band{0};
 };
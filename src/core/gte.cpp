@@ -14,10 +14,16 @@
 
 #include "common/assert.h"
 #include "common/bitutils.h"
+#include "common/error.h"
+#include "common/log.h"
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <numeric>
+#include <random>
+
+Log_SetChannel(GTE);
 
 namespace GTE {
 
@@ -35,6 +41,26 @@ static u32 s_custom_aspect_ratio_numerator;
 static u32 s_custom_aspect_ratio_denominator;
 static float s_custom_aspect_ratio_f;
 
+static constexpr std::array<u8, 257> s_unr_table = {{
+  0xFF, 0xFD, 0xFB, 0xF9, 0xF7, 0xF5, 0xF3, 0xF1, 0xEF, 0xEE, 0xEC, 0xEA, 0xE8, 0xE6, 0xE4, 0xE3, //
+  0xE1, 0xDF, 0xDD, 0xDC, 0xDA, 0xD8, 0xD6, 0xD5, 0xD3, 0xD1, 0xD0, 0xCE, 0xCD, 0xCB, 0xC9, 0xC8, //  00h..3Fh
+  0xC6, 0xC5, 0xC3, 0xC1, 0xC0, 0xBE, 0xBD, 0xBB, 0xBA, 0xB8, 0xB7, 0xB5, 0xB4, 0xB2, 0xB1, 0xB0, //
+  0xAE, 0xAD, 0xAB, 0xAA, 0xA9, 0xA7, 0xA6, 0xA4, 0xA3, 0xA2, 0xA0, 0x9F, 0x9E, 0x9C, 0x9B, 0x9A, //
+  0x99, 0x97, 0x96, 0x95, 0x94, 0x92, 0x91, 0x90, 0x8F, 0x8D, 0x8C, 0x8B, 0x8A, 0x89, 0x87, 0x86, //
+  0x85, 0x84, 0x83, 0x82, 0x81, 0x7F, 0x7E, 0x7D, 0x7C, 0x7B, 0x7A, 0x79, 0x78, 0x77, 0x75, 0x74, //  40h..7Fh
+  0x73, 0x72, 0x71, 0x70, 0x6F, 0x6E, 0x6D, 0x6C, 0x6B, 0x6A, 0x69, 0x68, 0x67, 0x66, 0x65, 0x64, //
+  0x63, 0x62, 0x61, 0x60, 0x5F, 0x5E, 0x5D, 0x5D, 0x5C, 0x5B, 0x5A, 0x59, 0x58, 0x57, 0x56, 0x55, //
+  0x54, 0x53, 0x53, 0x52, 0x51, 0x50, 0x4F, 0x4E, 0x4D, 0x4D, 0x4C, 0x4B, 0x4A, 0x49, 0x48, 0x48, //
+  0x47, 0x46, 0x45, 0x44, 0x43, 0x43, 0x42, 0x41, 0x40, 0x3F, 0x3F, 0x3E, 0x3D, 0x3C, 0x3C, 0x3B, //  80h..BFh
+  0x3A, 0x39, 0x39, 0x38, 0x37, 0x36, 0x36, 0x35, 0x34, 0x33, 0x33, 0x32, 0x31, 0x31, 0x30, 0x2F, //
+  0x2E, 0x2E, 0x2D, 0x2C, 0x2C, 0x2B, 0x2A, 0x2A, 0x29, 0x28, 0x28, 0x27, 0x26, 0x26, 0x25, 0x24, //
+  0x24, 0x23, 0x22, 0x22, 0x21, 0x20, 0x20, 0x1F, 0x1E, 0x1E, 0x1D, 0x1D, 0x1C, 0x1B, 0x1B, 0x1A, //
+  0x19, 0x19, 0x18, 0x18, 0x17, 0x16, 0x16, 0x15, 0x15, 0x14, 0x14, 0x13, 0x12, 0x12, 0x11, 0x11, //  C0h..FFh
+  0x10, 0x0F, 0x0F, 0x0E, 0x0E, 0x0D, 0x0D, 0x0C, 0x0C, 0x0B, 0x0A, 0x0A, 0x09, 0x09, 0x08, 0x08, //
+  0x07, 0x07, 0x06, 0x06, 0x05, 0x05, 0x04, 0x04, 0x03, 0x03, 0x02, 0x02, 0x01, 0x01, 0x00, 0x00, //
+  0x00 // <-- one extra table entry (for "(d-7FC0h)/80h"=100h)
+}};
+
 #define REGS CPU::g_state.gte_regs
 
 ALWAYS_INLINE static u32 CountLeadingBits(u32 value)
@@ -173,6 +199,7 @@ static void MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy,
 static void MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
 
 static void InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm);
+static void PushPreciseSXY(s64 x, s64 y, s64 z, u8 shift, bool lm);
 static void RTPS(const s16 V[3], u8 shift, bool lm, bool last);
 static void NCS(const s16 V[3], u8 shift, bool lm);
 static void NCCS(const s16 V[3], u8 shift, bool lm);
@@ -397,6 +424,11 @@ u32* GTE::GetRegisterPtr(u32 index)
   return &REGS.r32[index];
 }
 
+const u8* GTE::GetUNRTable()
+{
+  return s_unr_table.data();
+}
+
 ALWAYS_INLINE void GTE::SetOTZ(s32 value)
 {
   if (value < 0)
@@ -486,28 +518,8 @@ ALWAYS_INLINE u32 GTE::UNRDivide(u32 lhs, u32 rhs)
   lhs <<= shift;
   rhs <<= shift;
 
-  static constexpr std::array<u8, 257> unr_table = {{
-    0xFF, 0xFD, 0xFB, 0xF9, 0xF7, 0xF5, 0xF3, 0xF1, 0xEF, 0xEE, 0xEC, 0xEA, 0xE8, 0xE6, 0xE4, 0xE3, //
-    0xE1, 0xDF, 0xDD, 0xDC, 0xDA, 0xD8, 0xD6, 0xD5, 0xD3, 0xD1, 0xD0, 0xCE, 0xCD, 0xCB, 0xC9, 0xC8, //  00h..3Fh
-    0xC6, 0xC5, 0xC3, 0xC1, 0xC0, 0xBE, 0xBD, 0xBB, 0xBA, 0xB8, 0xB7, 0xB5, 0xB4, 0xB2, 0xB1, 0xB0, //
-    0xAE, 0xAD, 0xAB, 0xAA, 0xA9, 0xA7, 0xA6, 0xA4, 0xA3, 0xA2, 0xA0, 0x9F, 0x9E, 0x9C, 0x9B, 0x9A, //
-    0x99, 0x97, 0x96, 0x95, 0x94, 0x92, 0x91, 0x90, 0x8F, 0x8D, 0x8C, 0x8B, 0x8A, 0x89, 0x87, 0x86, //
-    0x85, 0x84, 0x83, 0x82, 0x81, 0x7F, 0x7E, 0x7D, 0x7C, 0x7B, 0x7A, 0x79, 0x78, 0x77, 0x75, 0x74, //  40h..7Fh
-    0x73, 0x72, 0x71, 0x70, 0x6F, 0x6E, 0x6D, 0x6C, 0x6B, 0x6A, 0x69, 0x68, 0x67, 0x66, 0x65, 0x64, //
-    0x63, 0x62, 0x61, 0x60, 0x5F, 0x5E, 0x5D, 0x5D, 0x5C, 0x5B, 0x5A, 0x59, 0x58, 0x57, 0x56, 0x55, //
-    0x54, 0x53, 0x53, 0x52, 0x51, 0x50, 0x4F, 0x4E, 0x4D, 0x4D, 0x4C, 0x4B, 0x4A, 0x49, 0x48, 0x48, //
-    0x47, 0x46, 0x45, 0x44, 0x43, 0x43, 0x42, 0x41, 0x40, 0x3F, 0x3F, 0x3E, 0x3D, 0x3C, 0x3C, 0x3B, //  80h..BFh
-    0x3A, 0x39, 0x39, 0x38, 0x37, 0x36, 0x36, 0x35, 0x34, 0x33, 0x33, 0x32, 0x31, 0x31, 0x30, 0x2F, //
-    0x2E, 0x2E, 0x2D, 0x2C, 0x2C, 0x2B, 0x2A, 0x2A, 0x29, 0x28, 0x28, 0x27, 0x26, 0x26, 0x25, 0x24, //
-    0x24, 0x23, 0x22, 0x22, 0x21, 0x20, 0x20, 0x1F, 0x1E, 0x1E, 0x1D, 0x1D, 0x1C, 0x1B, 0x1B, 0x1A, //
-    0x19, 0x19, 0x18, 0x18, 0x17, 0x16, 0x16, 0x15, 0x15, 0x14, 0x14, 0x13, 0x12, 0x12, 0x11, 0x11, //  C0h..FFh
-    0x10, 0x0F, 0x0F, 0x0E, 0x0E, 0x0D, 0x0D, 0x0C, 0x0C, 0x0B, 0x0A, 0x0A, 0x09, 0x09, 0x08, 0x08, //
-    0x07, 0x07, 0x06, 0x06, 0x05, 0x05, 0x04, 0x04, 0x03, 0x03, 0x02, 0x02, 0x01, 0x01, 0x00, 0x00, //
-    0x00 // <-- one extra table entry (for "(d-7FC0h)/80h"=100h)
-  }};
-
   const u32 divisor = rhs | 0x8000;
-  const s32 x = static_cast<s32>(0x101 + ZeroExtend32(unr_table[((divisor & 0x7FFF) + 0x40) >> 7]));
+  const s32 x = static_cast<s32>(0x101 + ZeroExtend32(s_unr_table[((divisor & 0x7FFF) + 0x40) >> 7]));
   const s32 d = ((static_cast<s32>(ZeroExtend32(divisor)) * -x) + 0x80) >> 8;
   const u32 recip = static_cast<u32>(((x * (0x20000 + d)) + 0x80) >> 8);
 
@@ -518,7 +530,7 @@ ALWAYS_INLINE u32 GTE::UNRDivide(u32 lhs, u32 rhs)
   return std::min<u32>(0x1FFFF, result);
 }
 
-void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
+ALWAYS_INLINE void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
@@ -534,7 +546,8 @@ void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8
 #undef M
 }
 
-void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
+ALWAYS_INLINE void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift,
+                                  bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
@@ -552,7 +565,8 @@ void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, c
 #undef M
 }
 
-void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
+ALWAYS_INLINE void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz,
+                                       u8 shift, bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
@@ -574,7 +588,7 @@ void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16
 #undef M
 }
 
-void GTE::Execute_MVMVA(Instruction inst)
+ALWAYS_INLINE void GTE::Execute_MVMVA(Instruction inst)
 {
   REGS.FLAG.Clear();
 
@@ -660,7 +674,76 @@ void GTE::Execute_OP(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
+void GTE::PushPreciseSXY(s64 x, s64 y, s64 z, u8 shift, bool lm)
+{
+  float precise_sz3, precise_ir1, precise_ir2;
+
+  if (g_settings.gpu_pgxp_preserve_proj_fp)
+  {
+    precise_sz3 = float(z) / 4096.0f;
+    precise_ir1 = float(x) / (static_cast<float>(1 << shift));
+    precise_ir2 = float(y) / (static_cast<float>(1 << shift));
+    if (lm)
+    {
+      precise_ir1 = std::clamp(precise_ir1, float(IR123_MIN_VALUE), float(IR123_MAX_VALUE));
+      precise_ir2 = std::clamp(precise_ir2, float(IR123_MIN_VALUE), float(IR123_MAX_VALUE));
+    }
+    else
+    {
+      precise_ir1 = std::min(precise_ir1, float(IR123_MAX_VALUE));
+      precise_ir2 = std::min(precise_ir2, float(IR123_MAX_VALUE));
+    }
+  }
+  else
+  {
+    precise_sz3 = float(REGS.SZ3);
+    precise_ir1 = float(REGS.IR1);
+    precise_ir2 = float(REGS.IR2);
+  }
+
+  // this can potentially use increased precision on Z
+  const float precise_z = std::max<float>(float(REGS.H) / 2.0f, precise_sz3);
+  const float precise_h_div_sz = float(REGS.H) / precise_z;
+  const float fofx = float(REGS.OFX) / float(1 << 16);
+  const float fofy = float(REGS.OFY) / float(1 << 16);
+  float precise_x = precise_ir1 * precise_h_div_sz;
+
+  switch (s_aspect_ratio)
+  {
+    case DisplayAspectRatio::MatchWindow:
+    case DisplayAspectRatio::Custom:
+      precise_x = precise_x * s_custom_aspect_ratio_f;
+      break;
+
+    case DisplayAspectRatio::R16_9:
+      precise_x = (precise_x * 3.0f) / 4.0f;
+      break;
+
+    case DisplayAspectRatio::R19_9:
+      precise_x = (precise_x * 12.0f) / 19.0f;
+      break;
+
+    case DisplayAspectRatio::R20_9:
+      precise_x = (precise_x * 3.0f) / 5.0f;
+      break;
+
+    case DisplayAspectRatio::Auto:
+    case DisplayAspectRatio::R4_3:
+    case DisplayAspectRatio::PAR1_1:
+    default:
+      break;
+  }
+
+  precise_x += fofx;
+
+  float precise_y = fofy + (precise_ir2 * precise_h_div_sz);
+
+  precise_x = std::clamp<float>(precise_x, -1024.0f, 1023.0f);
+  precise_y = std::clamp<float>(precise_y, -1024.0f, 1023.0f);
+  CPU::PGXP::GTE_PushSXYZ2f(precise_x, precise_y, precise_z, REGS.dr32[14]);
+}
+
+ALWAYS_INLINE void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
 {
 #define dot3(i)                                                                                                        \
   SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +  \
@@ -729,73 +812,7 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   PushSXY(s32(Sx >> 16), s32(Sy >> 16));
 
   if (g_settings.gpu_pgxp_enable)
-  {
-    float precise_sz3, precise_ir1, precise_ir2;
-
-    if (g_settings.gpu_pgxp_preserve_proj_fp)
-    {
-      precise_sz3 = float(z) / 4096.0f;
-      precise_ir1 = float(x) / (static_cast<float>(1 << shift));
-      precise_ir2 = float(y) / (static_cast<float>(1 << shift));
-      if (lm)
-      {
-        precise_ir1 = std::clamp(precise_ir1, float(IR123_MIN_VALUE), float(IR123_MAX_VALUE));
-        precise_ir2 = std::clamp(precise_ir2, float(IR123_MIN_VALUE), float(IR123_MAX_VALUE));
-      }
-      else
-      {
-        precise_ir1 = std::min(precise_ir1, float(IR123_MAX_VALUE));
-        precise_ir2 = std::min(precise_ir2, float(IR123_MAX_VALUE));
-      }
-    }
-    else
-    {
-      precise_sz3 = float(REGS.SZ3);
-      precise_ir1 = float(REGS.IR1);
-      precise_ir2 = float(REGS.IR2);
-    }
-
-    // this can potentially use increased precision on Z
-    const float precise_z = std::max<float>(float(REGS.H) / 2.0f, precise_sz3);
-    const float precise_h_div_sz = float(REGS.H) / precise_z;
-    const float fofx = float(REGS.OFX) / float(1 << 16);
-    const float fofy = float(REGS.OFY) / float(1 << 16);
-    float precise_x = precise_ir1 * precise_h_div_sz;
-
-    switch (s_aspect_ratio)
-    {
-      case DisplayAspectRatio::MatchWindow:
-      case DisplayAspectRatio::Custom:
-        precise_x = precise_x * s_custom_aspect_ratio_f;
-        break;
-
-      case DisplayAspectRatio::R16_9:
-        precise_x = (precise_x * 3.0f) / 4.0f;
-        break;
-
-      case DisplayAspectRatio::R19_9:
-        precise_x = (precise_x * 12.0f) / 19.0f;
-        break;
-
-      case DisplayAspectRatio::R20_9:
-        precise_x = (precise_x * 3.0f) / 5.0f;
-        break;
-
-      case DisplayAspectRatio::Auto:
-      case DisplayAspectRatio::R4_3:
-      case DisplayAspectRatio::PAR1_1:
-      default:
-        break;
-    }
-
-    precise_x += fofx;
-
-    float precise_y = fofy + (precise_ir2 * precise_h_div_sz);
-
-    precise_x = std::clamp<float>(precise_x, -1024.0f, 1023.0f);
-    precise_y = std::clamp<float>(precise_y, -1024.0f, 1023.0f);
-    CPU::PGXP::GTE_PushSXYZ2f(precise_x, precise_y, precise_z, REGS.dr32[14]);
-  }
+    PushPreciseSXY(x, y, z, shift, lm);
 
   if (last)
   {
@@ -806,14 +823,14 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   }
 }
 
-void GTE::Execute_RTPS(Instruction inst)
+ALWAYS_INLINE void GTE::Execute_RTPS(Instruction inst)
 {
   REGS.FLAG.Clear();
   RTPS(REGS.V0, inst.GetShift(), inst.lm, true);
   REGS.FLAG.UpdateError();
 }
 
-void GTE::Execute_RTPT(Instruction inst)
+ALWAYS_INLINE void GTE::Execute_RTPT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
@@ -966,7 +983,7 @@ void GTE::Execute_NCCT(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
+ALWAYS_INLINE void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
 {
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
   MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
@@ -987,7 +1004,7 @@ void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
   PushRGBFromMAC();
 }
 
-void GTE::Execute_NCDS(Instruction inst)
+ALWAYS_INLINE void GTE::Execute_NCDS(Instruction inst)
 {
   REGS.FLAG.Clear();
 
@@ -996,7 +1013,7 @@ void GTE::Execute_NCDS(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-void GTE::Execute_NCDT(Instruction inst)
+ALWAYS_INLINE void GTE::Execute_NCDT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
@@ -1173,132 +1190,35 @@ void GTE::Execute_GPF(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-void GTE::ExecuteInstruction(u32 inst_bits)
-{
-  const Instruction inst{inst_bits};
-  switch (inst.command)
-  {
-    case 0x01:
-      CPU::AddGTETicks(15);
-      Execute_RTPS(inst);
-      break;
-
-    case 0x06:
-    {
-      CPU::AddGTETicks(8);
-      if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
-        Execute_NCLIP_PGXP(inst);
-      else
-        Execute_NCLIP(inst);
-    }
-    break;
-
-    case 0x0C:
-      CPU::AddGTETicks(6);
-      Execute_OP(inst);
-      break;
-
-    case 0x10:
-      CPU::AddGTETicks(8);
-      Execute_DPCS(inst);
-      break;
-
-    case 0x11:
-      CPU::AddGTETicks(7);
-      Execute_INTPL(inst);
-      break;
-
-    case 0x12:
-      CPU::AddGTETicks(8);
-      Execute_MVMVA(inst);
-      break;
-
-    case 0x13:
-      CPU::AddGTETicks(19);
-      Execute_NCDS(inst);
-      break;
-
-    case 0x14:
-      CPU::AddGTETicks(13);
-      Execute_CDP(inst);
-      break;
-
-    case 0x16:
-      CPU::AddGTETicks(44);
-      Execute_NCDT(inst);
-      break;
-
-    case 0x1B:
-      CPU::AddGTETicks(17);
-      Execute_NCCS(inst);
-      break;
-
-    case 0x1C:
-      CPU::AddGTETicks(11);
-      Execute_CC(inst);
-      break;
-
-    case 0x1E:
-      CPU::AddGTETicks(14);
-      Execute_NCS(inst);
-      break;
-
-    case 0x20:
-      CPU::AddGTETicks(30);
-      Execute_NCT(inst);
-      break;
-
-    case 0x28:
-      CPU::AddGTETicks(5);
-      Execute_SQR(inst);
-      break;
-
-    case 0x29:
-      CPU::AddGTETicks(8);
-      Execute_DCPL(inst);
-      break;
-
-    case 0x2A:
-      CPU::AddGTETicks(17);
-      Execute_DPCT(inst);
-      break;
-
-    case 0x2D:
-      CPU::AddGTETicks(5);
-      Execute_AVSZ3(inst);
-      break;
-
-    case 0x2E:
-      CPU::AddGTETicks(6);
-      Execute_AVSZ4(inst);
-      break;
-
-    case 0x30:
-      CPU::AddGTETicks(23);
-      Execute_RTPT(inst);
-      break;
-
-    case 0x3D:
-      CPU::AddGTETicks(5);
-      Execute_GPF(inst);
-      break;
+namespace GTE {
 
-    case 0x3E:
-      CPU::AddGTETicks(5);
-      Execute_GPL(inst);
-      break;
+// Copies of the common instructions with the sf and lm bits fixed, so the shifts and saturation fold away when they
+// are called from recompiled code.
+static constexpr u32 SPECIALIZED_SF_BIT = (1u << 19);
+static constexpr u32 SPECIALIZED_LM_BIT = (1u << 10);
 
-    case 0x3F:
-      CPU::AddGTETicks(39);
-      Execute_NCCT(inst);
-      break;
+template<void (*func)(Instruction), u32 fixed_bits>
+static void ExecuteSpecialized(Instruction inst)
+{
+  func(Instruction{(inst.bits & ~(SPECIALIZED_SF_BIT | SPECIALIZED_LM_BIT)) | fixed_bits});
+}
 
-    default:
-      Panic("Missing handler");
-      break;
+template<void (*func)(Instruction)>
+static InstructionImpl GetSpecializedImpl(Instruction inst)
+{
+  if (inst.sf)
+  {
+    return inst.lm ? &ExecuteSpecialized<func, SPECIALIZED_SF_BIT | SPECIALIZED_LM_BIT> :
+                     &ExecuteSpecialized<func, SPECIALIZED_SF_BIT>;
+  }
+  else
+  {
+    return inst.lm ? &ExecuteSpecialized<func, SPECIALIZED_LM_BIT> : &ExecuteSpecialized<func, 0>;
   }
 }
 
+} // namespace GTE
+
 GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
 {
   const Instruction inst{inst_bits};
@@ -1306,7 +1226,7 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
   {
     case 0x01:
       *ticks = 15;
-      return &Execute_RTPS;
+      return GetSpecializedImpl<&Execute_RTPS>(inst);
 
     case 0x06:
     {
@@ -1331,11 +1251,11 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
 
     case 0x12:
       *ticks = 8;
-      return &Execute_MVMVA;
+      return GetSpecializedImpl<&Execute_MVMVA>(inst);
 
     case 0x13:
       *ticks = 19;
-      return &Execute_NCDS;
+      return GetSpecializedImpl<&Execute_NCDS>(inst);
 
     case 0x14:
       *ticks = 13;
@@ -1343,7 +1263,7 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
 
     case 0x16:
       *ticks = 44;
-      return &Execute_NCDT;
+      return GetSpecializedImpl<&Execute_NCDT>(inst);
 
     case 0x1B:
       *ticks = 17;
@@ -1383,7 +1303,7 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
 
     case 0x30:
       *ticks = 23;
-      return &Execute_RTPT;
+      return GetSpecializedImpl<&Execute_RTPT>(inst);
 
     case 0x3D:
       *ticks = 5;
@@ -1401,3 +1321,87 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
       Panic("Missing handler");
   }
 }
+
+void GTE::ExecuteInstruction(u32 inst_bits)
+{
+  TickCount ticks;
+  const InstructionImpl func = GetInstructionImpl(inst_bits, &ticks);
+  CPU::AddGTETicks(ticks);
+  func(Instruction{inst_bits});
+}
+
+bool GTE::RunSelfTest(u32 iterations, Error* error)
+{
+  // PGXP would record the vertices, and the test registers don't come from the CPU.
+  if (g_settings.gpu_pgxp_enable)
+  {
+    Error::SetStringView(error, "GTE self-test cannot run with PGXP enabled.");
+    return false;
+  }
+
+  static constexpr std::array<std::pair<u8, InstructionImpl>, 5> generic_impls = {{
+    {0x01, &Execute_RTPS},
+    {0x12, &Execute_MVMVA},
+    {0x13, &Execute_NCDS},
+    {0x16, &Execute_NCDT},
+    {0x30, &Execute_RTPT},
+  }};
+
+  std::array<u32, NUM_REGS> saved_regs, initial_regs, expected_regs;
+  std::memcpy(saved_regs.data(), REGS.r32, sizeof(saved_regs));
+
+  // Fixed seed, so that any failure is reproducible.
+  std::mt19937_64 rng(UINT64_C(0x4754455345544553));
+  u32 failures = 0;
+  for (u32 i = 0; i < iterations; i++)
+  {
+    // Fully random registers saturate nearly every result, so mix in small and sign-extended halfwords.
+    for (u32& reg : initial_regs)
+    {
+      const u32 value = static_cast<u32>(rng());
+      switch (rng() % 4)
+      {
+        case 0:
+          reg = value & 0x00FF00FFu;
+          break;
+        case 1:
+          reg = (value & 0x80008000u) ? (value | 0xFF00FF00u) : (value & 0x00FF00FFu);
+          break;
+        default:
+          reg = value;
+          break;
+      }
+    }
+
+    const auto& [command, generic_impl] = generic_impls[rng() % generic_impls.size()];
+    const Instruction inst{command | (static_cast<u32>(rng()) & Instruction::REQUIRED_BITS_MASK & ~0x3Fu)};
+    TickCount ticks;
+    const InstructionImpl specialized_impl = GetInstructionImpl(inst.bits, &ticks);
+
+    std::memcpy(REGS.r32, initial_regs.data(), sizeof(initial_regs));
+    generic_impl(inst);
+    std::memcpy(expected_regs.data(), REGS.r32, sizeof(expected_regs));
+
+    std::memcpy(REGS.r32, initial_regs.data(), sizeof(initial_regs));
+    specialized_impl(inst);
+    if (std::memcmp(expected_regs.data(), REGS.r32, sizeof(expected_regs)) != 0)
+    {
+      if (failures == 0)
+        Log_ErrorFmt("First mismatch at iteration {}, instruction {:08X}", i, inst.bits);
+
+      failures++;
+    }
+  }
+
+  std::memcpy(REGS.r32, saved_regs.data(), sizeof(saved_regs));
+
+  if (failures > 0)
+  {
+    Error::SetStringFmt(error, "{} of {} specialized instructions did not match the generic implementation.",
+                        failures, iterations);
+    return false;
+  }
+
+  Log_InfoFmt("{} specialized instructions matched the generic implementation.", iterations);
+  return true;
+}
@@ -4,6 +4,7 @@
 #pragma once
 #include "gte_types.h"
 
+class Error;
 class StateWrapper;
 
 namespace GTE {
@@ -20,9 +21,16 @@ void WriteRegister(u32 index, u32 value);
 // use with care, direct register access
 u32* GetRegisterPtr(u32 index);
 
+// reciprocal table used by the RTPS/RTPT division, for recompilers which emit it inline
+const u8* GetUNRTable();
+
 void ExecuteInstruction(u32 inst_bits);
 
 using InstructionImpl = void (*)(Instruction);
 InstructionImpl GetInstructionImpl(u32 inst_bits, TickCount* ticks);
 
+/// Executes random instructions with the sf/lm-specialized handlers and the generic implementations, and fails if any
+/// registers differ. Uses the GTE registers directly, so must not be called while a system is running.
+bool RunSelfTest(u32 iterations, Error* error);
+
 } // namespace GTE
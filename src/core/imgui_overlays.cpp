@@ -15,6 +15,7 @@
 #include "settings.h"
 #include "spu.h"
 #include "system.h"
+#include "timing_event.h"
 
 #include "util/audio_stream.h"
 #include "util/gpu_device.h"
@@ -229,6 +230,8 @@ void ImGuiManager::RenderDebugWindows()
       MDEC::DrawDebugStateWindow();
     if (g_settings.debugging.show_dma_state)
       DMA::DrawDebugStateWindow();
+    if (g_settings.debugging.show_timing_events_state)
+      TimingEvents::DrawDebugStateWindow();
   }
 }
 
@@ -416,6 +419,15 @@ void ImGuiManager::DrawPerformanceOverlay()
         FormatProcessorStat(text, System::GetSWThreadUsage(), System::GetSWThreadAverageTime());
         DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
       }
+
+      const System::MemorySaveStateTimings& mss_timings = System::GetMemorySaveStateTimings();
+      if (mss_timings.saves > 0 || mss_timings.loads > 0)
+      {
+        text.format("MSS: {:.2f}ms | {:.2f}ms max", mss_timings.average_save_time, mss_timings.maximum_save_time);
+        if (mss_timings.loads > 0)
+          text.append_format(" | Load {:.2f}ms", mss_timings.average_load_time + mss_timings.average_wait_time);
+        DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
+      }
     }
 
     if (g_settings.display_show_gpu_usage && g_gpu_device->IsGPUTimingEnabled())
@@ -6,16 +6,22 @@
 #include "dma.h"
 #include "host.h"
 #include "interrupt_controller.h"
+#include "perf_sections.h"
 #include "system.h"
 
 #include "util/imgui_manager.h"
 #include "util/state_wrapper.h"
 
 #include "common/bitfield.h"
+#include "common/error.h"
 #include "common/fifo_queue.h"
+#include "common/file_system.h"
+#include "common/intrin.h"
 #include "common/log.h"
+#include "common/timer.h"
 
 #include "imgui.h"
+#include "xxhash.h"
 
 #include <array>
 #include <memory>
@@ -121,6 +127,20 @@ static void yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const s
                        const std::array<s16, 64>& Yblk);
 static void y_to_mono(const std::array<s16, 64>& Yblk);
 
+// vectorized versions of the above, output must be identical
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+static void IDCT_Vector(s16* blk);
+static void yuv_to_rgb_vector(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
+                              const std::array<s16, 64>& Yblk);
+#endif
+
+static void CaptureWords(const u32* words, u32 word_count);
+
+template<bool vector>
+static void BenchmarkDecodeMacroblocks(const u32* words, u32 word_count, u64* blocks_decoded, XXH64_hash_t* hash);
+template<bool vector>
+static void BenchmarkDecodeStream(const u32* words, size_t word_count, u64* blocks_decoded, XXH64_hash_t* hash);
+
 static StatusRegister s_status = {};
 static bool s_enable_dma_in = false;
 static bool s_enable_dma_out = false;
@@ -146,6 +166,8 @@ alignas(16) static std::array<u32, 256> s_block_rgb{};
 static std::unique_ptr<TimingEvent> s_block_copy_out_event;
 
 static u32 s_total_blocks_decoded = 0;
+
+static FileSystem::ManagedCFilePtr s_capture_file;
 } // namespace MDEC
 
 void MDEC::Initialize()
@@ -248,6 +270,8 @@ void MDEC::WriteRegister(u32 offset, u32 value)
 
 void MDEC::DMARead(u32* words, u32 word_count)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::MDEC);
+
   if (s_data_out_fifo.GetSize() < word_count) [[unlikely]]
   {
     Log_WarningPrintf("Insufficient data in output FIFO (requested %u, have %u)", word_count,
@@ -276,6 +300,9 @@ void MDEC::DMAWrite(const u32* words, u32 word_count)
 
   const u32 halfwords_to_write = std::min(word_count * 2, s_data_in_fifo.GetSpace() & ~u32(2));
   s_data_in_fifo.PushRange(reinterpret_cast<const u16*>(words), halfwords_to_write);
+  if (s_capture_file) [[unlikely]]
+    CaptureWords(words, halfwords_to_write / 2);
+
   Execute();
 }
 
@@ -359,12 +386,16 @@ void MDEC::WriteCommandRegister(u32 value)
 
   s_data_in_fifo.Push(Truncate16(value));
   s_data_in_fifo.Push(Truncate16(value >> 16));
+  if (s_capture_file) [[unlikely]]
+    CaptureWords(&value, 1);
 
   Execute();
 }
 
 void MDEC::Execute()
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::MDEC);
+
   for (;;)
   {
     switch (s_state)
@@ -540,10 +571,17 @@ bool MDEC::DecodeColoredMacroblock()
   ResetDecoder();
   s_state = State::WritingMacroblock;
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  yuv_to_rgb_vector(0, 0, s_blocks[0], s_blocks[1], s_blocks[2]);
+  yuv_to_rgb_vector(8, 0, s_blocks[0], s_blocks[1], s_blocks[3]);
+  yuv_to_rgb_vector(0, 8, s_blocks[0], s_blocks[1], s_blocks[4]);
+  yuv_to_rgb_vector(8, 8, s_blocks[0], s_blocks[1], s_blocks[5]);
+#else
   yuv_to_rgb(0, 0, s_blocks[0], s_blocks[1], s_blocks[2]);
   yuv_to_rgb(8, 0, s_blocks[0], s_blocks[1], s_blocks[3]);
   yuv_to_rgb(0, 8, s_blocks[0], s_blocks[1], s_blocks[4]);
   yuv_to_rgb(8, 8, s_blocks[0], s_blocks[1], s_blocks[5]);
+#endif
   s_total_blocks_decoded += 4;
 
   ScheduleBlockCopyOut(TICKS_PER_BLOCK * 6);
@@ -560,6 +598,8 @@ void MDEC::ScheduleBlockCopyOut(TickCount ticks)
 
 void MDEC::CopyOutBlock(void* param, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::MDEC);
+
   Assert(s_state == State::WritingMacroblock);
   s_block_copy_out_event->Deactivate();
 
@@ -776,7 +816,11 @@ void MDEC::IDCT(s16* blk)
   if (g_settings.use_old_mdec_routines) [[unlikely]]
     IDCT_Old(blk);
   else
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+    IDCT_Vector(blk);
+#else
     IDCT_New(blk);
+#endif
 }
 
 void MDEC::IDCT_New(s16* blk)
@@ -806,6 +850,124 @@ void MDEC::IDCT_New(s16* blk)
   }
 }
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+
+void MDEC::IDCT_Vector(s16* blk)
+{
+  // Same arithmetic as IDCT_New(), with the sums computed for a row of eight outputs at once. The first pass is
+  // stored transposed so the second pass can read it by row. Intermediate values never exceed +/-4096, so storing
+  // them as 16-bit does not change the result.
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> temp;
+
+#if defined(CPU_ARCH_SSE)
+  // C++ division rounds towards zero, so bias negative values before shifting.
+  const auto round_div = [](__m128i v) {
+    v = _mm_add_epi32(v, _mm_set1_epi32(0xfff));
+    return _mm_srai_epi32(_mm_add_epi32(v, _mm_and_si128(_mm_srai_epi32(v, 31), _mm_set1_epi32(0x1fff))), 13);
+  };
+
+  // Pairs of rows are interleaved, so each _mm_madd_epi16() handles two terms of the sum.
+  alignas(VECTOR_ALIGNMENT) std::array<std::array<u32, 8>, 4> scale_pairs;
+  __m128i scale_lo[4], scale_hi[4], blk_lo[4], blk_hi[4];
+  for (u32 k = 0; k < 4; k++)
+  {
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&s_scale_table[k * 16]));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&s_scale_table[k * 16 + 8]));
+    s0 = _mm_srai_epi16(_mm_add_epi16(s0, _mm_and_si128(_mm_srai_epi16(s0, 15), _mm_set1_epi16(7))), 3);
+    s1 = _mm_srai_epi16(_mm_add_epi16(s1, _mm_and_si128(_mm_srai_epi16(s1, 15), _mm_set1_epi16(7))), 3);
+    scale_lo[k] = _mm_unpacklo_epi16(s0, s1);
+    scale_hi[k] = _mm_unpackhi_epi16(s0, s1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&scale_pairs[k][0]), scale_lo[k]);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&scale_pairs[k][4]), scale_hi[k]);
+
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[k * 16]));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[k * 16 + 8]));
+    blk_lo[k] = _mm_unpacklo_epi16(b0, b1);
+    blk_hi[k] = _mm_unpackhi_epi16(b0, b1);
+  }
+
+  for (u32 x = 0; x < 8; x++)
+  {
+    __m128i sum_lo = _mm_setzero_si128();
+    __m128i sum_hi = _mm_setzero_si128();
+    for (u32 k = 0; k < 4; k++)
+    {
+      const __m128i s = _mm_set1_epi32(static_cast<int>(scale_pairs[k][x]));
+      sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(blk_lo[k], s));
+      sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(blk_hi[k], s));
+    }
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(&temp[x * 8]), _mm_packs_epi32(round_div(sum_lo), round_div(sum_hi)));
+  }
+
+  const __m128i min_value = _mm_set1_epi16(-128);
+  const __m128i max_value = _mm_set1_epi16(127);
+  for (u32 y = 0; y < 8; y++)
+  {
+    const __m128i t = _mm_load_si128(reinterpret_cast<const __m128i*>(&temp[y * 8]));
+    const __m128i t0 = _mm_shuffle_epi32(t, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128i t1 = _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128i t2 = _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128i t3 = _mm_shuffle_epi32(t, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i sum_lo =
+      _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(scale_lo[0], t0), _mm_madd_epi16(scale_lo[1], t1)),
+                    _mm_add_epi32(_mm_madd_epi16(scale_lo[2], t2), _mm_madd_epi16(scale_lo[3], t3)));
+    const __m128i sum_hi =
+      _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(scale_hi[0], t0), _mm_madd_epi16(scale_hi[1], t1)),
+                    _mm_add_epi32(_mm_madd_epi16(scale_hi[2], t2), _mm_madd_epi16(scale_hi[3], t3)));
+
+    const __m128i res = _mm_packs_epi32(round_div(sum_lo), round_div(sum_hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&blk[y * 8]), _mm_min_epi16(_mm_max_epi16(res, min_value), max_value));
+  }
+#elif defined(CPU_ARCH_NEON)
+  const auto round_div = [](int32x4_t v) {
+    v = vaddq_s32(v, vdupq_n_s32(0xfff));
+    return vshrq_n_s32(vaddq_s32(v, vandq_s32(vshrq_n_s32(v, 31), vdupq_n_s32(0x1fff))), 13);
+  };
+
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> scale_values;
+  int16x8_t scale[8], rows[8];
+  for (u32 z = 0; z < 8; z++)
+  {
+    const int16x8_t s = vld1q_s16(&s_scale_table[z * 8]);
+    scale[z] = vshrq_n_s16(vaddq_s16(s, vandq_s16(vshrq_n_s16(s, 15), vdupq_n_s16(7))), 3);
+    vst1q_s16(&scale_values[z * 8], scale[z]);
+    rows[z] = vld1q_s16(&blk[z * 8]);
+  }
+
+  for (u32 x = 0; x < 8; x++)
+  {
+    int32x4_t sum_lo = vdupq_n_s32(0);
+    int32x4_t sum_hi = vdupq_n_s32(0);
+    for (u32 z = 0; z < 8; z++)
+    {
+      sum_lo = vmlal_n_s16(sum_lo, vget_low_s16(rows[z]), scale_values[z * 8 + x]);
+      sum_hi = vmlal_n_s16(sum_hi, vget_high_s16(rows[z]), scale_values[z * 8 + x]);
+    }
+
+    vst1q_s16(&temp[x * 8], vcombine_s16(vqmovn_s32(round_div(sum_lo)), vqmovn_s32(round_div(sum_hi))));
+  }
+
+  const int16x8_t min_value = vdupq_n_s16(-128);
+  const int16x8_t max_value = vdupq_n_s16(127);
+  for (u32 y = 0; y < 8; y++)
+  {
+    int32x4_t sum_lo = vdupq_n_s32(0);
+    int32x4_t sum_hi = vdupq_n_s32(0);
+    for (u32 z = 0; z < 8; z++)
+    {
+      sum_lo = vmlal_n_s16(sum_lo, vget_low_s16(scale[z]), temp[y * 8 + z]);
+      sum_hi = vmlal_n_s16(sum_hi, vget_high_s16(scale[z]), temp[y * 8 + z]);
+    }
+
+    const int16x8_t res = vcombine_s16(vqmovn_s32(round_div(sum_lo)), vqmovn_s32(round_div(sum_hi)));
+    vst1q_s16(&blk[y * 8], vminq_s16(vmaxq_s16(res, min_value), max_value));
+  }
+#endif
+}
+
+#endif
+
 void MDEC::IDCT_Old(s16* blk)
 {
   std::array<s64, 64> temp_buffer;
@@ -860,6 +1022,93 @@ void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const st
   }
 }
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+
+void MDEC::yuv_to_rgb_vector(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
+                             const std::array<s16, 64>& Yblk)
+{
+  const s16 addval = s_status.data_output_signed ? 0 : 0x80;
+  for (u32 cy = 0; cy < 4; cy++)
+  {
+    // Chroma is shared by 2x2 pixels, so only compute it once, using the same float expressions as yuv_to_rgb().
+    alignas(VECTOR_ALIGNMENT) std::array<s16, 4> cr, cg, cb;
+    for (u32 cx = 0; cx < 4; cx++)
+    {
+      const s16 R = Crblk[((xx / 2) + cx) + ((yy / 2) + cy) * 8];
+      const s16 B = Cbblk[((xx / 2) + cx) + ((yy / 2) + cy) * 8];
+      cg[cx] = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
+      cr[cx] = static_cast<s16>(1.402f * static_cast<float>(R));
+      cb[cx] = static_cast<s16>(1.772f * static_cast<float>(B));
+    }
+
+#if defined(CPU_ARCH_SSE)
+    const __m128i min_value = _mm_set1_epi16(-128);
+    const __m128i max_value = _mm_set1_epi16(127);
+    const __m128i add_value = _mm_set1_epi16(addval);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i r_offset = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cr.data()));
+    __m128i g_offset = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cg.data()));
+    __m128i b_offset = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cb.data()));
+    r_offset = _mm_unpacklo_epi16(r_offset, r_offset);
+    g_offset = _mm_unpacklo_epi16(g_offset, g_offset);
+    b_offset = _mm_unpacklo_epi16(b_offset, b_offset);
+
+    for (u32 y = cy * 2; y < (cy * 2 + 2); y++)
+    {
+      const __m128i Y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[y * 8]));
+      const __m128i R =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, r_offset), min_value), max_value), add_value);
+      const __m128i G =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, g_offset), min_value), max_value), add_value);
+      const __m128i B =
+        _mm_add_epi16(_mm_min_epi16(_mm_max_epi16(_mm_add_epi16(Y, b_offset), min_value), max_value), add_value);
+
+      // Zero-extend each component before combining, negative values overlap like the scalar version.
+      const __m128i rgb_lo =
+        _mm_or_si128(_mm_or_si128(_mm_unpacklo_epi16(R, zero), _mm_slli_epi32(_mm_unpacklo_epi16(G, zero), 8)),
+                     _mm_slli_epi32(_mm_unpacklo_epi16(B, zero), 16));
+      const __m128i rgb_hi =
+        _mm_or_si128(_mm_or_si128(_mm_unpackhi_epi16(R, zero), _mm_slli_epi32(_mm_unpackhi_epi16(G, zero), 8)),
+                     _mm_slli_epi32(_mm_unpackhi_epi16(B, zero), 16));
+      _mm_store_si128(reinterpret_cast<__m128i*>(&s_block_rgb[xx + (y + yy) * 16]), rgb_lo);
+      _mm_store_si128(reinterpret_cast<__m128i*>(&s_block_rgb[xx + (y + yy) * 16 + 4]), rgb_hi);
+    }
+#elif defined(CPU_ARCH_NEON)
+    const int16x8_t min_value = vdupq_n_s16(-128);
+    const int16x8_t max_value = vdupq_n_s16(127);
+    const int16x8_t add_value = vdupq_n_s16(addval);
+    const int16x4_t r4 = vld1_s16(cr.data());
+    const int16x4_t g4 = vld1_s16(cg.data());
+    const int16x4_t b4 = vld1_s16(cb.data());
+    const int16x8_t r_offset = vcombine_s16(vzip1_s16(r4, r4), vzip2_s16(r4, r4));
+    const int16x8_t g_offset = vcombine_s16(vzip1_s16(g4, g4), vzip2_s16(g4, g4));
+    const int16x8_t b_offset = vcombine_s16(vzip1_s16(b4, b4), vzip2_s16(b4, b4));
+
+    for (u32 y = cy * 2; y < (cy * 2 + 2); y++)
+    {
+      const int16x8_t Y = vld1q_s16(&Yblk[y * 8]);
+      const uint16x8_t R = vreinterpretq_u16_s16(
+        vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, r_offset), min_value), max_value), add_value));
+      const uint16x8_t G = vreinterpretq_u16_s16(
+        vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, g_offset), min_value), max_value), add_value));
+      const uint16x8_t B = vreinterpretq_u16_s16(
+        vaddq_s16(vminq_s16(vmaxq_s16(vaddq_s16(Y, b_offset), min_value), max_value), add_value));
+
+      const uint32x4_t rgb_lo =
+        vorrq_u32(vorrq_u32(vmovl_u16(vget_low_u16(R)), vshlq_n_u32(vmovl_u16(vget_low_u16(G)), 8)),
+                  vshlq_n_u32(vmovl_u16(vget_low_u16(B)), 16));
+      const uint32x4_t rgb_hi =
+        vorrq_u32(vorrq_u32(vmovl_u16(vget_high_u16(R)), vshlq_n_u32(vmovl_u16(vget_high_u16(G)), 8)),
+                  vshlq_n_u32(vmovl_u16(vget_high_u16(B)), 16));
+      vst1q_u32(&s_block_rgb[xx + (y + yy) * 16], rgb_lo);
+      vst1q_u32(&s_block_rgb[xx + (y + yy) * 16 + 4], rgb_hi);
+    }
+#endif
+  }
+}
+
+#endif
+
 void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
 {
   for (u32 i = 0; i < 64; i++)
@@ -902,6 +1151,230 @@ void MDEC::HandleSetScaleCommand()
   std::memcpy(s_scale_table.data(), packed_data.data(), s_scale_table.size() * sizeof(s16));
 }
 
+void MDEC::CaptureWords(const u32* words, u32 word_count)
+{
+  if (std::fwrite(words, sizeof(u32), word_count, s_capture_file.get()) != word_count)
+  {
+    Log_ErrorPrint("Failed to write MDEC capture, stopping.");
+    s_capture_file.reset();
+  }
+}
+
+bool MDEC::StartCapture(const char* path, Error* error)
+{
+  s_capture_file = FileSystem::OpenManagedCFile(path, "wb", error);
+  if (!s_capture_file)
+    return false;
+
+  Log_InfoFmt("Capturing MDEC input to '{}'.", path);
+  return true;
+}
+
+void MDEC::StopCapture()
+{
+  if (!s_capture_file)
+    return;
+
+  Log_InfoFmt("Stopped MDEC capture, {} bytes written.", FileSystem::FTell64(s_capture_file.get()));
+  s_capture_file.reset();
+}
+
+template<bool vector>
+void MDEC::BenchmarkDecodeMacroblocks(const u32* words, u32 word_count, u64* blocks_decoded, XXH64_hash_t* hash)
+{
+  const u16* halfwords = reinterpret_cast<const u16*>(words);
+  const u32 total_halfwords = word_count * 2;
+  const bool mono = (s_status.data_output_depth <= DataOutputDepth_8Bit);
+  u32 halfwords_pushed = 0;
+
+  ResetDecoder();
+  s_data_in_fifo.Clear();
+  s_remaining_halfwords = total_halfwords;
+
+  for (;;)
+  {
+    const u32 push_count = std::min(s_data_in_fifo.GetSpace(), total_halfwords - halfwords_pushed);
+    s_data_in_fifo.PushRange(&halfwords[halfwords_pushed], push_count);
+    halfwords_pushed += push_count;
+
+    if (mono)
+    {
+      if (!rl_decode_block(s_blocks[0].data(), s_iq_y.data()))
+      {
+        if (s_remaining_halfwords == 0)
+          break;
+
+        continue;
+      }
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+      if constexpr (vector)
+        IDCT_Vector(s_blocks[0].data());
+      else
+#endif
+        IDCT_New(s_blocks[0].data());
+
+      y_to_mono(s_blocks[0]);
+      *blocks_decoded += 1;
+    }
+    else
+    {
+      for (; s_current_block < NUM_BLOCKS; s_current_block++)
+      {
+        const u8* qt = (s_current_block >= 2) ? s_iq_y.data() : s_iq_uv.data();
+        if (!rl_decode_block(s_blocks[s_current_block].data(), qt))
+          break;
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+        if constexpr (vector)
+          IDCT_Vector(s_blocks[s_current_block].data());
+        else
+#endif
+          IDCT_New(s_blocks[s_current_block].data());
+      }
+
+      if (s_current_block < NUM_BLOCKS)
+      {
+        if (s_remaining_halfwords == 0)
+          break;
+
+        continue;
+      }
+
+      s_current_block = 0;
+      for (u32 i = 0; i < 4; i++)
+      {
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+        if constexpr (vector)
+          yuv_to_rgb_vector((i & 1) * 8, (i >> 1) * 8, s_blocks[0], s_blocks[1], s_blocks[2 + i]);
+        else
+#endif
+          yuv_to_rgb((i & 1) * 8, (i >> 1) * 8, s_blocks[0], s_blocks[1], s_blocks[2 + i]);
+      }
+
+      *blocks_decoded += NUM_BLOCKS;
+    }
+
+    *hash = XXH64(s_block_rgb.data(), sizeof(s_block_rgb), *hash);
+  }
+
+  ResetDecoder();
+  s_data_in_fifo.Clear();
+  s_remaining_halfwords = 0;
+}
+
+template<bool vector>
+void MDEC::BenchmarkDecodeStream(const u32* words, size_t word_count, u64* blocks_decoded, XXH64_hash_t* hash)
+{
+  s_status.bits = 0;
+  s_block_rgb.fill(0);
+
+  size_t pos = 0;
+  while (pos < word_count)
+  {
+    const CommandWord cw{words[pos++]};
+    s_status.data_output_depth = cw.data_output_depth;
+    s_status.data_output_signed = cw.data_output_signed;
+    s_status.data_output_bit15 = cw.data_output_bit15;
+
+    const size_t remaining = word_count - pos;
+    switch (cw.command)
+    {
+      case Command::DecodeMacroblock:
+      {
+        const u32 num_words = static_cast<u32>(std::min<size_t>(cw.parameter_word_count.GetValue(), remaining));
+        BenchmarkDecodeMacroblocks<vector>(&words[pos], num_words, blocks_decoded, hash);
+        pos += num_words;
+      }
+      break;
+
+      case Command::SetIqTab:
+      {
+        const u32 num_words = 16 + (((cw.bits & 1) != 0) ? 16 : 0);
+        if (remaining < num_words)
+          return;
+
+        std::memcpy(s_iq_y.data(), &words[pos], s_iq_y.size());
+        if (num_words > 16)
+          std::memcpy(s_iq_uv.data(), &words[pos + 16], s_iq_uv.size());
+        pos += num_words;
+      }
+      break;
+
+      case Command::SetScale:
+      {
+        if (remaining < 32)
+          return;
+
+        std::memcpy(s_scale_table.data(), &words[pos], s_scale_table.size() * sizeof(s16));
+        pos += 32;
+      }
+      break;
+
+      default:
+        pos += std::min<size_t>(cw.parameter_word_count.GetValue(), remaining);
+        break;
+    }
+  }
+}
+
+bool MDEC::RunBenchmark(const char* path, u32 iterations, Error* error)
+{
+  if (s_block_copy_out_event)
+  {
+    Error::SetStringView(error, "MDEC benchmark cannot run while the system is running.");
+    return false;
+  }
+
+  std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path, error);
+  if (!data.has_value())
+    return false;
+
+  const size_t word_count = data->size() / sizeof(u32);
+  if (word_count == 0)
+  {
+    Error::SetStringView(error, "MDEC capture is empty.");
+    return false;
+  }
+
+  // Don't trust the buffer's alignment.
+  std::vector<u32> words(word_count);
+  std::memcpy(words.data(), data->data(), word_count * sizeof(u32));
+  data.reset();
+  iterations = std::max<u32>(iterations, 1);
+
+  const auto run = [&words, word_count, iterations](const char* name, auto decode) {
+    u64 blocks_decoded = 0;
+    XXH64_hash_t hash = 0;
+    Common::Timer timer;
+    for (u32 i = 0; i < iterations; i++)
+    {
+      hash = 0;
+      decode(words.data(), word_count, &blocks_decoded, &hash);
+    }
+
+    const double time = timer.GetTimeSeconds();
+    Log_InfoFmt("{}: {} blocks in {:.2f} ms, {:.0f} blocks/sec, hash {:016X}", name, blocks_decoded, time * 1000.0,
+                (time > 0.0) ? (static_cast<double>(blocks_decoded) / time) : 0.0, hash);
+    return hash;
+  };
+
+  Log_InfoFmt("Decoding {} words from '{}', {} iterations.", word_count, path, iterations);
+  const XXH64_hash_t reference_hash = run("Reference", &BenchmarkDecodeStream<false>);
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  const XXH64_hash_t vector_hash = run("Vector", &BenchmarkDecodeStream<true>);
+  if (vector_hash != reference_hash)
+  {
+    Error::SetStringFmt(error, "Vector output does not match reference ({:016X} vs {:016X}).", vector_hash,
+                        reference_hash);
+    return false;
+  }
+#endif
+
+  return true;
+}
+
 void MDEC::DrawDebugStateWindow()
 {
   const float framebuffer_scale = Host::GetOSDScale();
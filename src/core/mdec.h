@@ -4,6 +4,7 @@
 #pragma once
 #include "types.h"
 
+class Error;
 class StateWrapper;
 
 namespace MDEC {
@@ -22,4 +23,12 @@ void DMAWrite(const u32* words, u32 word_count);
 
 void DrawDebugStateWindow();
 
+/// Records all words written to the MDEC to a file, for use with RunBenchmark().
+bool StartCapture(const char* path, Error* error);
+void StopCapture();
+
+/// Decodes a captured stream with both the reference and vector routines, and reports the rate of each.
+/// Uses the decoder state directly, so must not be called while a system is running.
+bool RunBenchmark(const char* path, u32 iterations, Error* error);
+
 } // namespace MDEC
@@ -0,0 +1,438 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "media_capture.h"
+#include "gpu.h"
+#include "spu.h"
+
+#include "util/gpu_device.h"
+#include "util/gpu_texture.h"
+
+#include "common/assert.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/threading.h"
+#include "common/timer.h"
+#include "common/xor_delta.h"
+
+#include "zstd.h"
+#include "zstd_errors.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+Log_SetChannel(MediaCapture);
+
+namespace MediaCapture {
+namespace {
+struct QueuedFrame
+{
+  std::vector<u32> pixels;
+  std::vector<s16> audio;
+  u64 video_timestamp;
+  u64 audio_timestamp;
+  u32 frame_number;
+  u32 width;
+  u32 height;
+  u32 stride;
+  GPUTexture::Format format;
+  bool has_video;
+  bool flip;
+};
+} // namespace
+
+static constexpr u32 NUM_CHANNELS = 2;
+static constexpr int COMPRESSION_LEVEL = 1;
+
+static void WorkerThreadEntryPoint();
+static void EncodeVideo(QueuedFrame& frame);
+static void EncodeAudio(const QueuedFrame& frame);
+static bool WriteChunk(u32 type, u32 flags, u64 timestamp, const void* prefix, u32 prefix_size, const void* data,
+                       u32 data_size, u32 uncompressed_size);
+static bool WriteIndexAndFooter();
+
+static bool s_capturing = false;
+static u32 s_max_queued_frames = 0;
+static bool s_drop_when_full = false;
+static u32 s_keyframe_interval = 0;
+
+// CPU thread state.
+static std::vector<s16> s_pending_audio;
+static u64 s_timestamp = 0;
+static u32 s_frame_number = 0;
+static u32 s_frames_captured = 0;
+static u32 s_frames_dropped = 0;
+static u32 s_frames_stalled = 0;
+static Common::Timer::Value s_stall_time = 0;
+
+// Shared state, protected by the mutex.
+static Threading::Thread s_worker_thread;
+static std::mutex s_mutex;
+static std::condition_variable s_worker_cv;
+static std::condition_variable s_space_cv;
+static std::deque<QueuedFrame> s_queue;
+static std::vector<std::vector<u32>> s_free_pixel_buffers;
+static u32 s_queued_video_frames = 0;
+static bool s_worker_shutdown = false;
+static std::atomic_bool s_error{false};
+static std::atomic<u64> s_bytes_written{0};
+
+// Worker thread state. Also touched by the CPU thread when it's not running.
+static FileSystem::ManagedCFilePtr s_file;
+static ZSTD_CCtx* s_cctx = nullptr;
+static std::vector<u32> s_previous_frame;
+static std::vector<u8> s_delta_buffer;
+static std::vector<u8> s_compress_buffer;
+static std::vector<IndexEntry> s_index;
+static u32 s_previous_width = 0;
+static u32 s_previous_height = 0;
+static u32 s_frames_since_keyframe = 0;
+} // namespace MediaCapture
+
+bool MediaCapture::Start(const char* filename, u32 max_queued_frames, bool drop_when_full, u32 keyframe_interval,
+                         Error* error)
+{
+  if (s_capturing)
+    Stop();
+
+  s_file = FileSystem::OpenManagedCFile(filename, "wb", error);
+  if (!s_file)
+    return false;
+
+  s_cctx = ZSTD_createCCtx();
+  if (!s_cctx || ZSTD_isError(ZSTD_CCtx_setParameter(s_cctx, ZSTD_c_compressionLevel, COMPRESSION_LEVEL)))
+  {
+    Error::SetStringView(error, "Failed to create zstd context.");
+    if (s_cctx)
+    {
+      ZSTD_freeCCtx(s_cctx);
+      s_cctx = nullptr;
+    }
+    s_file.reset();
+    return false;
+  }
+
+  FileHeader header = {};
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+  header.version = FILE_VERSION;
+  header.sample_rate = SPU::SAMPLE_RATE;
+  header.channels = NUM_CHANNELS;
+  if (std::fwrite(&header, sizeof(header), 1, s_file.get()) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    ZSTD_freeCCtx(s_cctx);
+    s_cctx = nullptr;
+    s_file.reset();
+    return false;
+  }
+
+  s_max_queued_frames = std::max(max_queued_frames, 1u);
+  s_drop_when_full = drop_when_full;
+  s_keyframe_interval = std::max(keyframe_interval, 1u);
+
+  s_pending_audio.clear();
+  s_timestamp = 0;
+  s_frame_number = 0;
+  s_frames_captured = 0;
+  s_frames_dropped = 0;
+  s_frames_stalled = 0;
+  s_stall_time = 0;
+
+  s_queued_video_frames = 0;
+  s_worker_shutdown = false;
+  s_error.store(false, std::memory_order_relaxed);
+  s_bytes_written.store(sizeof(header), std::memory_order_relaxed);
+
+  s_previous_width = 0;
+  s_previous_height = 0;
+  s_frames_since_keyframe = 0;
+  s_index.clear();
+
+  s_worker_thread.Start(&MediaCapture::WorkerThreadEntryPoint);
+  s_capturing = true;
+  Log_InfoFmt("Started capture to '{}', {} queued frames, {} when full", filename, s_max_queued_frames,
+              s_drop_when_full ? "dropping" : "stalling");
+  return true;
+}
+
+void MediaCapture::Stop()
+{
+  if (!s_capturing)
+    return;
+
+  // push out any audio from the last partial frame
+  if (!s_pending_audio.empty())
+  {
+    QueuedFrame frame = {};
+    frame.audio_timestamp = s_timestamp - (s_pending_audio.size() / NUM_CHANNELS);
+    frame.audio = std::move(s_pending_audio);
+    std::unique_lock lock(s_mutex);
+    s_queue.push_back(std::move(frame));
+  }
+
+  {
+    std::unique_lock lock(s_mutex);
+    s_worker_shutdown = true;
+    s_worker_cv.notify_one();
+  }
+
+  s_worker_thread.Join();
+  s_capturing = false;
+
+  if (!s_error.load(std::memory_order_relaxed) && !WriteIndexAndFooter())
+    Log_ErrorPrint("Failed to write capture index, file will not be seekable.");
+
+  Log_InfoFmt("Stopped capture: {} frames, {} dropped, {} stalled ({:.2f} seconds), {} bytes", s_frames_captured,
+              s_frames_dropped, s_frames_stalled, Common::Timer::ConvertValueToSeconds(s_stall_time),
+              s_bytes_written.load(std::memory_order_relaxed));
+
+  s_file.reset();
+  ZSTD_freeCCtx(s_cctx);
+  s_cctx = nullptr;
+
+  s_queue.clear();
+  s_free_pixel_buffers.clear();
+  s_pending_audio = {};
+  s_previous_frame = {};
+  s_delta_buffer = {};
+  s_compress_buffer = {};
+  s_index = {};
+}
+
+bool MediaCapture::IsCapturing()
+{
+  return s_capturing;
+}
+
+bool MediaCapture::HasError()
+{
+  return s_error.load(std::memory_order_relaxed);
+}
+
+MediaCapture::Stats MediaCapture::GetStats()
+{
+  Stats stats;
+  stats.frames_captured = s_frames_captured;
+  stats.frames_dropped = s_frames_dropped;
+  stats.frames_stalled = s_frames_stalled;
+  stats.audio_frames = s_timestamp;
+  stats.bytes_written = s_bytes_written.load(std::memory_order_relaxed);
+  stats.stall_seconds = static_cast<float>(Common::Timer::ConvertValueToSeconds(s_stall_time));
+
+  std::unique_lock lock(s_mutex);
+  stats.queued_frames = s_queued_video_frames;
+  return stats;
+}
+
+void MediaCapture::CaptureAudio(const s16* frames, u32 num_frames)
+{
+  if (!s_capturing)
+    return;
+
+  s_pending_audio.insert(s_pending_audio.end(), frames, frames + (num_frames * NUM_CHANNELS));
+  s_timestamp += num_frames;
+}
+
+void MediaCapture::CaptureSilence(u32 num_frames)
+{
+  if (!s_capturing)
+    return;
+
+  s_pending_audio.resize(s_pending_audio.size() + (num_frames * NUM_CHANNELS), 0);
+  s_timestamp += num_frames;
+}
+
+void MediaCapture::CaptureFrame()
+{
+  if (!s_capturing)
+    return;
+
+  QueuedFrame frame = {};
+  frame.video_timestamp = s_timestamp;
+  frame.audio_timestamp = s_timestamp - (s_pending_audio.size() / NUM_CHANNELS);
+  frame.frame_number = s_frame_number++;
+  frame.audio = std::move(s_pending_audio);
+  s_pending_audio.clear();
+
+  std::unique_lock lock(s_mutex);
+  if (s_queued_video_frames >= s_max_queued_frames)
+  {
+    if (s_drop_when_full)
+    {
+      // keep the audio, a gap in the video is easier to deal with than a gap in the sound
+      s_frames_dropped++;
+      s_queue.push_back(std::move(frame));
+      s_worker_cv.notify_one();
+      return;
+    }
+
+    const Common::Timer::Value stall_start = Common::Timer::GetCurrentValue();
+    s_space_cv.wait(lock, []() { return s_queued_video_frames < s_max_queued_frames || s_error.load(); });
+    s_stall_time += Common::Timer::GetCurrentValue() - stall_start;
+    s_frames_stalled++;
+  }
+
+  if (!s_free_pixel_buffers.empty())
+  {
+    frame.pixels = std::move(s_free_pixel_buffers.back());
+    s_free_pixel_buffers.pop_back();
+  }
+
+  // don't hold the lock while we wait for the GPU
+  lock.unlock();
+  frame.has_video = g_gpu->ReadDisplayToBuffer(&frame.width, &frame.height, &frame.pixels, &frame.stride,
+                                               &frame.format);
+  frame.flip = g_gpu_device->UsesLowerLeftOrigin();
+  if (frame.has_video)
+    s_frames_captured++;
+
+  lock.lock();
+  s_queued_video_frames += static_cast<u32>(frame.has_video);
+  s_queue.push_back(std::move(frame));
+  s_worker_cv.notify_one();
+}
+
+void MediaCapture::WorkerThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Capture Encoder");
+
+  std::unique_lock lock(s_mutex);
+  for (;;)
+  {
+    s_worker_cv.wait(lock, []() { return s_worker_shutdown || !s_queue.empty(); });
+    if (s_queue.empty())
+      break;
+
+    QueuedFrame frame = std::move(s_queue.front());
+    s_queue.pop_front();
+    lock.unlock();
+
+    // after an error, keep draining so the CPU thread doesn't block
+    if (!s_error.load(std::memory_order_relaxed))
+    {
+      if (frame.has_video)
+        EncodeVideo(frame);
+      if (!frame.audio.empty())
+        EncodeAudio(frame);
+    }
+
+    lock.lock();
+    if (frame.has_video)
+    {
+      s_queued_video_frames--;
+      s_space_cv.notify_one();
+    }
+    if (frame.pixels.capacity() > 0 && s_free_pixel_buffers.size() < s_max_queued_frames)
+      s_free_pixel_buffers.push_back(std::move(frame.pixels));
+  }
+}
+
+void MediaCapture::EncodeVideo(QueuedFrame& frame)
+{
+  if (!GPUTexture::ConvertTextureDataToRGBA8(frame.width, frame.height, frame.pixels, frame.stride, frame.format))
+  {
+    Log_ErrorFmt("Can't convert {} capture frame to RGBA8", GPUTexture::GetFormatName(frame.format));
+    s_error.store(true, std::memory_order_relaxed);
+    return;
+  }
+
+  if (frame.flip)
+    GPUTexture::FlipTextureDataRGBA8(frame.width, frame.height, reinterpret_cast<u8*>(frame.pixels.data()),
+                                     frame.stride);
+
+  // pack the rows, so the delta only contains pixels
+  const u32 row_pixels = frame.width;
+  const u32 num_pixels = frame.width * frame.height;
+  if (frame.stride != row_pixels * sizeof(u32))
+  {
+    const u32 stride_pixels = frame.stride / sizeof(u32);
+    for (u32 y = 1; y < frame.height; y++)
+      std::memmove(&frame.pixels[y * row_pixels], &frame.pixels[y * stride_pixels], row_pixels * sizeof(u32));
+  }
+
+  const bool keyframe = (frame.width != s_previous_width || frame.height != s_previous_height ||
+                         s_frames_since_keyframe >= s_keyframe_interval);
+  const u32 frame_size = num_pixels * sizeof(u32);
+  const void* data = frame.pixels.data();
+  u32 data_size = frame_size;
+  if (!keyframe)
+  {
+    // static parts of the screen are skipped by the delta, so most frames end up small before compression
+    s_delta_buffer.clear();
+    XORDelta::Encode(&s_delta_buffer, std::span<const u8>(static_cast<const u8*>(data), frame_size),
+                     std::span<const u8>(reinterpret_cast<const u8*>(s_previous_frame.data()), frame_size));
+    data = s_delta_buffer.data();
+    data_size = static_cast<u32>(s_delta_buffer.size());
+    s_frames_since_keyframe++;
+  }
+  else
+  {
+    s_frames_since_keyframe = 1;
+  }
+
+  s_compress_buffer.resize(ZSTD_compressBound(data_size));
+  const size_t compressed_size =
+    ZSTD_compress2(s_cctx, s_compress_buffer.data(), s_compress_buffer.size(), data, data_size);
+  if (ZSTD_isError(compressed_size))
+  {
+    Log_ErrorFmt("ZSTD_compress2() failed: {}", ZSTD_getErrorName(compressed_size));
+    s_error.store(true, std::memory_order_relaxed);
+    return;
+  }
+
+  const VideoFrameHeader vfh = {frame.width, frame.height, frame.frame_number};
+  const u64 offset = s_bytes_written.load(std::memory_order_relaxed);
+  if (!WriteChunk(CHUNK_TYPE_VIDEO, CHUNK_FLAG_COMPRESSED | (keyframe ? CHUNK_FLAG_KEYFRAME : 0u),
+                  frame.video_timestamp, &vfh, sizeof(vfh), s_compress_buffer.data(),
+                  static_cast<u32>(compressed_size), data_size))
+  {
+    return;
+  }
+
+  if (keyframe)
+    s_index.push_back(IndexEntry{frame.frame_number, 0, frame.video_timestamp, offset});
+
+  // keep the frame for the next delta, the queued buffer gets the old one back to recycle
+  s_previous_frame.swap(frame.pixels);
+  s_previous_width = frame.width;
+  s_previous_height = frame.height;
+}
+
+void MediaCapture::EncodeAudio(const QueuedFrame& frame)
+{
+  const u32 size = static_cast<u32>(frame.audio.size() * sizeof(s16));
+  WriteChunk(CHUNK_TYPE_AUDIO, 0, frame.audio_timestamp, nullptr, 0, frame.audio.data(), size, size);
+}
+
+bool MediaCapture::WriteChunk(u32 type, u32 flags, u64 timestamp, const void* prefix, u32 prefix_size,
+                              const void* data, u32 data_size, u32 uncompressed_size)
+{
+  const ChunkHeader header = {type, flags, timestamp, prefix_size + data_size, uncompressed_size};
+  if (std::fwrite(&header, sizeof(header), 1, s_file.get()) != 1 ||
+      (prefix_size > 0 && std::fwrite(prefix, prefix_size, 1, s_file.get()) != 1) ||
+      (data_size > 0 && std::fwrite(data, data_size, 1, s_file.get()) != 1))
+  {
+    Log_ErrorFmt("Failed to write capture chunk: errno {}", errno);
+    s_error.store(true, std::memory_order_relaxed);
+    return false;
+  }
+
+  s_bytes_written.fetch_add(sizeof(header) + prefix_size + data_size, std::memory_order_relaxed);
+  return true;
+}
+
+bool MediaCapture::WriteIndexAndFooter()
+{
+  FileFooter footer;
+  footer.index_offset = s_bytes_written.load(std::memory_order_relaxed);
+  std::memcpy(footer.magic, FOOTER_MAGIC, sizeof(footer.magic));
+
+  const u32 index_size = static_cast<u32>(s_index.size() * sizeof(IndexEntry));
+  return (WriteChunk(CHUNK_TYPE_INDEX, 0, 0, nullptr, 0, s_index.data(), index_size, index_size) &&
+          std::fwrite(&footer, sizeof(footer), 1, s_file.get()) == 1 && std::fflush(s_file.get()) == 0);
+}
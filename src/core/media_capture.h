@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+class Error;
+
+/// Lossless capture of the displayed frames and SPU output. Frames are read back on the CPU thread and queued to a
+/// worker thread, which delta-codes them against the previous frame, compresses them and writes them to disk.
+///
+/// File layout, all values little-endian:
+///   FileHeader
+///   ChunkHeader + payload, repeated
+///   ChunkHeader (INDX) + IndexEntry[], one entry per keyframe
+///   FileFooter, which points at the index chunk so players can seek without scanning the file
+///
+/// Video chunks (VIDF) hold a VideoFrameHeader followed by zstd-compressed RGBA8 pixels. Non-keyframes hold an
+/// XORDelta against the previous frame instead of the pixels, so decoding starts from the nearest keyframe. Audio
+/// chunks (AUDS) hold interleaved stereo s16 samples. Chunk timestamps are in audio frames since the start of the
+/// capture, so both streams share a clock.
+namespace MediaCapture {
+
+static constexpr char FILE_MAGIC[8] = {'D', 'S', 'C', 'A', 'P', 'T', 'R', '1'};
+static constexpr char FOOTER_MAGIC[8] = {'D', 'S', 'C', 'A', 'P', 'I', 'D', 'X'};
+static constexpr u32 FILE_VERSION = 1;
+
+static constexpr u32 MakeChunkType(char a, char b, char c, char d)
+{
+  return static_cast<u32>(static_cast<u8>(a)) | (static_cast<u32>(static_cast<u8>(b)) << 8) |
+         (static_cast<u32>(static_cast<u8>(c)) << 16) | (static_cast<u32>(static_cast<u8>(d)) << 24);
+}
+
+static constexpr u32 CHUNK_TYPE_VIDEO = MakeChunkType('V', 'I', 'D', 'F');
+static constexpr u32 CHUNK_TYPE_AUDIO = MakeChunkType('A', 'U', 'D', 'S');
+static constexpr u32 CHUNK_TYPE_INDEX = MakeChunkType('I', 'N', 'D', 'X');
+
+enum ChunkFlags : u32
+{
+  CHUNK_FLAG_KEYFRAME = (1u << 0),
+  CHUNK_FLAG_COMPRESSED = (1u << 1),
+};
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+  char magic[8];
+  u32 version;
+  u32 sample_rate;
+  u32 channels;
+  u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 24);
+
+struct ChunkHeader
+{
+  u32 type;
+  u32 flags;
+  u64 timestamp;
+  u32 size;              // Payload size in the file, excluding this header.
+  u32 uncompressed_size; // Size of the payload after decompression, excluding any prefix.
+};
+static_assert(sizeof(ChunkHeader) == 24);
+
+struct VideoFrameHeader
+{
+  u32 width;
+  u32 height;
+  u32 frame_number;
+};
+static_assert(sizeof(VideoFrameHeader) == 12);
+
+struct IndexEntry
+{
+  u32 frame_number;
+  u32 reserved;
+  u64 timestamp;
+  u64 offset; // Offset of the keyframe's chunk header.
+};
+static_assert(sizeof(IndexEntry) == 24);
+
+struct FileFooter
+{
+  u64 index_offset;
+  char magic[8];
+};
+static_assert(sizeof(FileFooter) == 16);
+#pragma pack(pop)
+
+struct Stats
+{
+  u32 frames_captured;
+  u32 frames_dropped;
+  u32 frames_stalled;
+  u32 queued_frames;
+  u64 audio_frames;
+  u64 bytes_written;
+  float stall_seconds;
+};
+
+/// Opens the file and starts the encoder thread. When the queue holds max_queued_frames frames, the CPU thread either
+/// waits for the encoder, or drops the video part of the frame if drop_when_full is set. Audio is never dropped.
+bool Start(const char* filename, u32 max_queued_frames, bool drop_when_full, u32 keyframe_interval, Error* error);
+
+/// Flushes the queue, writes the index and closes the file.
+void Stop();
+
+bool IsCapturing();
+
+/// Returns true if the encoder thread failed to write to the file. The capture should be stopped.
+bool HasError();
+
+Stats GetStats();
+
+/// Reads back the current display and queues it along with any audio since the last frame.
+void CaptureFrame();
+
+/// Called by the SPU with the samples sent to the output stream.
+void CaptureAudio(const s16* frames, u32 num_frames);
+
+/// Called by the SPU instead of CaptureAudio() while the output is muted, so the clock keeps running.
+void CaptureSilence(u32 num_frames);
+
+} // namespace MediaCapture
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "perf_sections.h"
+
+#include "common/timer.h"
+
+#include <array>
+
+namespace PerfSections {
+static void ChargeCurrentSection();
+
+static constexpr std::array<const char*, static_cast<size_t>(Section::Count)> s_section_names = {
+  {"CPU", "JITCompile", "GPU", "SPU", "CDROM", "MDEC"}};
+
+static std::array<Common::Timer::Value, static_cast<size_t>(Section::Count)> s_section_times = {};
+static Common::Timer::Value s_last_time = 0;
+static Section s_current_section = Section::CPU;
+} // namespace PerfSections
+
+bool PerfSections::g_enabled = false;
+
+void PerfSections::SetEnabled(bool enabled)
+{
+  if (g_enabled == enabled)
+    return;
+
+  if (!enabled)
+    ChargeCurrentSection();
+  else
+    s_last_time = Common::Timer::GetCurrentValue();
+
+  g_enabled = enabled;
+}
+
+void PerfSections::Reset()
+{
+  s_section_times = {};
+  s_last_time = Common::Timer::GetCurrentValue();
+}
+
+const char* PerfSections::GetSectionName(Section section)
+{
+  return s_section_names[static_cast<size_t>(section)];
+}
+
+double PerfSections::GetSectionTime(Section section)
+{
+  if (g_enabled)
+    ChargeCurrentSection();
+
+  return Common::Timer::ConvertValueToSeconds(s_section_times[static_cast<size_t>(section)]);
+}
+
+void PerfSections::ChargeCurrentSection()
+{
+  const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+  s_section_times[static_cast<size_t>(s_current_section)] += now - s_last_time;
+  s_last_time = now;
+}
+
+PerfSections::Section PerfSections::Enter(Section section)
+{
+  ChargeCurrentSection();
+  const Section previous = s_current_section;
+  s_current_section = section;
+  return previous;
+}
+
+void PerfSections::Leave(Section previous)
+{
+  if (g_enabled)
+    ChargeCurrentSection();
+
+  s_current_section = previous;
+}
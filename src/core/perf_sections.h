@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+/// Host time accounting for the emulated subsystems, used by the benchmark runner. Time is exclusive, so time spent
+/// in a nested section is not also charged to its parent. Anything not inside a section is charged to the CPU.
+/// Disabled by default, in which case the scopes are a single branch.
+namespace PerfSections {
+
+enum class Section : u8
+{
+  CPU,
+  JITCompile,
+  GPU,
+  SPU,
+  CDROM,
+  MDEC,
+  Count
+};
+
+extern bool g_enabled;
+
+void SetEnabled(bool enabled);
+void Reset();
+
+const char* GetSectionName(Section section);
+
+/// Returns the host time spent in the section since the last reset, in seconds.
+double GetSectionTime(Section section);
+
+Section Enter(Section section);
+void Leave(Section previous);
+
+class Scope
+{
+public:
+  ALWAYS_INLINE Scope(Section section)
+  {
+    if (g_enabled) [[unlikely]]
+      m_previous = Enter(section);
+  }
+
+  ALWAYS_INLINE ~Scope()
+  {
+    if (m_previous != Section::Count) [[unlikely]]
+      Leave(m_previous);
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  Section m_previous = Section::Count;
+};
+
+} // namespace PerfSections
@@ -155,6 +155,8 @@ void Settings::Load(SettingsInterface& si)
   disable_all_enhancements = si.GetBoolValue("Main", "DisableAllEnhancements", false);
   enable_discord_presence = si.GetBoolValue("Main", "EnableDiscordPresence", false);
   rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
+  rewind_delta_states = si.GetBoolValue("Main", "RewindDeltaStates", false);
+  rewind_compress_states = si.GetBoolValue("Main", "RewindCompressStates", false);
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u32>(si.GetIntValue("Main", "RewindSaveSlots", 10));
   runahead_frames = static_cast<u32>(si.GetIntValue("Main", "RunaheadFrameCount", 0));
@@ -187,6 +189,8 @@ void Settings::Load(SettingsInterface& si)
   gpu_disable_texture_copy_to_self = si.GetBoolValue("GPU", "DisableTextureCopyToSelf", false);
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
+  gpu_sw_threads = static_cast<u8>(si.GetUIntValue("GPU", "SoftwareRendererThreads", 1));
+  gpu_thread_wake_threshold = si.GetUIntValue("GPU", "ThreadWakeThreshold", DEFAULT_GPU_THREAD_WAKE_THRESHOLD);
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
   gpu_threaded_presentation = si.GetBoolValue("GPU", "ThreadedPresentation", true);
   gpu_true_color = si.GetBoolValue("GPU", "TrueColor", true);
@@ -294,6 +298,8 @@ void Settings::Load(SettingsInterface& si)
 
   cdrom_readahead_sectors =
     static_cast<u8>(si.GetIntValue("CDROM", "ReadaheadSectors", DEFAULT_CDROM_READAHEAD_SECTORS));
+  cdrom_chd_prefetch_hunks =
+    static_cast<u8>(si.GetIntValue("CDROM", "CHDPrefetchHunks", DEFAULT_CDROM_CHD_PREFETCH_HUNKS));
   cdrom_mechacon_version =
     ParseCDROMMechVersionName(
       si.GetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(DEFAULT_CDROM_MECHACON_VERSION)).c_str())
@@ -322,6 +328,12 @@ void Settings::Load(SettingsInterface& si)
   audio_output_muted = si.GetBoolValue("Audio", "OutputMuted", false);
   audio_dump_on_boot = si.GetBoolValue("Audio", "DumpOnBoot", false);
 
+  capture_queue_frames =
+    std::clamp<u32>(si.GetUIntValue("Capture", "QueueFrames", DEFAULT_CAPTURE_QUEUE_FRAMES), 1, 120);
+  capture_keyframe_interval =
+    std::clamp<u32>(si.GetUIntValue("Capture", "KeyframeInterval", DEFAULT_CAPTURE_KEYFRAME_INTERVAL), 1, 3600);
+  capture_drop_frames_when_full = si.GetBoolValue("Capture", "DropFramesWhenFull", false);
+
   use_old_mdec_routines = si.GetBoolValue("Hacks", "UseOldMDECRoutines", false);
   pcdrv_enable = si.GetBoolValue("PCDrv", "Enabled", false);
   pcdrv_enable_writes = si.GetBoolValue("PCDrv", "EnableWrites", false);
@@ -410,6 +422,7 @@ void Settings::Load(SettingsInterface& si)
   debugging.show_timers_state = si.GetBoolValue("Debug", "ShowTimersState");
   debugging.show_mdec_state = si.GetBoolValue("Debug", "ShowMDECState");
   debugging.show_dma_state = si.GetBoolValue("Debug", "ShowDMAState");
+  debugging.show_timing_events_state = si.GetBoolValue("Debug", "ShowTimingEventsState");
 
   texture_replacements.enable_vram_write_replacements =
     si.GetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements", false);
@@ -459,6 +472,8 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("Console", "EnableCheats", enable_cheats);
   si.SetBoolValue("Main", "DisableAllEnhancements", disable_all_enhancements);
   si.SetBoolValue("Main", "RewindEnable", rewind_enable);
+  si.SetBoolValue("Main", "RewindDeltaStates", rewind_delta_states);
+  si.SetBoolValue("Main", "RewindCompressStates", rewind_compress_states);
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetIntValue("Main", "RewindSaveSlots", rewind_save_slots);
   si.SetIntValue("Main", "RunaheadFrameCount", runahead_frames);
@@ -489,6 +504,8 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
 
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
+  si.SetUIntValue("GPU", "SoftwareRendererThreads", gpu_sw_threads);
+  si.SetUIntValue("GPU", "ThreadWakeThreshold", gpu_thread_wake_threshold);
   si.SetBoolValue("GPU", "ThreadedPresentation", gpu_threaded_presentation);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
   si.SetBoolValue("GPU", "TrueColor", gpu_true_color);
@@ -556,6 +573,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetFloatValue("Display", "MaxFPS", display_max_fps);
 
   si.SetIntValue("CDROM", "ReadaheadSectors", cdrom_readahead_sectors);
+  si.SetIntValue("CDROM", "CHDPrefetchHunks", cdrom_chd_prefetch_hunks);
   si.SetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(cdrom_mechacon_version));
   si.SetBoolValue("CDROM", "RegionCheck", cdrom_region_check);
   si.SetBoolValue("CDROM", "LoadImageToRAM", cdrom_load_image_to_ram);
@@ -575,6 +593,10 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("Audio", "OutputMuted", audio_output_muted);
   si.SetBoolValue("Audio", "DumpOnBoot", audio_dump_on_boot);
 
+  si.SetUIntValue("Capture", "QueueFrames", capture_queue_frames);
+  si.SetUIntValue("Capture", "KeyframeInterval", capture_keyframe_interval);
+  si.SetBoolValue("Capture", "DropFramesWhenFull", capture_drop_frames_when_full);
+
   si.SetBoolValue("Hacks", "UseOldMDECRoutines", use_old_mdec_routines);
 
   if (!ignore_base)
@@ -644,6 +666,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
     si.SetBoolValue("Debug", "ShowTimersState", debugging.show_timers_state);
     si.SetBoolValue("Debug", "ShowMDECState", debugging.show_mdec_state);
     si.SetBoolValue("Debug", "ShowDMAState", debugging.show_dma_state);
+    si.SetBoolValue("Debug", "ShowTimingEventsState", debugging.show_timing_events_state);
   }
 
   si.SetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements",
@@ -800,6 +823,7 @@ void Settings::FixIncompatibleSettings(bool display_osd_messages)
     g_settings.debugging.show_timers_state = false;
     g_settings.debugging.show_mdec_state = false;
     g_settings.debugging.show_dma_state = false;
+    g_settings.debugging.show_timing_events_state = false;
     g_settings.debugging.dump_cpu_to_vram_copies = false;
     g_settings.debugging.dump_vram_to_cpu_copies = false;
   }
@@ -1920,6 +1944,7 @@ bool EmuFolders::EnsureFoldersExist()
   result = FileSystem::EnsureDirectoryExists(Covers.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Dumps.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "audio").c_str(), false) && result;
+  result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "capture").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "textures").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(GameSettings.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(InputProfiles.c_str(), false) && result;
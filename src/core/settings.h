@@ -93,6 +93,8 @@ struct Settings
   bool enable_discord_presence : 1 = false;
 
   bool rewind_enable : 1 = false;
+  bool rewind_delta_states : 1 = false;
+  bool rewind_compress_states : 1 = false;
   float rewind_save_frequency = 10.0f;
   u32 rewind_save_slots = 10;
   u32 runahead_frames = 0;
@@ -101,6 +103,8 @@ struct Settings
   std::string gpu_adapter;
   u8 gpu_resolution_scale = 1;
   u8 gpu_multisamples = 1;
+  u8 gpu_sw_threads = 1;
+  u32 gpu_thread_wake_threshold = DEFAULT_GPU_THREAD_WAKE_THRESHOLD;
   bool gpu_use_thread : 1 = true;
   bool gpu_use_software_renderer_for_readbacks : 1 = false;
   bool gpu_threaded_presentation : 1 = true;
@@ -170,6 +174,7 @@ struct Settings
   float gpu_pgxp_depth_clear_threshold = DEFAULT_GPU_PGXP_DEPTH_THRESHOLD / GPU_PGXP_DEPTH_THRESHOLD_SCALE;
 
   u8 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
+  u8 cdrom_chd_prefetch_hunks = DEFAULT_CDROM_CHD_PREFETCH_HUNKS;
   CDROMMechaconVersion cdrom_mechacon_version = DEFAULT_CDROM_MECHACON_VERSION;
   bool cdrom_region_check : 1 = false;
   bool cdrom_load_image_to_ram : 1 = false;
@@ -189,6 +194,10 @@ struct Settings
   bool audio_output_muted : 1 = false;
   bool audio_dump_on_boot : 1 = false;
 
+  u32 capture_queue_frames = DEFAULT_CAPTURE_QUEUE_FRAMES;
+  u32 capture_keyframe_interval = DEFAULT_CAPTURE_KEYFRAME_INTERVAL;
+  bool capture_drop_frames_when_full : 1 = false;
+
   bool use_old_mdec_routines : 1 = false;
   bool pcdrv_enable : 1 = false;
 
@@ -229,6 +238,7 @@ struct Settings
     mutable bool show_timers_state = false;
     mutable bool show_mdec_state = false;
     mutable bool show_dma_state = false;
+    mutable bool show_timing_events_state = false;
   } debugging;
 
   // texture replacements
@@ -340,6 +350,7 @@ struct Settings
     DEFAULT_DMA_HALT_TICKS = 100,
     DEFAULT_GPU_FIFO_SIZE = 16,
     DEFAULT_GPU_MAX_RUN_AHEAD = 128,
+    DEFAULT_GPU_THREAD_WAKE_THRESHOLD = 256,
     DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD = 128,
     DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD = 128,
   };
@@ -507,6 +518,7 @@ struct Settings
   static constexpr float DEFAULT_OSD_SCALE = 100.0f;
 
   static constexpr u8 DEFAULT_CDROM_READAHEAD_SECTORS = 8;
+  static constexpr u8 DEFAULT_CDROM_CHD_PREFETCH_HUNKS = 4;
   static constexpr CDROMMechaconVersion DEFAULT_CDROM_MECHACON_VERSION = CDROMMechaconVersion::VC1A;
 
   static constexpr ControllerType DEFAULT_CONTROLLER_1_TYPE = ControllerType::AnalogController;
@@ -529,6 +541,9 @@ struct Settings
 #endif
   static constexpr AudioStretchMode DEFAULT_AUDIO_STRETCH_MODE = AudioStretchMode::TimeStretch;
 
+  static constexpr u32 DEFAULT_CAPTURE_QUEUE_FRAMES = 8;
+  static constexpr u32 DEFAULT_CAPTURE_KEYFRAME_INTERVAL = 300;
+
   static constexpr bool DEFAULT_SAVE_STATE_COMPRESSION = true;
 
   // Enable console logging by default on Linux platforms.
@@ -7,6 +7,8 @@
 #include "host.h"
 #include "imgui.h"
 #include "interrupt_controller.h"
+#include "media_capture.h"
+#include "perf_sections.h"
 #include "system.h"
 
 #include "util/audio_stream.h"
@@ -16,9 +18,15 @@
 
 #include "common/bitfield.h"
 #include "common/bitutils.h"
+#include "common/error.h"
 #include "common/fifo_queue.h"
+#include "common/file_system.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/timer.h"
+
+#include "xxhash.h"
 
 #include <memory>
 
@@ -53,7 +61,8 @@ enum : u32
   CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400,
   MINIMUM_TICKS_BETWEEN_KEY_ON_OFF = 2,
   NUM_REVERB_REGS = 32,
-  FIFO_SIZE_IN_HALFWORDS = 32
+  FIFO_SIZE_IN_HALFWORDS = 32,
+  MIX_BATCH_FRAMES = 64,
 };
 enum : s16
 {
@@ -310,6 +319,20 @@ struct ReverbRegisters
     u16 rev[NUM_REVERB_REGS];
   };
 };
+
+struct ReverbStateHeader
+{
+  static constexpr u32 MAGIC = 0x52555053; // SPUR
+
+  u32 magic;
+  u32 base_address;
+  u32 current_address;
+  s32 resample_buffer_position;
+  u32 reverb_master_enable;
+  ReverbRegisters registers;
+  std::array<std::array<s16, 128>, 2> downsample_buffer;
+  std::array<std::array<s16, 64>, 2> upsample_buffer;
+};
 } // namespace
 
 static ADSRPhase GetNextADSRPhase(ADSRPhase phase);
@@ -331,15 +354,33 @@ static void WriteToCaptureBuffer(u32 index, s16 value);
 static void IncrementCaptureBufferPosition();
 
 static void ReadADPCMBlock(u16 address, ADPCMBlock* block);
+static s32 TickVoice(Voice& voice, u32 voice_index, s16 noise_level, s32 modulator_volume);
 static std::tuple<s32, s32> SampleVoice(u32 voice_index);
+static bool SampleVoiceFrames(u32 voice_index, u32 num_frames, const s16* noise_levels, const s16* modulator_volumes,
+                              s16* volumes, s16* left_levels, s16* right_levels);
+static void MixVoiceFrames(u32 num_frames, const s16* volumes, const s16* left_levels, const s16* right_levels,
+                           s32* left_sum, s32* right_sum);
 
 static void UpdateNoise();
 
+template<bool wrap>
 static u32 ReverbMemoryAddress(u32 address);
+template<bool wrap>
 static s16 ReverbRead(u32 address, s32 offset = 0);
+template<bool wrap>
 static void ReverbWrite(u32 address, s16 data);
+static void UpdateReverbMaxOffset();
+template<bool wrap>
+static void ProcessReverbStep(const std::array<s32, 2>& downsampled);
+template<bool vector>
 static void ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out);
 
+static void MixFrame(s16* output_frame);
+static void MixFrames(s16* output_frames, u32 num_frames);
+static bool VoicesMayReadWrittenRAM(u32 num_frames);
+static void FinishFrame(s16* output_frame, s32 left_sum, s32 right_sum, s32 reverb_in_left, s32 reverb_in_right,
+                        s16 capture_voice1, s16 capture_voice3);
+static void KeyOnOffVoices();
 static void Execute(void* param, TickCount ticks, TickCount ticks_late);
 static void UpdateEventInterval();
 
@@ -355,6 +396,8 @@ static void CreateOutputStream();
 static std::unique_ptr<TimingEvent> s_tick_event;
 static std::unique_ptr<TimingEvent> s_transfer_event;
 static std::unique_ptr<WAVWriter> s_dump_writer;
+static std::unique_ptr<XXH3_state_t, void (*)(XXH3_state_t*)> s_output_hash_state(
+  nullptr, [](XXH3_state_t* state) { XXH3_freeState(state); });
 static std::unique_ptr<AudioStream> s_audio_stream;
 static std::unique_ptr<AudioStream> s_null_audio_stream;
 static bool s_audio_output_muted = false;
@@ -396,6 +439,7 @@ static u32 s_noise_level = 0;
 static u32 s_reverb_on_register = 0;
 static u32 s_reverb_base_address = 0;
 static u32 s_reverb_current_address = 0;
+static u32 s_reverb_max_offset = 0;
 static ReverbRegisters s_reverb_registers{};
 static std::array<std::array<s16, 128>, 2> s_reverb_downsample_buffer;
 static std::array<std::array<s16, 64>, 2> s_reverb_upsample_buffer;
@@ -503,6 +547,7 @@ void SPU::Reset()
   s_reverb_registers = {};
   s_reverb_registers.mBASE = 0;
   s_reverb_base_address = s_reverb_current_address = ZeroExtend32(s_reverb_registers.mBASE) << 2;
+  UpdateReverbMaxOffset();
   s_reverb_downsample_buffer = {};
   s_reverb_upsample_buffer = {};
   s_reverb_resample_buffer_position = 0;
@@ -593,6 +638,7 @@ bool SPU::DoState(StateWrapper& sw)
 
   if (sw.IsReading())
   {
+    UpdateReverbMaxOffset();
     UpdateEventInterval();
     UpdateTransferEvent();
   }
@@ -1004,6 +1050,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
         Log_DebugFmt("SPU reverb register {} <- 0x{:04X}", reg, value);
         GeneratePendingSamples();
         s_reverb_registers.rev[reg] = value;
+        UpdateReverbMaxOffset();
         return;
       }
 
@@ -1247,6 +1294,8 @@ ALWAYS_INLINE_RELEASE void SPU::ExecuteFIFOWriteToRAM(TickCount& ticks)
 
 void SPU::ExecuteTransfer(void* param, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::SPU);
+
   const RAMTransferMode mode = s_SPUCNT.ram_transfer_mode;
   DebugAssert(mode != RAMTransferMode::Stopped);
 
@@ -1535,6 +1584,31 @@ bool SPU::StopDumpingAudio()
   return true;
 }
 
+void SPU::SetOutputHashingEnabled(bool enabled)
+{
+  if (!enabled)
+  {
+    s_output_hash_state.reset();
+    return;
+  }
+
+  if (!s_output_hash_state)
+  {
+    s_output_hash_state.reset(XXH3_createState());
+    XXH3_64bits_reset(s_output_hash_state.get());
+  }
+}
+
+u64 SPU::GetAndResetOutputHash()
+{
+  if (!s_output_hash_state)
+    return 0;
+
+  const u64 hash = XXH3_64bits_digest(s_output_hash_state.get());
+  XXH3_64bits_reset(s_output_hash_state.get());
+  return hash;
+}
+
 const std::array<u8, SPU::RAM_SIZE>& SPU::GetRAM()
 {
   return s_ram;
@@ -1938,24 +2012,8 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
-ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+ALWAYS_INLINE_RELEASE s32 SPU::TickVoice(Voice& voice, u32 voice_index, s16 noise_level, s32 modulator_volume)
 {
-  Voice& voice = s_voices[voice_index];
-  if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
-  {
-    voice.last_volume = 0;
-
-#ifdef SPU_DUMP_ALL_VOICES
-    if (s_voice_dump_writers[voice_index])
-    {
-      const s16 dump_samples[2] = {0, 0};
-      s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
-    }
-#endif
-
-    return {};
-  }
-
   if (!voice.has_samples)
   {
     ADPCMBlock block;
@@ -1977,7 +2035,7 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     // interpolate/sample and apply ADSR volume
     s32 sample;
     if (IsVoiceNoiseEnabled(voice_index))
-      sample = GetVoiceNoiseLevel();
+      sample = noise_level;
     else
       sample = voice.Interpolate();
 
@@ -1997,7 +2055,7 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
   u16 step = voice.regs.adpcm_sample_rate;
   if (IsPitchModulationEnabled(voice_index))
   {
-    const s32 factor = std::clamp<s32>(s_voices[voice_index - 1].last_volume, -0x8000, 0x7FFF) + 0x8000;
+    const s32 factor = std::clamp<s32>(modulator_volume, -0x8000, 0x7FFF) + 0x8000;
     step = Truncate16(static_cast<u32>((SignExtend32(step) * factor) >> 15));
   }
   step = std::min<u16>(step, 0x3FFF);
@@ -2042,6 +2100,30 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     }
   }
 
+  return volume;
+}
+
+ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+{
+  Voice& voice = s_voices[voice_index];
+  if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+  {
+    voice.last_volume = 0;
+
+#ifdef SPU_DUMP_ALL_VOICES
+    if (s_voice_dump_writers[voice_index])
+    {
+      const s16 dump_samples[2] = {0, 0};
+      s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+    }
+#endif
+
+    return {};
+  }
+
+  const s32 volume =
+    TickVoice(voice, voice_index, GetVoiceNoiseLevel(), (voice_index > 0) ? s_voices[voice_index - 1].last_volume : 0);
+
   // apply per-channel volume
   const s32 left = ApplyVolume(volume, voice.left_volume.current_level);
   const s32 right = ApplyVolume(volume, voice.right_volume.current_level);
@@ -2059,6 +2141,111 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
   return std::make_tuple(left, right);
 }
 
+bool SPU::SampleVoiceFrames(u32 voice_index, u32 num_frames, const s16* noise_levels, const s16* modulator_volumes,
+                            s16* volumes, s16* left_levels, s16* right_levels)
+{
+  // Only used when RAM IRQs are disabled, so voices which are off do not need to be sampled. Nothing can key a voice
+  // on within the batch, so once it is off it stays off.
+  DebugAssert(!s_SPUCNT.irq9_enable);
+  Voice& voice = s_voices[voice_index];
+
+  u32 frame = 0;
+  for (; frame < num_frames && voice.IsOn(); frame++)
+  {
+    // Samples from the voice are always 16-bit, since the gaussian filter and ADSR volume can't exceed unity gain.
+    const s32 volume = TickVoice(voice, voice_index, noise_levels[frame], modulator_volumes[frame]);
+    volumes[frame] = static_cast<s16>(volume);
+    left_levels[frame] = voice.left_volume.current_level;
+    right_levels[frame] = voice.right_volume.current_level;
+    voice.left_volume.Tick();
+    voice.right_volume.Tick();
+  }
+
+  const bool active = (frame > 0);
+  if (frame < num_frames)
+  {
+    voice.last_volume = 0;
+    std::fill_n(&volumes[frame], num_frames - frame, static_cast<s16>(0));
+    std::fill_n(&left_levels[frame], num_frames - frame, static_cast<s16>(0));
+    std::fill_n(&right_levels[frame], num_frames - frame, static_cast<s16>(0));
+  }
+
+#ifdef SPU_DUMP_ALL_VOICES
+  if (s_voice_dump_writers[voice_index])
+  {
+    for (u32 i = 0; i < num_frames; i++)
+    {
+      const s16 dump_samples[2] = {static_cast<s16>(Clamp16(ApplyVolume(volumes[i], left_levels[i]))),
+                                   static_cast<s16>(Clamp16(ApplyVolume(volumes[i], right_levels[i])))};
+      s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+    }
+  }
+#endif
+
+  return active;
+}
+
+ALWAYS_INLINE_RELEASE void SPU::MixVoiceFrames(u32 num_frames, const s16* volumes, const s16* left_levels,
+                                               const s16* right_levels, s32* left_sum, s32* right_sum)
+{
+  u32 frame = 0;
+
+#if defined(CPU_ARCH_SSE)
+  for (; (frame + 8) <= num_frames; frame += 8)
+  {
+    const __m128i volume = _mm_load_si128(reinterpret_cast<const __m128i*>(&volumes[frame]));
+    const __m128i left_level = _mm_load_si128(reinterpret_cast<const __m128i*>(&left_levels[frame]));
+    const __m128i right_level = _mm_load_si128(reinterpret_cast<const __m128i*>(&right_levels[frame]));
+
+    // 16x16->32 multiply from the low and high halves of the product.
+    const __m128i left_lo = _mm_mullo_epi16(volume, left_level);
+    const __m128i left_hi = _mm_mulhi_epi16(volume, left_level);
+    const __m128i right_lo = _mm_mullo_epi16(volume, right_level);
+    const __m128i right_hi = _mm_mulhi_epi16(volume, right_level);
+
+    __m128i* const left_ptr = reinterpret_cast<__m128i*>(&left_sum[frame]);
+    __m128i* const right_ptr = reinterpret_cast<__m128i*>(&right_sum[frame]);
+    _mm_store_si128(
+      &left_ptr[0],
+      _mm_add_epi32(_mm_load_si128(&left_ptr[0]), _mm_srai_epi32(_mm_unpacklo_epi16(left_lo, left_hi), 15)));
+    _mm_store_si128(
+      &left_ptr[1],
+      _mm_add_epi32(_mm_load_si128(&left_ptr[1]), _mm_srai_epi32(_mm_unpackhi_epi16(left_lo, left_hi), 15)));
+    _mm_store_si128(
+      &right_ptr[0],
+      _mm_add_epi32(_mm_load_si128(&right_ptr[0]), _mm_srai_epi32(_mm_unpacklo_epi16(right_lo, right_hi), 15)));
+    _mm_store_si128(
+      &right_ptr[1],
+      _mm_add_epi32(_mm_load_si128(&right_ptr[1]), _mm_srai_epi32(_mm_unpackhi_epi16(right_lo, right_hi), 15)));
+  }
+#elif defined(CPU_ARCH_NEON)
+  for (; (frame + 8) <= num_frames; frame += 8)
+  {
+    const int16x8_t volume = vld1q_s16(&volumes[frame]);
+    const int16x8_t left_level = vld1q_s16(&left_levels[frame]);
+    const int16x8_t right_level = vld1q_s16(&right_levels[frame]);
+
+    vst1q_s32(&left_sum[frame], vaddq_s32(vld1q_s32(&left_sum[frame]),
+                                          vshrq_n_s32(vmull_s16(vget_low_s16(volume), vget_low_s16(left_level)), 15)));
+    vst1q_s32(&left_sum[frame + 4],
+              vaddq_s32(vld1q_s32(&left_sum[frame + 4]),
+                        vshrq_n_s32(vmull_s16(vget_high_s16(volume), vget_high_s16(left_level)), 15)));
+    vst1q_s32(&right_sum[frame],
+              vaddq_s32(vld1q_s32(&right_sum[frame]),
+                        vshrq_n_s32(vmull_s16(vget_low_s16(volume), vget_low_s16(right_level)), 15)));
+    vst1q_s32(&right_sum[frame + 4],
+              vaddq_s32(vld1q_s32(&right_sum[frame + 4]),
+                        vshrq_n_s32(vmull_s16(vget_high_s16(volume), vget_high_s16(right_level)), 15)));
+  }
+#endif
+
+  for (; frame < num_frames; frame++)
+  {
+    left_sum[frame] += ApplyVolume(volumes[frame], left_levels[frame]);
+    right_sum[frame] += ApplyVolume(volumes[frame], right_levels[frame]);
+  }
+}
+
 void SPU::UpdateNoise()
 {
   // Dr Hell's noise waveform, implementation borrowed from pcsx-r.
@@ -2088,34 +2275,65 @@ void SPU::UpdateNoise()
 /* Reverb algorithm from Mednafen-PSX                                   */
 /************************************************************************/
 
-u32 SPU::ReverbMemoryAddress(u32 address)
+static constexpr u32 REVERB_ADDRESS_MASK = (SPU::RAM_SIZE - 1) / 2;
+
+template<bool wrap>
+ALWAYS_INLINE u32 SPU::ReverbMemoryAddress(u32 address)
 {
   // Ensures address does not leave the reverb work area.
-  static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
-  u32 offset = s_reverb_current_address + (address & MASK);
-  offset += s_reverb_base_address & ((s32)(offset << 13) >> 31);
+  u32 offset = s_reverb_current_address + (address & REVERB_ADDRESS_MASK);
+  if constexpr (wrap)
+  {
+    offset += s_reverb_base_address & ((s32)(offset << 13) >> 31);
+  }
+  else
+  {
+    DebugAssert(offset <= REVERB_ADDRESS_MASK);
+  }
 
   // We address RAM in bytes. TODO: Change this to words.
-  return (offset & MASK) * 2u;
+  return (offset & REVERB_ADDRESS_MASK) * 2u;
 }
 
-s16 SPU::ReverbRead(u32 address, s32 offset)
+template<bool wrap>
+ALWAYS_INLINE s16 SPU::ReverbRead(u32 address, s32 offset)
 {
   // TODO: This should check interrupts.
-  const u32 real_address = ReverbMemoryAddress((address << 2) + offset);
+  const u32 real_address = ReverbMemoryAddress<wrap>((address << 2) + offset);
 
   s16 data;
   std::memcpy(&data, &s_ram[real_address], sizeof(data));
   return data;
 }
 
-void SPU::ReverbWrite(u32 address, s16 data)
+template<bool wrap>
+ALWAYS_INLINE void SPU::ReverbWrite(u32 address, s16 data)
 {
   // TODO: This should check interrupts.
-  const u32 real_address = ReverbMemoryAddress(address << 2);
+  const u32 real_address = ReverbMemoryAddress<wrap>(address << 2);
   std::memcpy(&s_ram[real_address], &data, sizeof(data));
 }
 
+void SPU::UpdateReverbMaxOffset()
+{
+  // Furthest any access in ProcessReverbStep() can be from the current address. If the current address plus this
+  // doesn't reach the end of RAM, none of the accesses for that step need to wrap back to the base address.
+  const ReverbRegisters& rr = s_reverb_registers;
+  const auto offset = [](u32 address, s32 offset = 0) { return ((address << 2) + offset) & REVERB_ADDRESS_MASK; };
+  u32 max_offset = 0;
+  for (u32 lr = 0; lr < 2; lr++)
+  {
+    max_offset = std::max({max_offset, offset(rr.IIR_SRC_A[lr]), offset(rr.IIR_SRC_B[lr]),
+                           offset(rr.IIR_DEST_A[lr]), offset(rr.IIR_DEST_A[lr], -1), offset(rr.IIR_DEST_B[lr]),
+                           offset(rr.IIR_DEST_B[lr], -1), offset(rr.ACC_SRC_A[lr]), offset(rr.ACC_SRC_B[lr]),
+                           offset(rr.ACC_SRC_C[lr]), offset(rr.ACC_SRC_D[lr]), offset(rr.MIX_DEST_A[lr]),
+                           offset(rr.MIX_DEST_B[lr]), offset(rr.MIX_DEST_A[lr] - rr.FB_SRC_A),
+                           offset(rr.MIX_DEST_B[lr] - rr.FB_SRC_B)});
+  }
+
+  s_reverb_max_offset = max_offset;
+}
+
 // Zeroes optimized out; middle removed too(it's 16384)
 static constexpr std::array<s16, 20> s_reverb_resample_coefficients = {
   -1, 2, -10, 35, -103, 266, -616, 1332, -2960, 10246, 10246, -2960, 1332, -616, 266, -103, 35, -10, 2, -1,
@@ -2157,6 +2375,69 @@ ALWAYS_INLINE static s32 Reverb2244(const s16* src)
   return out;
 }
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+
+// The downsampler reads every other sample, so the coefficients are spread out with zeros between them. The middle
+// tap lands on one of those zeros, so it can be included too. Both filters read past the last tap, which is fine
+// since the resampling buffers are mirrored and have room for it.
+static constexpr std::array<s16, 40> ComputeReverbDownsampleVectorCoefficients()
+{
+  std::array<s16, 40> coefficients = {};
+  for (u32 i = 0; i < 20; i++)
+    coefficients[i * 2] = s_reverb_resample_coefficients[i];
+  coefficients[19] = 0x4000;
+  return coefficients;
+}
+alignas(VECTOR_ALIGNMENT) static constexpr std::array<s16, 40> s_reverb_downsample_vector_coefficients =
+  ComputeReverbDownsampleVectorCoefficients();
+alignas(VECTOR_ALIGNMENT) static constexpr std::array<s16, 24> s_reverb_upsample_vector_coefficients = {
+  -1, 2, -10, 35, -103, 266, -616, 1332, -2960, 10246, 10246, -2960, 1332, -616, 266, -103, 35, -10, 2, -1, 0, 0, 0, 0,
+};
+
+template<u32 num_vectors>
+ALWAYS_INLINE static s32 ReverbDotProduct(const s16* src, const s16* coefficients)
+{
+#if defined(CPU_ARCH_SSE)
+  __m128i sum = _mm_setzero_si128();
+  for (u32 i = 0; i < num_vectors; i++)
+  {
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i * 8])),
+                                            _mm_load_si128(reinterpret_cast<const __m128i*>(&coefficients[i * 8]))));
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+#elif defined(CPU_ARCH_NEON)
+  int32x4_t sum = vdupq_n_s32(0);
+  for (u32 i = 0; i < num_vectors; i++)
+  {
+    const int16x8_t samples = vld1q_s16(&src[i * 8]);
+    const int16x8_t coeffs = vld1q_s16(&coefficients[i * 8]);
+    sum = vmlal_s16(sum, vget_low_s16(samples), vget_low_s16(coeffs));
+    sum = vmlal_s16(sum, vget_high_s16(samples), vget_high_s16(coeffs));
+  }
+  return vaddvq_s32(sum);
+#endif
+}
+
+ALWAYS_INLINE static s32 Reverb4422Vector(const s16* src)
+{
+  const s32 out = ReverbDotProduct<5>(src, s_reverb_downsample_vector_coefficients.data()) >> 15;
+  return std::clamp<s32>(out, -32768, 32767);
+}
+
+template<bool phase>
+ALWAYS_INLINE static s32 Reverb2244Vector(const s16* src)
+{
+  if (phase)
+    return src[9];
+
+  const s32 out = ReverbDotProduct<3>(src, s_reverb_upsample_vector_coefficients.data()) >> 14;
+  return std::clamp<s32>(out, -32768, 32767);
+}
+
+#endif
+
 ALWAYS_INLINE static s16 ReverbSat(s32 val)
 {
   return static_cast<s16>(std::clamp<s32>(val, -0x8000, 0x7FFF));
@@ -2183,6 +2464,59 @@ ALWAYS_INLINE static s32 IIASM(const s16 IIR_ALPHA, const s16 insamp)
     return insamp * (32768 - IIR_ALPHA);
 }
 
+template<bool wrap>
+ALWAYS_INLINE_RELEASE void SPU::ProcessReverbStep(const std::array<s32, 2>& downsampled)
+{
+  for (unsigned lr = 0; lr < 2; lr++)
+  {
+    if (s_SPUCNT.reverb_master_enable)
+    {
+      const s16 IIR_INPUT_A =
+        ReverbSat((((ReverbRead<wrap>(s_reverb_registers.IIR_SRC_A[lr ^ 0]) * s_reverb_registers.IIR_COEF) >> 14) +
+                   ((downsampled[lr] * s_reverb_registers.IN_COEF[lr]) >> 14)) >>
+                  1);
+      const s16 IIR_INPUT_B =
+        ReverbSat((((ReverbRead<wrap>(s_reverb_registers.IIR_SRC_B[lr ^ 1]) * s_reverb_registers.IIR_COEF) >> 14) +
+                   ((downsampled[lr] * s_reverb_registers.IN_COEF[lr]) >> 14)) >>
+                  1);
+      const s16 IIR_A = ReverbSat(
+        (((IIR_INPUT_A * s_reverb_registers.IIR_ALPHA) >> 14) +
+         (IIASM(s_reverb_registers.IIR_ALPHA, ReverbRead<wrap>(s_reverb_registers.IIR_DEST_A[lr], -1)) >> 14)) >>
+        1);
+      const s16 IIR_B = ReverbSat(
+        (((IIR_INPUT_B * s_reverb_registers.IIR_ALPHA) >> 14) +
+         (IIASM(s_reverb_registers.IIR_ALPHA, ReverbRead<wrap>(s_reverb_registers.IIR_DEST_B[lr], -1)) >> 14)) >>
+        1);
+
+      ReverbWrite<wrap>(s_reverb_registers.IIR_DEST_A[lr], IIR_A);
+      ReverbWrite<wrap>(s_reverb_registers.IIR_DEST_B[lr], IIR_B);
+    }
+
+    const s32 ACC = ((ReverbRead<wrap>(s_reverb_registers.ACC_SRC_A[lr]) * s_reverb_registers.ACC_COEF_A) >> 14) +
+                    ((ReverbRead<wrap>(s_reverb_registers.ACC_SRC_B[lr]) * s_reverb_registers.ACC_COEF_B) >> 14) +
+                    ((ReverbRead<wrap>(s_reverb_registers.ACC_SRC_C[lr]) * s_reverb_registers.ACC_COEF_C) >> 14) +
+                    ((ReverbRead<wrap>(s_reverb_registers.ACC_SRC_D[lr]) * s_reverb_registers.ACC_COEF_D) >> 14);
+
+    const s16 FB_A = ReverbRead<wrap>(s_reverb_registers.MIX_DEST_A[lr] - s_reverb_registers.FB_SRC_A);
+    const s16 FB_B = ReverbRead<wrap>(s_reverb_registers.MIX_DEST_B[lr] - s_reverb_registers.FB_SRC_B);
+    const s16 MDA = ReverbSat((ACC + ((FB_A * ReverbNeg(s_reverb_registers.FB_ALPHA)) >> 14)) >> 1);
+    const s16 MDB = ReverbSat(
+      FB_A +
+      ((((MDA * s_reverb_registers.FB_ALPHA) >> 14) + ((FB_B * ReverbNeg(s_reverb_registers.FB_X)) >> 14)) >> 1));
+    const s16 IVB = ReverbSat(FB_B + ((MDB * s_reverb_registers.FB_X) >> 15));
+
+    if (s_SPUCNT.reverb_master_enable)
+    {
+      ReverbWrite<wrap>(s_reverb_registers.MIX_DEST_A[lr], MDA);
+      ReverbWrite<wrap>(s_reverb_registers.MIX_DEST_B[lr], MDB);
+    }
+
+    s_reverb_upsample_buffer[lr][(s_reverb_resample_buffer_position >> 1) | 0x20] =
+      s_reverb_upsample_buffer[lr][s_reverb_resample_buffer_position >> 1] = IVB;
+  }
+}
+
+template<bool vector>
 void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out)
 {
   s_last_reverb_input[0] = left_in;
@@ -2196,64 +2530,37 @@ void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out
   if (s_reverb_resample_buffer_position & 1u)
   {
     std::array<s32, 2> downsampled;
-    for (unsigned lr = 0; lr < 2; lr++)
-      downsampled[lr] = Reverb4422(&s_reverb_downsample_buffer[lr][(s_reverb_resample_buffer_position - 38) & 0x3F]);
-
     for (unsigned lr = 0; lr < 2; lr++)
     {
-      if (s_SPUCNT.reverb_master_enable)
-      {
-        const s16 IIR_INPUT_A =
-          ReverbSat((((ReverbRead(s_reverb_registers.IIR_SRC_A[lr ^ 0]) * s_reverb_registers.IIR_COEF) >> 14) +
-                     ((downsampled[lr] * s_reverb_registers.IN_COEF[lr]) >> 14)) >>
-                    1);
-        const s16 IIR_INPUT_B =
-          ReverbSat((((ReverbRead(s_reverb_registers.IIR_SRC_B[lr ^ 1]) * s_reverb_registers.IIR_COEF) >> 14) +
-                     ((downsampled[lr] * s_reverb_registers.IN_COEF[lr]) >> 14)) >>
-                    1);
-        const s16 IIR_A =
-          ReverbSat((((IIR_INPUT_A * s_reverb_registers.IIR_ALPHA) >> 14) +
-                     (IIASM(s_reverb_registers.IIR_ALPHA, ReverbRead(s_reverb_registers.IIR_DEST_A[lr], -1)) >> 14)) >>
-                    1);
-        const s16 IIR_B =
-          ReverbSat((((IIR_INPUT_B * s_reverb_registers.IIR_ALPHA) >> 14) +
-                     (IIASM(s_reverb_registers.IIR_ALPHA, ReverbRead(s_reverb_registers.IIR_DEST_B[lr], -1)) >> 14)) >>
-                    1);
-
-        ReverbWrite(s_reverb_registers.IIR_DEST_A[lr], IIR_A);
-        ReverbWrite(s_reverb_registers.IIR_DEST_B[lr], IIR_B);
-      }
-
-      const s32 ACC = ((ReverbRead(s_reverb_registers.ACC_SRC_A[lr]) * s_reverb_registers.ACC_COEF_A) >> 14) +
-                      ((ReverbRead(s_reverb_registers.ACC_SRC_B[lr]) * s_reverb_registers.ACC_COEF_B) >> 14) +
-                      ((ReverbRead(s_reverb_registers.ACC_SRC_C[lr]) * s_reverb_registers.ACC_COEF_C) >> 14) +
-                      ((ReverbRead(s_reverb_registers.ACC_SRC_D[lr]) * s_reverb_registers.ACC_COEF_D) >> 14);
-
-      const s16 FB_A = ReverbRead(s_reverb_registers.MIX_DEST_A[lr] - s_reverb_registers.FB_SRC_A);
-      const s16 FB_B = ReverbRead(s_reverb_registers.MIX_DEST_B[lr] - s_reverb_registers.FB_SRC_B);
-      const s16 MDA = ReverbSat((ACC + ((FB_A * ReverbNeg(s_reverb_registers.FB_ALPHA)) >> 14)) >> 1);
-      const s16 MDB = ReverbSat(
-        FB_A +
-        ((((MDA * s_reverb_registers.FB_ALPHA) >> 14) + ((FB_B * ReverbNeg(s_reverb_registers.FB_X)) >> 14)) >> 1));
-      const s16 IVB = ReverbSat(FB_B + ((MDB * s_reverb_registers.FB_X) >> 15));
-
-      if (s_SPUCNT.reverb_master_enable)
-      {
-        ReverbWrite(s_reverb_registers.MIX_DEST_A[lr], MDA);
-        ReverbWrite(s_reverb_registers.MIX_DEST_B[lr], MDB);
-      }
-
-      s_reverb_upsample_buffer[lr][(s_reverb_resample_buffer_position >> 1) | 0x20] =
-        s_reverb_upsample_buffer[lr][s_reverb_resample_buffer_position >> 1] = IVB;
+      const s16* src = &s_reverb_downsample_buffer[lr][(s_reverb_resample_buffer_position - 38) & 0x3F];
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+      if constexpr (vector)
+        downsampled[lr] = Reverb4422Vector(src);
+      else
+#endif
+        downsampled[lr] = Reverb4422(src);
     }
 
+    // Only check for wraparound once per step, instead of for every access.
+    if ((s_reverb_current_address + s_reverb_max_offset) <= REVERB_ADDRESS_MASK)
+      ProcessReverbStep<false>(downsampled);
+    else
+      ProcessReverbStep<true>(downsampled);
+
     s_reverb_current_address = (s_reverb_current_address + 1) & 0x3FFFFu;
     if (s_reverb_current_address == 0)
       s_reverb_current_address = s_reverb_base_address;
 
     for (unsigned lr = 0; lr < 2; lr++)
-      out[lr] =
-        Reverb2244<false>(&s_reverb_upsample_buffer[lr][((s_reverb_resample_buffer_position >> 1) - 19) & 0x1F]);
+    {
+      const s16* src = &s_reverb_upsample_buffer[lr][((s_reverb_resample_buffer_position >> 1) - 19) & 0x1F];
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+      if constexpr (vector)
+        out[lr] = Reverb2244Vector<false>(src);
+      else
+#endif
+        out[lr] = Reverb2244<false>(src);
+    }
   }
   else
   {
@@ -2278,6 +2585,8 @@ void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out
 
 void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
 {
+  PerfSections::Scope perf_scope(PerfSections::Section::SPU);
+
   u32 remaining_frames;
   if (g_settings.cpu_overclock_active)
   {
@@ -2302,107 +2611,235 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
 
     s16* output_frame = output_frame_start;
     const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
-    for (u32 i = 0; i < frames_in_this_batch; i++)
+    u32 frames_mixed = 0;
+    while (frames_mixed < frames_in_this_batch)
     {
-      s32 left_sum = 0;
-      s32 right_sum = 0;
-      s32 reverb_in_left = 0;
-      s32 reverb_in_right = 0;
-
-      u32 reverb_on_register = s_reverb_on_register;
-
-      for (u32 voice = 0; voice < NUM_VOICES; voice++)
+      // Key on/off happens after the first frame, and RAM IRQs depend on the order voices read memory in, so both of
+      // these need to go through the frame-at-a-time path. So do voices playing from memory that the capture buffers
+      // or reverb write to, since they must see each frame's writes. Everything else can be mixed one voice at a time.
+      const u32 frames_to_mix = std::min<u32>(frames_in_this_batch - frames_mixed, MIX_BATCH_FRAMES);
+      if (s_SPUCNT.irq9_enable || (frames_mixed == 0 && (s_key_off_register != 0 || s_key_on_register != 0)) ||
+          VoicesMayReadWrittenRAM(frames_to_mix))
       {
-        const auto [left, right] = SampleVoice(voice);
-        left_sum += left;
-        right_sum += right;
+        MixFrame(output_frame);
+        if (frames_mixed == 0)
+          KeyOnOffVoices();
 
-        if (reverb_on_register & 1u)
-        {
-          reverb_in_left += left;
-          reverb_in_right += right;
-        }
-        reverb_on_register >>= 1;
+        output_frame += NUM_CHANNELS;
+        frames_mixed++;
       }
-
-      if (!s_SPUCNT.mute_n)
+      else
       {
-        left_sum = 0;
-        right_sum = 0;
+        MixFrames(output_frame, frames_to_mix);
+        output_frame += frames_to_mix * NUM_CHANNELS;
+        frames_mixed += frames_to_mix;
       }
+    }
 
-      // Update noise once per frame.
-      UpdateNoise();
+    if (s_dump_writer)
+      s_dump_writer->WriteFrames(output_frame_start, frames_in_this_batch);
+    if (MediaCapture::IsCapturing())
+    {
+      if (s_audio_output_muted)
+        MediaCapture::CaptureSilence(frames_in_this_batch);
+      else
+        MediaCapture::CaptureAudio(output_frame_start, frames_in_this_batch);
+    }
+    if (s_output_hash_state)
+      XXH3_64bits_update(s_output_hash_state.get(), output_frame_start,
+                         frames_in_this_batch * NUM_CHANNELS * sizeof(s16));
 
-      // Mix in CD audio.
-      const auto [cd_audio_left, cd_audio_right] = CDROM::GetAudioFrame();
-      if (s_SPUCNT.cd_audio_enable)
-      {
-        const s32 cd_audio_volume_left = ApplyVolume(s32(cd_audio_left), s_cd_audio_volume_left);
-        const s32 cd_audio_volume_right = ApplyVolume(s32(cd_audio_right), s_cd_audio_volume_right);
+    output_stream->EndWrite(frames_in_this_batch);
+    remaining_frames -= frames_in_this_batch;
+  }
+}
 
-        left_sum += cd_audio_volume_left;
-        right_sum += cd_audio_volume_right;
+void SPU::MixFrame(s16* output_frame)
+{
+  s32 left_sum = 0;
+  s32 right_sum = 0;
+  s32 reverb_in_left = 0;
+  s32 reverb_in_right = 0;
 
-        if (s_SPUCNT.cd_audio_reverb)
-        {
-          reverb_in_left += cd_audio_volume_left;
-          reverb_in_right += cd_audio_volume_right;
-        }
-      }
+  u32 reverb_on_register = s_reverb_on_register;
 
-      // Compute reverb.
-      s32 reverb_out_left, reverb_out_right;
-      ProcessReverb(static_cast<s16>(Clamp16(reverb_in_left)), static_cast<s16>(Clamp16(reverb_in_right)),
-                    &reverb_out_left, &reverb_out_right);
-
-      // Mix in reverb.
-      left_sum += reverb_out_left;
-      right_sum += reverb_out_right;
-
-      // Apply main volume after clamping. A maximum volume should not overflow here because both are 16-bit values.
-      *(output_frame++) = static_cast<s16>(ApplyVolume(Clamp16(left_sum), s_main_volume_left.current_level));
-      *(output_frame++) = static_cast<s16>(ApplyVolume(Clamp16(right_sum), s_main_volume_right.current_level));
-      s_main_volume_left.Tick();
-      s_main_volume_right.Tick();
-
-      // Write to capture buffers.
-      WriteToCaptureBuffer(0, cd_audio_left);
-      WriteToCaptureBuffer(1, cd_audio_right);
-      WriteToCaptureBuffer(2, static_cast<s16>(Clamp16(s_voices[1].last_volume)));
-      WriteToCaptureBuffer(3, static_cast<s16>(Clamp16(s_voices[3].last_volume)));
-      IncrementCaptureBufferPosition();
-
-      // Key off/on voices after the first frame.
-      if (i == 0 && (s_key_off_register != 0 || s_key_on_register != 0))
-      {
-        u32 key_off_register = s_key_off_register;
-        s_key_off_register = 0;
+  for (u32 voice = 0; voice < NUM_VOICES; voice++)
+  {
+    const auto [left, right] = SampleVoice(voice);
+    left_sum += left;
+    right_sum += right;
 
-        u32 key_on_register = s_key_on_register;
-        s_key_on_register = 0;
+    if (reverb_on_register & 1u)
+    {
+      reverb_in_left += left;
+      reverb_in_right += right;
+    }
+    reverb_on_register >>= 1;
+  }
 
-        for (u32 voice = 0; voice < NUM_VOICES; voice++)
-        {
-          if (key_off_register & 1u)
-            s_voices[voice].KeyOff();
-          key_off_register >>= 1;
+  // Update noise once per frame.
+  UpdateNoise();
 
-          if (key_on_register & 1u)
-          {
-            s_endx_register &= ~(1u << voice);
-            s_voices[voice].KeyOn();
-          }
-          key_on_register >>= 1;
-        }
+  FinishFrame(output_frame, left_sum, right_sum, reverb_in_left, reverb_in_right,
+              static_cast<s16>(Clamp16(s_voices[1].last_volume)), static_cast<s16>(Clamp16(s_voices[3].last_volume)));
+}
+
+void SPU::MixFrames(s16* output_frames, u32 num_frames)
+{
+  DebugAssert(num_frames <= MIX_BATCH_FRAMES);
+
+  alignas(VECTOR_ALIGNMENT) std::array<s32, MIX_BATCH_FRAMES> left_sum;
+  alignas(VECTOR_ALIGNMENT) std::array<s32, MIX_BATCH_FRAMES> right_sum;
+  alignas(VECTOR_ALIGNMENT) std::array<s32, MIX_BATCH_FRAMES> reverb_in_left;
+  alignas(VECTOR_ALIGNMENT) std::array<s32, MIX_BATCH_FRAMES> reverb_in_right;
+  alignas(VECTOR_ALIGNMENT) std::array<s16, MIX_BATCH_FRAMES> left_levels;
+  alignas(VECTOR_ALIGNMENT) std::array<s16, MIX_BATCH_FRAMES> right_levels;
+  alignas(VECTOR_ALIGNMENT) std::array<s16, MIX_BATCH_FRAMES> noise_levels;
+  alignas(VECTOR_ALIGNMENT) std::array<std::array<s16, MIX_BATCH_FRAMES>, 2> voice_volumes;
+  std::array<std::array<s16, MIX_BATCH_FRAMES>, 2> capture_volumes;
+  std::fill_n(left_sum.begin(), num_frames, 0);
+  std::fill_n(right_sum.begin(), num_frames, 0);
+  std::fill_n(reverb_in_left.begin(), num_frames, 0);
+  std::fill_n(reverb_in_right.begin(), num_frames, 0);
+
+  // Noise only depends on its own state, so it can be stepped ahead for the whole batch.
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    noise_levels[i] = GetVoiceNoiseLevel();
+    UpdateNoise();
+  }
+
+  // Each voice's volumes are kept around for the next voice, since it can use them for pitch modulation.
+  std::fill_n(voice_volumes[1].begin(), num_frames, static_cast<s16>(0));
+  u32 reverb_on_register = s_reverb_on_register;
+  for (u32 voice = 0; voice < NUM_VOICES; voice++)
+  {
+    s16* const volumes = voice_volumes[voice & 1].data();
+    const s16* const modulator_volumes = voice_volumes[(voice & 1) ^ 1].data();
+    if (SampleVoiceFrames(voice, num_frames, noise_levels.data(), modulator_volumes, volumes, left_levels.data(),
+                          right_levels.data()))
+    {
+      MixVoiceFrames(num_frames, volumes, left_levels.data(), right_levels.data(), left_sum.data(), right_sum.data());
+      if (reverb_on_register & 1u)
+      {
+        MixVoiceFrames(num_frames, volumes, left_levels.data(), right_levels.data(), reverb_in_left.data(),
+                       reverb_in_right.data());
       }
     }
 
-    if (s_dump_writer)
-      s_dump_writer->WriteFrames(output_frame_start, frames_in_this_batch);
+    if (voice == 1 || voice == 3)
+      std::copy_n(volumes, num_frames, capture_volumes[voice >> 1].begin());
 
-    output_stream->EndWrite(frames_in_this_batch);
-    remaining_frames -= frames_in_this_batch;
+    reverb_on_register >>= 1;
+  }
+
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    FinishFrame(&output_frames[i * NUM_CHANNELS], left_sum[i], right_sum[i], reverb_in_left[i], reverb_in_right[i],
+                capture_volumes[0][i], capture_volumes[1][i]);
+  }
+}
+
+bool SPU::VoicesMayReadWrittenRAM(u32 num_frames)
+{
+  // The step is capped below 4 samples per frame, so this is the most a voice can read in the batch, including the
+  // block it's partway through. Anything past the end of RAM wraps around to the capture buffers.
+  static constexpr u32 CAPTURE_BUFFERS_END = CAPTURE_BUFFER_SIZE_PER_CHANNEL * 4;
+  const u32 max_read_size = ((num_frames * 4) / NUM_SAMPLES_PER_ADPCM_BLOCK + 2) * sizeof(ADPCMBlock);
+  const u32 reverb_start = s_SPUCNT.reverb_master_enable ? (s_reverb_base_address * 2) : RAM_SIZE;
+  const auto overlaps = [max_read_size, reverb_start](u16 address) {
+    const u32 start = ZeroExtend32(address) * 8;
+    const u32 end = start + max_read_size;
+    return (start < CAPTURE_BUFFERS_END || end > RAM_SIZE || end > reverb_start);
+  };
+
+  // Reaching a loop end jumps to the repeat address, so both places the voice can read from need checking.
+  for (const Voice& voice : s_voices)
+  {
+    if (voice.IsOn() && (overlaps(voice.current_address) || overlaps(voice.regs.adpcm_repeat_address & ~u16(1))))
+      return true;
+  }
+
+  return false;
+}
+
+void SPU::FinishFrame(s16* output_frame, s32 left_sum, s32 right_sum, s32 reverb_in_left, s32 reverb_in_right,
+                      s16 capture_voice1, s16 capture_voice3)
+{
+  if (!s_SPUCNT.mute_n)
+  {
+    left_sum = 0;
+    right_sum = 0;
+  }
+
+  // Mix in CD audio.
+  const auto [cd_audio_left, cd_audio_right] = CDROM::GetAudioFrame();
+  if (s_SPUCNT.cd_audio_enable)
+  {
+    const s32 cd_audio_volume_left = ApplyVolume(s32(cd_audio_left), s_cd_audio_volume_left);
+    const s32 cd_audio_volume_right = ApplyVolume(s32(cd_audio_right), s_cd_audio_volume_right);
+
+    left_sum += cd_audio_volume_left;
+    right_sum += cd_audio_volume_right;
+
+    if (s_SPUCNT.cd_audio_reverb)
+    {
+      reverb_in_left += cd_audio_volume_left;
+      reverb_in_right += cd_audio_volume_right;
+    }
+  }
+
+  // Compute reverb.
+  s32 reverb_out_left, reverb_out_right;
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  ProcessReverb<true>(static_cast<s16>(Clamp16(reverb_in_left)), static_cast<s16>(Clamp16(reverb_in_right)),
+                      &reverb_out_left, &reverb_out_right);
+#else
+  ProcessReverb<false>(static_cast<s16>(Clamp16(reverb_in_left)), static_cast<s16>(Clamp16(reverb_in_right)),
+                       &reverb_out_left, &reverb_out_right);
+#endif
+
+  // Mix in reverb.
+  left_sum += reverb_out_left;
+  right_sum += reverb_out_right;
+
+  // Apply main volume after clamping. A maximum volume should not overflow here because both are 16-bit values.
+  output_frame[0] = static_cast<s16>(ApplyVolume(Clamp16(left_sum), s_main_volume_left.current_level));
+  output_frame[1] = static_cast<s16>(ApplyVolume(Clamp16(right_sum), s_main_volume_right.current_level));
+  s_main_volume_left.Tick();
+  s_main_volume_right.Tick();
+
+  // Write to capture buffers.
+  WriteToCaptureBuffer(0, cd_audio_left);
+  WriteToCaptureBuffer(1, cd_audio_right);
+  WriteToCaptureBuffer(2, capture_voice1);
+  WriteToCaptureBuffer(3, capture_voice3);
+  IncrementCaptureBufferPosition();
+}
+
+void SPU::KeyOnOffVoices()
+{
+  if (s_key_off_register == 0 && s_key_on_register == 0)
+    return;
+
+  u32 key_off_register = s_key_off_register;
+  s_key_off_register = 0;
+
+  u32 key_on_register = s_key_on_register;
+  s_key_on_register = 0;
+
+  for (u32 voice = 0; voice < NUM_VOICES; voice++)
+  {
+    if (key_off_register & 1u)
+      s_voices[voice].KeyOff();
+    key_off_register >>= 1;
+
+    if (key_on_register & 1u)
+    {
+      s_endx_register &= ~(1u << voice);
+      s_voices[voice].KeyOn();
+    }
+    key_on_register >>= 1;
   }
 }
 
@@ -2430,6 +2867,105 @@ void SPU::UpdateEventInterval()
   s_tick_event->Schedule(downcount);
 }
 
+bool SPU::SaveReverbState(const char* path, Error* error)
+{
+  ReverbStateHeader header = {};
+  header.magic = ReverbStateHeader::MAGIC;
+  header.base_address = s_reverb_base_address;
+  header.current_address = s_reverb_current_address;
+  header.resample_buffer_position = s_reverb_resample_buffer_position;
+  header.reverb_master_enable = BoolToUInt32(s_SPUCNT.reverb_master_enable);
+  header.registers = s_reverb_registers;
+  header.downsample_buffer = s_reverb_downsample_buffer;
+  header.upsample_buffer = s_reverb_upsample_buffer;
+
+  auto fp = FileSystem::OpenManagedCFile(path, "wb", error);
+  if (!fp)
+    return false;
+
+  if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 || std::fwrite(s_ram.data(), RAM_SIZE, 1, fp.get()) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    return false;
+  }
+
+  Log_InfoFmt("Saved reverb state to '{}'.", path);
+  return true;
+}
+
+bool SPU::RunReverbBenchmark(const char* path, u32 frames, Error* error)
+{
+  if (s_tick_event)
+  {
+    Error::SetStringView(error, "Reverb benchmark cannot run while the system is running.");
+    return false;
+  }
+
+  auto fp = FileSystem::OpenManagedCFile(path, "rb", error);
+  if (!fp)
+    return false;
+
+  ReverbStateHeader header;
+  std::unique_ptr<std::array<u8, RAM_SIZE>> ram = std::make_unique<std::array<u8, RAM_SIZE>>();
+  if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.magic != ReverbStateHeader::MAGIC ||
+      std::fread(ram->data(), RAM_SIZE, 1, fp.get()) != 1)
+  {
+    Error::SetStringView(error, "Reverb state is invalid or truncated.");
+    return false;
+  }
+
+  fp.reset();
+  frames = std::max<u32>(frames, 1);
+
+  // Full-scale noise, so the saturation paths get exercised too.
+  std::vector<s16> input(frames * NUM_CHANNELS);
+  u32 seed = 0x12345678u;
+  for (s16& sample : input)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    sample = static_cast<s16>(seed >> 16);
+  }
+
+  std::vector<s32> output(frames * NUM_CHANNELS);
+  const auto run = [&header, &ram, &input, &output, frames](const char* name, auto process) {
+    s_reverb_base_address = header.base_address;
+    s_reverb_current_address = header.current_address;
+    s_reverb_resample_buffer_position = header.resample_buffer_position;
+    s_SPUCNT.reverb_master_enable = (header.reverb_master_enable != 0);
+    s_reverb_registers = header.registers;
+    s_reverb_downsample_buffer = header.downsample_buffer;
+    s_reverb_upsample_buffer = header.upsample_buffer;
+    s_ram = *ram;
+    UpdateReverbMaxOffset();
+
+    Common::Timer timer;
+    for (u32 i = 0; i < frames; i++)
+      process(input[i * 2], input[i * 2 + 1], &output[i * 2], &output[i * 2 + 1]);
+
+    const double time = timer.GetTimeSeconds();
+    XXH64_hash_t hash = XXH64(output.data(), output.size() * sizeof(s32), 0);
+    hash = XXH64(s_ram.data(), s_ram.size(), hash);
+    Log_InfoFmt("{}: {} frames in {:.2f} ms, {:.0f} frames/sec, hash {:016X}", name, frames, time * 1000.0,
+                (time > 0.0) ? (static_cast<double>(frames) / time) : 0.0, hash);
+    return hash;
+  };
+
+  Log_InfoFmt("Running reverb from '{}' for {} frames.", path, frames);
+  const XXH64_hash_t reference_hash = run("Reference", &ProcessReverb<false>);
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  const XXH64_hash_t vector_hash = run("Vector", &ProcessReverb<true>);
+  if (vector_hash != reference_hash)
+  {
+    Error::SetStringFmt(error, "Vector output does not match reference ({:016X} vs {:016X}).", vector_hash,
+                        reference_hash);
+    return false;
+  }
+#endif
+
+  return true;
+}
+
 void SPU::DrawDebugStateWindow()
 {
   static const ImVec4 active_color{1.0f, 1.0f, 1.0f, 1.0f};
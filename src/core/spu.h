@@ -5,6 +5,7 @@
 #include "types.h"
 #include <array>
 
+class Error;
 class StateWrapper;
 
 class AudioStream;
@@ -45,6 +46,12 @@ bool StartDumpingAudio(const char* filename);
 /// Stops dumping audio to file, if started.
 bool StopDumpingAudio();
 
+/// Starts or stops hashing the mixed output, for regression testing.
+void SetOutputHashingEnabled(bool enabled);
+
+/// Returns the hash of the output mixed since the last call, and starts a new one.
+u64 GetAndResetOutputHash();
+
 /// Access to SPU RAM.
 const std::array<u8, RAM_SIZE>& GetRAM();
 std::array<u8, RAM_SIZE>& GetWritableRAM();
@@ -57,4 +64,11 @@ void SetAudioOutputMuted(bool muted);
 AudioStream* GetOutputStream();
 void RecreateOutputStream();
 
+/// Saves the reverb registers, resampling buffers and RAM to a file, for use with RunReverbBenchmark().
+bool SaveReverbState(const char* path, Error* error);
+
+/// Runs the reverb from a saved state with both the reference and vector resampling filters, and reports the rate of
+/// each. Uses the reverb state directly, so must not be called while a system is running.
+bool RunReverbBenchmark(const char* path, u32 frames, Error* error);
+
 }; // namespace SPU
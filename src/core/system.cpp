@@ -23,6 +23,7 @@
 #include "imgui_overlays.h"
 #include "interrupt_controller.h"
 #include "mdec.h"
+#include "media_capture.h"
 #include "memory_card.h"
 #include "multitap.h"
 #include "pad.h"
@@ -52,6 +53,7 @@
 #include "common/path.h"
 #include "common/string_util.h"
 #include "common/threading.h"
+#include "common/xor_delta.h"
 
 #include "fmt/chrono.h"
 #include "fmt/format.h"
@@ -61,10 +63,12 @@
 #include <cctype>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <thread>
 
 Log_SetChannel(System);
@@ -78,8 +82,6 @@ Log_SetChannel(System);
 #include "discord_rpc.h"
 #endif
 
-// #define PROFILE_MEMORY_SAVE_STATES 1
-
 SystemBootParameters::SystemBootParameters() = default;
 
 SystemBootParameters::SystemBootParameters(const SystemBootParameters&) = default;
@@ -93,6 +95,28 @@ SystemBootParameters::SystemBootParameters(std::string filename_) : filename(std
 SystemBootParameters::~SystemBootParameters() = default;
 
 namespace System {
+/// Delta rewind history entry. Only the newest rewind state is kept in full, every older one is stored as a diff
+/// against its successor, so stepping back through history applies a single diff per state. Only the state stream is
+/// diffed, each entry still holds a full host VRAM texture when using the hardware renderers.
+struct RewindDeltaState
+{
+  /// Guarded by the rewind worker mutex.
+  struct Data
+  {
+    std::vector<u8> data;
+
+    // Non-zero once the worker thread has replaced data with its zstd-compressed form.
+    u32 uncompressed_size = 0;
+
+    // Full state waiting to be diffed against its successor by the worker thread, null once data is valid.
+    std::unique_ptr<GrowableMemoryByteStream> pending_state;
+    const GrowableMemoryByteStream* base = nullptr;
+  };
+
+  std::unique_ptr<GPUTexture> vram_texture;
+  std::shared_ptr<Data> delta;
+};
+
 static std::optional<ExtendedSaveStateInfo> InternalGetExtendedSaveStateInfo(ByteStream* stream);
 
 static bool LoadEXE(const char* filename);
@@ -120,8 +144,17 @@ static void UpdatePreFrameSleepTime();
 
 static void SetRewinding(bool enabled);
 static bool SaveRewindState();
+static bool SaveDeltaRewindState();
+static void PopRewindState();
+static bool PopDeltaRewindState();
 static void DoRewind();
 
+static void StartRewindWorkerThread(bool compress);
+static void StopRewindWorkerThread();
+static void RewindWorkerThreadEntryPoint();
+static void EncodeRewindDelta(RewindDeltaState::Data* data, bool notify);
+static void CompressRewindDelta(RewindDeltaState::Data* data);
+
 static void SaveRunaheadState();
 static bool DoRunahead();
 
@@ -235,6 +268,28 @@ static s32 s_rewind_save_frequency = -1;
 static s32 s_rewind_save_counter = -1;
 static bool s_rewinding_first_save = false;
 
+static std::deque<System::RewindDeltaState> s_rewind_delta_states;
+
+// Delta encoding and compression of rewind states happens on the worker, so the CPU thread only pays for DoState().
+static constexpr u32 MAX_REWIND_FREE_STREAMS = 2;
+static Threading::Thread s_rewind_worker_thread;
+static std::mutex s_rewind_worker_mutex;
+static std::condition_variable s_rewind_worker_cv;
+static std::condition_variable s_rewind_worker_done_cv;
+static std::deque<std::shared_ptr<System::RewindDeltaState::Data>> s_rewind_worker_queue;
+static std::vector<std::unique_ptr<GrowableMemoryByteStream>> s_rewind_free_streams;
+static bool s_rewind_worker_compress = false;
+static bool s_rewind_worker_busy = false;
+static bool s_rewind_worker_shutdown = false;
+
+static float s_memory_save_state_save_time_accumulator = 0.0f;
+static float s_memory_save_state_max_save_time_accumulator = 0.0f;
+static float s_memory_save_state_load_time_accumulator = 0.0f;
+static float s_memory_save_state_wait_time_accumulator = 0.0f;
+static u32 s_memory_save_state_saves_since_last_update = 0;
+static u32 s_memory_save_state_loads_since_last_update = 0;
+static System::MemorySaveStateTimings s_memory_save_state_timings = {};
+
 static std::deque<System::MemorySaveState> s_runahead_states;
 static bool s_runahead_replay_pending = false;
 static u32 s_runahead_frames = 0;
@@ -514,6 +569,10 @@ float System::GetGPUAverageTime()
 {
   return s_average_gpu_time;
 }
+const System::MemorySaveStateTimings& System::GetMemorySaveStateTimings()
+{
+  return s_memory_save_state_timings;
+}
 const System::FrameTimeHistory& System::GetFrameTimeHistory()
 {
   return s_frame_time_history;
@@ -1583,6 +1642,12 @@ bool System::Initialize(bool force_software_renderer)
   s_average_frame_time_accumulator = 0.0f;
   s_minimum_frame_time_accumulator = 0.0f;
   s_maximum_frame_time_accumulator = 0.0f;
+  s_memory_save_state_save_time_accumulator = 0.0f;
+  s_memory_save_state_max_save_time_accumulator = 0.0f;
+  s_memory_save_state_load_time_accumulator = 0.0f;
+  s_memory_save_state_wait_time_accumulator = 0.0f;
+  s_memory_save_state_saves_since_last_update = 0;
+  s_memory_save_state_loads_since_last_update = 0;
 
   s_vps = 0.0f;
   s_fps = 0.0f;
@@ -1686,8 +1751,11 @@ void System::DestroySystem()
   SetTimerResolutionIncreased(false);
 
   s_cpu_thread_usage = {};
+  s_memory_save_state_timings = {};
 
   ClearMemorySaveStates();
+  StopRewindWorkerThread();
+  MediaCapture::Stop();
 
   g_texture_replacements.Shutdown();
 
@@ -1872,6 +1940,13 @@ void System::FrameDone()
     SaveRunaheadState();
   }
 
+  if (MediaCapture::IsCapturing())
+  {
+    MediaCapture::CaptureFrame();
+    if (MediaCapture::HasError())
+      StopCapture();
+  }
+
   Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
 
   // pre-frame sleep accounting (input lag reduction)
@@ -2659,6 +2734,25 @@ void System::UpdatePerformanceCounters()
   if (g_settings.display_show_gpu_stats)
     g_gpu->UpdateStatistics(frames_run);
 
+  const u32 mss_saves = std::exchange(s_memory_save_state_saves_since_last_update, 0u);
+  const u32 mss_loads = std::exchange(s_memory_save_state_loads_since_last_update, 0u);
+  s_memory_save_state_timings.saves = mss_saves;
+  s_memory_save_state_timings.loads = mss_loads;
+  s_memory_save_state_timings.average_save_time =
+    std::exchange(s_memory_save_state_save_time_accumulator, 0.0f) / static_cast<float>(std::max(mss_saves, 1u));
+  s_memory_save_state_timings.maximum_save_time = std::exchange(s_memory_save_state_max_save_time_accumulator, 0.0f);
+  s_memory_save_state_timings.average_load_time =
+    std::exchange(s_memory_save_state_load_time_accumulator, 0.0f) / static_cast<float>(std::max(mss_loads, 1u));
+  s_memory_save_state_timings.average_wait_time =
+    std::exchange(s_memory_save_state_wait_time_accumulator, 0.0f) / static_cast<float>(std::max(mss_loads, 1u));
+  if (mss_saves > 0 || mss_loads > 0)
+  {
+    Log_VerbosePrintf("Memory save states: %u saves, avg %.3fms max %.3fms, %u loads, avg %.3fms wait %.3fms",
+                      mss_saves, s_memory_save_state_timings.average_save_time,
+                      s_memory_save_state_timings.maximum_save_time, mss_loads,
+                      s_memory_save_state_timings.average_load_time, s_memory_save_state_timings.average_wait_time);
+  }
+
   if (s_pre_frame_sleep)
     UpdatePreFrameSleepTime();
 
@@ -3779,6 +3873,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.gpu_multisamples != old_settings.gpu_multisamples ||
         g_settings.gpu_per_sample_shading != old_settings.gpu_per_sample_shading ||
         g_settings.gpu_use_thread != old_settings.gpu_use_thread ||
+        g_settings.gpu_sw_threads != old_settings.gpu_sw_threads ||
+        g_settings.gpu_thread_wake_threshold != old_settings.gpu_thread_wake_threshold ||
         g_settings.gpu_use_software_renderer_for_readbacks != old_settings.gpu_use_software_renderer_for_readbacks ||
         g_settings.gpu_fifo_size != old_settings.gpu_fifo_size ||
         g_settings.gpu_max_run_ahead != old_settings.gpu_max_run_ahead ||
@@ -3822,6 +3918,13 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
           g_settings.display_aspect_ratio_custom_denominator != old_settings.display_aspect_ratio_custom_denominator)))
     {
       GTE::UpdateAspectRatio();
+
+      // The recompiler only emits RTPS/RTPT inline without the widescreen hack.
+      if (g_settings.gpu_widescreen_hack != old_settings.gpu_widescreen_hack &&
+          CPU::CodeCache::IsUsingAnyRecompiler())
+      {
+        CPU::CodeCache::Reset();
+      }
     }
 
     if (g_settings.gpu_pgxp_enable != old_settings.gpu_pgxp_enable ||
@@ -3844,6 +3947,9 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.cdrom_readahead_sectors != old_settings.cdrom_readahead_sectors)
       CDROM::SetReadaheadSectors(g_settings.cdrom_readahead_sectors);
 
+    if (g_settings.cdrom_chd_prefetch_hunks != old_settings.cdrom_chd_prefetch_hunks)
+      CDROM::SetDecompressionPrefetch(g_settings.cdrom_chd_prefetch_hunks);
+
     if (g_settings.memory_card_types != old_settings.memory_card_types ||
         g_settings.memory_card_paths != old_settings.memory_card_paths ||
         (g_settings.memory_card_use_playlist_title != old_settings.memory_card_use_playlist_title))
@@ -3854,6 +3960,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_delta_states != old_settings.rewind_delta_states ||
+        g_settings.rewind_compress_states != old_settings.rewind_compress_states ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       UpdateMemorySaveStateSettings();
@@ -4034,7 +4142,16 @@ void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64
 
 void System::ClearMemorySaveStates()
 {
+  // the worker could be reading one of the states we're about to throw away
+  {
+    std::unique_lock lock(s_rewind_worker_mutex);
+    s_rewind_worker_queue.clear();
+    s_rewind_worker_done_cv.wait(lock, []() { return !s_rewind_worker_busy; });
+    s_rewind_free_streams.clear();
+  }
+
   s_rewind_states.clear();
+  s_rewind_delta_states.clear();
   s_runahead_states.clear();
 }
 
@@ -4054,6 +4171,12 @@ void System::UpdateMemorySaveStateSettings()
     Log_InfoPrintf(
       "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
       std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
+    if (g_settings.rewind_delta_states)
+    {
+      Log_InfoPrintf("Rewind states are delta encoded%s, RAM usage will be much lower than the estimate. VRAM usage "
+                     "is unchanged, every state still keeps its own copy of VRAM.",
+                     g_settings.rewind_compress_states ? " and compressed" : "");
+    }
   }
   else
   {
@@ -4061,6 +4184,10 @@ void System::UpdateMemorySaveStateSettings()
     s_rewind_save_counter = -1;
   }
 
+  StopRewindWorkerThread();
+  if (g_settings.rewind_enable && g_settings.rewind_delta_states)
+    StartRewindWorkerThread(g_settings.rewind_compress_states);
+
   s_rewind_load_frequency = -1;
   s_rewind_load_counter = -1;
 
@@ -4072,6 +4199,7 @@ void System::UpdateMemorySaveStateSettings()
 
 bool System::LoadMemoryState(const MemorySaveState& mss)
 {
+  Common::Timer load_timer;
   mss.state_stream->SeekAbsolute(0);
 
   StateWrapper sw(mss.state_stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
@@ -4083,11 +4211,14 @@ bool System::LoadMemoryState(const MemorySaveState& mss)
     return false;
   }
 
+  s_memory_save_state_load_time_accumulator += static_cast<float>(load_timer.GetTimeMilliseconds());
+  s_memory_save_state_loads_since_last_update++;
   return true;
 }
 
 bool System::SaveMemoryState(MemorySaveState* mss)
 {
+  Common::Timer save_timer;
   if (!mss->state_stream)
     mss->state_stream = std::make_unique<GrowableMemoryByteStream>(nullptr, MAX_SAVE_STATE_SIZE);
   else
@@ -4103,17 +4234,22 @@ bool System::SaveMemoryState(MemorySaveState* mss)
   }
 
   mss->vram_texture.reset(host_texture);
+
+  const float save_time = static_cast<float>(save_timer.GetTimeMilliseconds());
+  s_memory_save_state_save_time_accumulator += save_time;
+  s_memory_save_state_max_save_time_accumulator = std::max(s_memory_save_state_max_save_time_accumulator, save_time);
+  s_memory_save_state_saves_since_last_update++;
   return true;
 }
 
 bool System::SaveRewindState()
 {
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Common::Timer save_timer;
-#endif
+  // a single slot has nothing to diff against
+  const u32 save_slots = g_settings.rewind_save_slots;
+  if (g_settings.rewind_delta_states && save_slots > 1)
+    return SaveDeltaRewindState();
 
   // try to reuse the frontmost slot
-  const u32 save_slots = g_settings.rewind_save_slots;
   MemorySaveState mss;
   while (s_rewind_states.size() >= save_slots)
   {
@@ -4125,40 +4261,267 @@ bool System::SaveRewindState()
     return false;
 
   s_rewind_states.push_back(std::move(mss));
+  return true;
+}
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("Saved rewind state (%" PRIu64 " bytes, took %.4f ms)", s_rewind_states.back().state_stream->GetSize(),
-                save_timer.GetTimeMilliseconds());
-#endif
+bool System::SaveDeltaRewindState()
+{
+  // drop the oldest states, keeping a VRAM texture around to reuse
+  MemorySaveState mss;
+  while ((s_rewind_delta_states.size() + s_rewind_states.size()) >= g_settings.rewind_save_slots &&
+         !s_rewind_delta_states.empty())
+  {
+    mss.vram_texture = std::move(s_rewind_delta_states.front().vram_texture);
+    s_rewind_delta_states.pop_front();
+  }
+
+  {
+    std::unique_lock lock(s_rewind_worker_mutex);
+    if (!s_rewind_free_streams.empty())
+    {
+      mss.state_stream = std::move(s_rewind_free_streams.back());
+      s_rewind_free_streams.pop_back();
+    }
+  }
+
+  if (!SaveMemoryState(&mss))
+    return false;
+
+  // the stream is reused, so trim it to this state for diffing
+  GrowableMemoryByteStream* new_stream = mss.state_stream.get();
+  new_stream->Resize(static_cast<u32>(new_stream->GetPosition()));
+
+  // The previous newest state becomes a diff against the one we just created. Encoding happens on the worker thread,
+  // the full state is kept around until then.
+  if (!s_rewind_states.empty())
+  {
+    MemorySaveState& prev = s_rewind_states.back();
+
+    RewindDeltaState rds;
+    rds.vram_texture = std::move(prev.vram_texture);
+    rds.delta = std::make_shared<RewindDeltaState::Data>();
+    rds.delta->pending_state = std::move(prev.state_stream);
+    rds.delta->base = new_stream;
+    s_rewind_states.pop_back();
 
+    if (s_rewind_worker_thread.Joinable())
+    {
+      std::unique_lock lock(s_rewind_worker_mutex);
+      s_rewind_worker_queue.push_back(rds.delta);
+      s_rewind_worker_cv.notify_one();
+    }
+    else
+    {
+      EncodeRewindDelta(rds.delta.get(), false);
+    }
+
+    s_rewind_delta_states.push_back(std::move(rds));
+  }
+
+  s_rewind_states.push_back(std::move(mss));
   return true;
 }
 
+void System::PopRewindState()
+{
+  if (g_settings.rewind_delta_states)
+  {
+    PopDeltaRewindState();
+    return;
+  }
+
+  g_gpu_device->RecycleTexture(std::move(s_rewind_states.back().vram_texture));
+  s_rewind_states.pop_back();
+}
+
+bool System::PopDeltaRewindState()
+{
+  MemorySaveState& head = s_rewind_states.back();
+  if (s_rewind_delta_states.empty())
+  {
+    g_gpu_device->RecycleTexture(std::move(head.vram_texture));
+    std::unique_lock lock(s_rewind_worker_mutex);
+    s_rewind_free_streams.push_back(std::move(head.state_stream));
+    s_rewind_states.pop_back();
+    return true;
+  }
+
+  // turn the newest state back into its predecessor by applying the predecessor's diff
+  RewindDeltaState& rds = s_rewind_delta_states.back();
+  bool result = false;
+  {
+    // Wait until the worker has released the delta, it may still be compressing after the pending state is cleared.
+    // Nothing else touches it after that, so the lock isn't needed while decoding.
+    {
+      std::unique_lock lock(s_rewind_worker_mutex);
+      const auto worker_done = [&rds]() { return !rds.delta->pending_state && rds.delta.use_count() == 1; };
+      if (!worker_done())
+      {
+        Common::Timer wait_timer;
+        s_rewind_worker_done_cv.wait(lock, worker_done);
+        s_memory_save_state_wait_time_accumulator += static_cast<float>(wait_timer.GetTimeMilliseconds());
+      }
+    }
+
+    std::vector<u8> decompressed;
+    std::span<const u8> delta = rds.delta->data;
+    if (rds.delta->uncompressed_size > 0)
+    {
+      std::unique_ptr<ReadOnlyMemoryByteStream> src_stream =
+        ByteStream::CreateReadOnlyMemoryStream(delta.data(), static_cast<u32>(delta.size()));
+      std::unique_ptr<ByteStream> dstream =
+        ByteStream::CreateZstdDecompressStream(src_stream.get(), static_cast<u32>(delta.size()));
+      decompressed.resize(rds.delta->uncompressed_size);
+      delta = dstream->Read2(decompressed.data(), rds.delta->uncompressed_size) ? std::span<const u8>(decompressed) :
+                                                                                    std::span<const u8>();
+    }
+
+    const std::optional<size_t> state_size = XORDelta::GetDecodedSize(delta);
+    if (state_size.has_value())
+    {
+      GrowableMemoryByteStream* stream = head.state_stream.get();
+      const size_t base_size = static_cast<size_t>(stream->GetSize());
+      stream->Resize(static_cast<u32>(state_size.value()));
+      result = XORDelta::Apply(std::span<u8>(stream->GetMemoryPointer(), state_size.value()), base_size, delta);
+    }
+  }
+
+  g_gpu_device->RecycleTexture(std::move(head.vram_texture));
+  head.vram_texture = std::move(rds.vram_texture);
+  s_rewind_delta_states.pop_back();
+
+  if (!result)
+  {
+    Log_ErrorPrint("Failed to decode rewind state, discarding rewind history.");
+    ClearMemorySaveStates();
+    return false;
+  }
+
+  return true;
+}
+
+void System::StartRewindWorkerThread(bool compress)
+{
+  if (s_rewind_worker_thread.Joinable())
+    return;
+
+  s_rewind_worker_compress = compress;
+  s_rewind_worker_shutdown = false;
+  s_rewind_worker_thread.Start(&System::RewindWorkerThreadEntryPoint);
+}
+
+void System::StopRewindWorkerThread()
+{
+  if (!s_rewind_worker_thread.Joinable())
+    return;
+
+  {
+    std::unique_lock lock(s_rewind_worker_mutex);
+    s_rewind_worker_shutdown = true;
+    s_rewind_worker_cv.notify_one();
+  }
+
+  s_rewind_worker_thread.Join();
+}
+
+void System::RewindWorkerThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Rewind Worker");
+
+  std::unique_lock lock(s_rewind_worker_mutex);
+  for (;;)
+  {
+    s_rewind_worker_cv.wait(lock, []() { return s_rewind_worker_shutdown || !s_rewind_worker_queue.empty(); });
+    if (s_rewind_worker_shutdown)
+      break;
+
+    std::shared_ptr<RewindDeltaState::Data> data = std::move(s_rewind_worker_queue.front());
+    s_rewind_worker_queue.pop_front();
+
+    // states which were evicted while waiting don't need to be encoded
+    if (data.use_count() == 1)
+    {
+      data->base = nullptr;
+      data->pending_state.reset();
+      continue;
+    }
+
+    s_rewind_worker_busy = true;
+    lock.unlock();
+    EncodeRewindDelta(data.get(), true);
+    if (s_rewind_worker_compress)
+      CompressRewindDelta(data.get());
+    data.reset();
+    lock.lock();
+
+    s_rewind_worker_busy = false;
+    s_rewind_worker_done_cv.notify_all();
+  }
+}
+
+void System::EncodeRewindDelta(RewindDeltaState::Data* data, bool notify)
+{
+  // Only the worker reads the pending state and base until the pending state is cleared below.
+  const GrowableMemoryByteStream* state = data->pending_state.get();
+  const GrowableMemoryByteStream* base = data->base;
+
+  std::vector<u8> delta;
+  XORDelta::Encode(&delta, std::span<const u8>(state->GetMemoryPointer(), static_cast<size_t>(state->GetSize())),
+                   std::span<const u8>(base->GetMemoryPointer(), static_cast<size_t>(base->GetSize())));
+  delta.shrink_to_fit();
+
+  std::unique_lock lock(s_rewind_worker_mutex);
+  data->data = std::move(delta);
+  data->base = nullptr;
+  if (s_rewind_free_streams.size() < MAX_REWIND_FREE_STREAMS)
+    s_rewind_free_streams.push_back(std::move(data->pending_state));
+  else
+    data->pending_state.reset();
+
+  if (notify)
+    s_rewind_worker_done_cv.notify_all();
+}
+
+void System::CompressRewindDelta(RewindDeltaState::Data* data)
+{
+  // Nothing else modifies the data until it's swapped below, so it's safe to read without holding the lock.
+  if (data->uncompressed_size > 0 || data->data.empty())
+    return;
+
+  std::unique_ptr<GrowableMemoryByteStream> out_stream = ByteStream::CreateGrowableMemoryStream();
+  std::unique_ptr<ByteStream> cstream = ByteStream::CreateZstdCompressStream(out_stream.get(), 0);
+  if (!cstream->Write2(data->data.data(), static_cast<u32>(data->data.size())) || !cstream->Commit())
+    return;
+
+  cstream.reset();
+
+  const u32 compressed_size = static_cast<u32>(out_stream->GetPosition());
+  if (compressed_size >= data->data.size())
+    return;
+
+  std::vector<u8> compressed(out_stream->GetMemoryPointer(), out_stream->GetMemoryPointer() + compressed_size);
+
+  std::unique_lock lock(s_rewind_worker_mutex);
+  data->uncompressed_size = static_cast<u32>(data->data.size());
+  data->data = std::move(compressed);
+}
+
 bool System::LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true */)
 {
   while (skip_saves > 0 && !s_rewind_states.empty())
   {
-    g_gpu_device->RecycleTexture(std::move(s_rewind_states.back().vram_texture));
-    s_rewind_states.pop_back();
+    PopRewindState();
     skip_saves--;
   }
 
   if (s_rewind_states.empty())
     return false;
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Common::Timer load_timer;
-#endif
-
   if (!LoadMemoryState(s_rewind_states.back()))
     return false;
 
   if (consume_state)
-    s_rewind_states.pop_back();
-
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("Rewind load took %.4f ms", load_timer.GetTimeMilliseconds());
-#endif
+    PopRewindState();
 
   return true;
 }
@@ -4233,16 +4596,12 @@ void System::SaveRunaheadState()
 
 bool System::DoRunahead()
 {
-#ifdef PROFILE_MEMORY_SAVE_STATES
   static Common::Timer replay_timer;
-#endif
 
   if (s_runahead_replay_pending)
   {
-#ifdef PROFILE_MEMORY_SAVE_STATES
-    Log_DevPrintf("runahead starting at frame %u", s_frame_number);
+    Log_DebugPrintf("runahead starting at frame %u", s_frame_number);
     replay_timer.Reset();
-#endif
 
     // we need to replay and catch up - load the state,
     s_runahead_replay_pending = false;
@@ -4261,9 +4620,7 @@ bool System::DoRunahead()
     // run the frames with no audio
     SPU::SetAudioOutputMuted(true);
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-    Log_VerbosePrintf("Rewound to frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
-#endif
+    Log_DebugPrintf("Rewound to frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
 
     // we don't want to save the frame we just loaded. but we are "one frame ahead", because the frame we just tossed
     // was never saved, so return but don't decrement the counter
@@ -4282,17 +4639,12 @@ bool System::DoRunahead()
     return true;
   }
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_VerbosePrintf("Running %d frames to catch up took %.2f ms", s_runahead_frames,
-                    replay_timer.GetTimeMilliseconds());
-#endif
+  Log_DebugPrintf("Running %d frames to catch up took %.2f ms", s_runahead_frames, replay_timer.GetTimeMilliseconds());
 
   // we're all caught up. this frame gets saved in DoMemoryStates().
   SPU::SetAudioOutputMuted(false);
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("runahead ending at frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
-#endif
+  Log_DebugPrintf("runahead ending at frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
 
   return false;
 }
@@ -4302,9 +4654,7 @@ void System::SetRunaheadReplayFlag()
   if (s_runahead_frames == 0 || s_runahead_states.empty())
     return;
 
-#ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("Runahead rewind pending...");
-#endif
+  Log_DebugPrint("Runahead rewind pending...");
 
   s_runahead_replay_pending = true;
 }
@@ -4464,6 +4814,73 @@ void System::StopDumpingAudio()
   Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Stopped dumping audio."), 5.0f);
 }
 
+bool System::IsCapturing()
+{
+  return MediaCapture::IsCapturing();
+}
+
+bool System::StartCapture(const char* filename)
+{
+  if (System::IsShutdown())
+    return false;
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& serial = System::GetGameSerial();
+    if (serial.empty())
+    {
+      auto_filename = Path::Combine(EmuFolders::Dumps, fmt::format("capture" FS_OSPATH_SEPARATOR_STR "{}.dscap",
+                                                                   GetTimestampStringForFileName()));
+    }
+    else
+    {
+      auto_filename = Path::Combine(EmuFolders::Dumps, fmt::format("capture" FS_OSPATH_SEPARATOR_STR "{}_{}.dscap",
+                                                                   serial, GetTimestampStringForFileName()));
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  Error error;
+  if (MediaCapture::Start(filename, g_settings.capture_queue_frames, g_settings.capture_drop_frames_when_full,
+                          g_settings.capture_keyframe_interval, &error))
+  {
+    Host::AddFormattedOSDMessage(5.0f, TRANSLATE("OSDMessage", "Started capturing to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    Log_ErrorFmt("Failed to start capture: {}", error.GetDescription());
+    Host::AddFormattedOSDMessage(10.0f, TRANSLATE("OSDMessage", "Failed to start capturing to '%s'."), filename);
+    return false;
+  }
+}
+
+void System::StopCapture()
+{
+  if (!MediaCapture::IsCapturing())
+    return;
+
+  const bool had_error = MediaCapture::HasError();
+  const MediaCapture::Stats stats = MediaCapture::GetStats();
+  MediaCapture::Stop();
+
+  if (had_error)
+  {
+    Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Capture stopped due to a write error, check the log."), 10.0f);
+  }
+  else if (stats.frames_dropped > 0)
+  {
+    Host::AddFormattedOSDMessage(5.0f, TRANSLATE("OSDMessage", "Stopped capturing, %u frames were dropped."),
+                                 stats.frames_dropped);
+  }
+  else
+  {
+    Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Stopped capturing."), 5.0f);
+  }
+}
+
 bool System::SaveScreenshot(const char* filename, DisplayScreenshotMode mode, DisplayScreenshotFormat format,
                             u8 quality, bool compress_on_thread)
 {
@@ -4780,13 +5197,11 @@ void System::SetCheatCodeState(u32 index, bool enabled)
   if (index >= cl->GetCodeCount())
     return;
 
-  CheatCode& cc = cl->GetCode(index);
+  const CheatCode& cc = cl->GetCode(index);
   if (cc.enabled == enabled)
     return;
 
-  cc.enabled = enabled;
-  if (!enabled)
-    cc.ApplyOnDisable();
+  cl->SetCodeEnabled(index, enabled);
 
   if (enabled)
   {
@@ -219,6 +219,17 @@ const BIOS::Hash& GetBIOSHash();
 static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
+/// Rewind/runahead state timings over the last performance counter interval, in milliseconds.
+struct MemorySaveStateTimings
+{
+  float average_save_time;
+  float maximum_save_time;
+  float average_load_time;
+  float average_wait_time; ///< Time spent waiting for the worker to encode the state being rewound to.
+  u32 saves;
+  u32 loads;
+};
+
 float GetFPS();
 float GetVPS();
 float GetEmulationSpeed();
@@ -232,6 +243,7 @@ float GetSWThreadUsage();
 float GetSWThreadAverageTime();
 float GetGPUUsage();
 float GetGPUAverageTime();
+const MemorySaveStateTimings& GetMemorySaveStateTimings();
 const FrameTimeHistory& GetFrameTimeHistory();
 u32 GetFrameTimeHistoryPos();
 void FormatLatencyStats(SmallStringBase& str);
@@ -420,6 +432,16 @@ bool StartDumpingAudio(const char* filename = nullptr);
 /// Stops dumping audio to file if it has been started.
 void StopDumpingAudio();
 
+/// Returns true if currently capturing video and audio.
+bool IsCapturing();
+
+/// Starts a lossless capture of the display and audio. If no file name is provided, one will be generated
+/// automatically.
+bool StartCapture(const char* filename = nullptr);
+
+/// Stops capturing if it has been started.
+void StopCapture();
+
 /// Saves a screenshot to the specified file. If no file name is provided, one will be generated automatically.
 bool SaveScreenshot(const char* filename = nullptr, DisplayScreenshotMode mode = g_settings.display_screenshot_mode,
                     DisplayScreenshotFormat format = g_settings.display_screenshot_format,
@@ -7,15 +7,26 @@
 #include "cpu_core.h"
 #include "cpu_core_private.h"
 #include "system.h"
+#include "util/imgui_manager.h"
 #include "util/state_wrapper.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
 Log_SetChannel(TimingEvents);
 
 namespace TimingEvents {
 
-static TimingEvent* s_active_events_head;
-static TimingEvent* s_active_events_tail;
+// Active events are kept in a binary min-heap, ordered by downcount, then by m_order for events due at the same time.
+// The head is also cached separately, since the recompiler reads its downcount directly.
+static std::vector<TimingEvent*> s_active_events;
+static TimingEvent* s_active_events_head = nullptr;
 static TimingEvent* s_current_event = nullptr;
-static u32 s_active_event_count = 0;
+static std::vector<TimingEvent*> s_all_events;
+static s64 s_first_event_order = 0;
+static s64 s_last_event_order = 0;
 static u32 s_global_tick_counter = 0;
 static u32 s_event_run_tick_counter = 0;
 static bool s_frame_done = false;
@@ -42,7 +53,7 @@ void Reset()
 
 void Shutdown()
 {
-  Assert(s_active_event_count == 0);
+  Assert(s_active_events.empty());
 }
 
 std::unique_ptr<TimingEvent> CreateTimingEvent(std::string name, TickCount period, TickCount interval,
@@ -58,7 +69,9 @@ std::unique_ptr<TimingEvent> CreateTimingEvent(std::string name, TickCount perio
 
 void UpdateCPUDowncount()
 {
-  const u32 event_downcount = s_active_events_head->GetDowncount();
+  // The heap can be empty while the only active event's callback runs.
+  const TickCount event_downcount =
+    s_active_events_head ? s_active_events_head->GetDowncount() : std::numeric_limits<TickCount>::max();
   CPU::g_state.downcount = CPU::HasPendingInterrupt() ? 0 : event_downcount;
 }
 
@@ -67,198 +80,145 @@ TimingEvent** GetHeadEventPtr()
   return &s_active_events_head;
 }
 
-static void SortEvent(TimingEvent* event)
+static bool EventLess(const TimingEvent* lhs, const TimingEvent* rhs)
 {
-  const TickCount event_downcount = event->m_downcount;
+  return (lhs->m_downcount < rhs->m_downcount ||
+          (lhs->m_downcount == rhs->m_downcount && lhs->m_order < rhs->m_order));
+}
 
-  if (event->prev && event->prev->m_downcount > event_downcount)
+static void HeapSiftUp(u32 index)
+{
+  TimingEvent* event = s_active_events[index];
+  while (index > 0)
   {
-    // move backwards
-    TimingEvent* current = event->prev;
-    while (current && current->m_downcount > event_downcount)
-      current = current->prev;
-
-    // unlink
-    if (event->prev)
-      event->prev->next = event->next;
-    else
-      s_active_events_head = event->next;
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
-
-    // insert after current
-    if (current)
-    {
-      event->next = current->next;
-      if (current->next)
-        current->next->prev = event;
-      else
-        s_active_events_tail = event;
-
-      event->prev = current;
-      current->next = event;
-    }
-    else
-    {
-      // insert at front
-      DebugAssert(s_active_events_head);
-      s_active_events_head->prev = event;
-      event->prev = nullptr;
-      event->next = s_active_events_head;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
+    const u32 parent_index = (index - 1) / 2;
+    TimingEvent* parent = s_active_events[parent_index];
+    if (!EventLess(event, parent))
+      break;
+
+    s_active_events[index] = parent;
+    parent->m_heap_index = index;
+    index = parent_index;
   }
-  else if (event->next && event_downcount > event->next->m_downcount)
-  {
-    // move forwards
-    TimingEvent* current = event->next;
-    while (current && event_downcount > current->m_downcount)
-      current = current->next;
 
-    // unlink
-    if (event->prev)
-    {
-      event->prev->next = event->next;
-    }
-    else
-    {
-      s_active_events_head = event->next;
-      UpdateCPUDowncount();
-    }
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
+  s_active_events[index] = event;
+  event->m_heap_index = index;
+}
 
-    // insert before current
-    if (current)
-    {
-      event->next = current;
-      event->prev = current->prev;
+static void HeapSiftDown(u32 index)
+{
+  const u32 size = static_cast<u32>(s_active_events.size());
+  TimingEvent* event = s_active_events[index];
+  for (;;)
+  {
+    u32 child_index = index * 2 + 1;
+    if (child_index >= size)
+      break;
+    if ((child_index + 1) < size && EventLess(s_active_events[child_index + 1], s_active_events[child_index]))
+      child_index++;
+
+    TimingEvent* child = s_active_events[child_index];
+    if (!EventLess(child, event))
+      break;
+
+    s_active_events[index] = child;
+    child->m_heap_index = index;
+    index = child_index;
+  }
 
-      if (current->prev)
-      {
-        current->prev->next = event;
-      }
-      else
-      {
-        s_active_events_head = event;
-        UpdateCPUDowncount();
-      }
+  s_active_events[index] = event;
+  event->m_heap_index = index;
+}
 
-      current->prev = event;
-    }
-    else
-    {
-      // insert at back
-      DebugAssert(s_active_events_tail);
-      s_active_events_tail->next = event;
-      event->next = nullptr;
-      event->prev = s_active_events_tail;
-      s_active_events_tail = event;
-    }
-  }
+static void HeapInsert(TimingEvent* event)
+{
+  DebugAssert(event->m_heap_index == TimingEvent::INVALID_HEAP_INDEX);
+  s_active_events.push_back(event);
+  HeapSiftUp(static_cast<u32>(s_active_events.size() - 1));
 }
 
-static void AddActiveEvent(TimingEvent* event)
+static void HeapRemove(TimingEvent* event)
 {
-  DebugAssert(!event->prev && !event->next);
-  s_active_event_count++;
+  const u32 index = event->m_heap_index;
+  DebugAssert(index < s_active_events.size() && s_active_events[index] == event);
 
-  TimingEvent* current = nullptr;
-  TimingEvent* next = s_active_events_head;
-  while (next && event->m_downcount > next->m_downcount)
+  TimingEvent* last = s_active_events.back();
+  s_active_events.pop_back();
+  event->m_heap_index = TimingEvent::INVALID_HEAP_INDEX;
+  if (last != event)
   {
-    current = next;
-    next = next->next;
+    s_active_events[index] = last;
+    last->m_heap_index = index;
+    HeapSiftDown(index);
+    HeapSiftUp(last->m_heap_index);
   }
+}
 
-  if (!next)
-  {
-    // new tail
-    event->prev = s_active_events_tail;
-    if (s_active_events_tail)
-    {
-      s_active_events_tail->next = event;
-      s_active_events_tail = event;
-    }
-    else
-    {
-      // first event
-      s_active_events_tail = event;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
-  }
-  else if (!current)
-  {
-    // new head
-    event->next = s_active_events_head;
-    s_active_events_head->prev = event;
-    s_active_events_head = event;
+static void UpdateHeadEvent(const TimingEvent* modified_event)
+{
+  TimingEvent* head = s_active_events.empty() ? nullptr : s_active_events.front();
+  const bool head_changed = (head != s_active_events_head);
+  s_active_events_head = head;
+  if (head && (head_changed || head == modified_event))
     UpdateCPUDowncount();
-  }
-  else
-  {
-    // inbetween current < event > next
-    event->prev = current;
-    event->next = next;
-    current->next = event;
-    next->prev = event;
-  }
 }
 
-static void RemoveActiveEvent(TimingEvent* event)
+// Events which move later are placed before any others due at the same time, and events which move earlier are placed
+// after them. This is the same order the sorted event list used to produce, so ties still run in the same order.
+static void UpdateEventOrder(TimingEvent* event, TickCount old_downcount)
 {
-  DebugAssert(s_active_event_count > 0);
+  if (event->m_downcount > old_downcount)
+    event->m_order = --s_first_event_order;
+  else if (event->m_downcount < old_downcount)
+    event->m_order = ++s_last_event_order;
+}
 
-  if (event->next)
-  {
-    event->next->prev = event->prev;
-  }
-  else
-  {
-    s_active_events_tail = event->prev;
-  }
+static void SortEvent(TimingEvent* event, TickCount old_downcount)
+{
+  // Events are taken out of the heap while their callback runs, and sorted when they're put back.
+  if (event->m_heap_index == TimingEvent::INVALID_HEAP_INDEX)
+    return;
 
-  if (event->prev)
-  {
-    event->prev->next = event->next;
-  }
-  else
-  {
-    s_active_events_head = event->next;
-    if (s_active_events_head)
-      UpdateCPUDowncount();
-  }
+  UpdateEventOrder(event, old_downcount);
 
-  event->prev = nullptr;
-  event->next = nullptr;
+  if (event->m_downcount > old_downcount)
+    HeapSiftDown(event->m_heap_index);
+  else if (event->m_downcount < old_downcount)
+    HeapSiftUp(event->m_heap_index);
 
-  s_active_event_count--;
+  UpdateHeadEvent(event);
 }
 
-static void SortEvents()
+static void AddActiveEvent(TimingEvent* event)
 {
-  std::vector<TimingEvent*> events;
-  events.reserve(s_active_event_count);
+  event->m_order = --s_first_event_order;
+  HeapInsert(event);
+  UpdateHeadEvent(nullptr);
+}
 
-  TimingEvent* next = s_active_events_head;
-  while (next)
-  {
-    TimingEvent* current = next;
-    events.push_back(current);
-    next = current->next;
-    current->prev = nullptr;
-    current->next = nullptr;
-  }
+static void RemoveActiveEvent(TimingEvent* event)
+{
+  // Deactivated from within its own callback, so it's already been taken out of the heap.
+  if (event->m_heap_index == TimingEvent::INVALID_HEAP_INDEX)
+    return;
+
+  HeapRemove(event);
+  UpdateHeadEvent(nullptr);
+}
+
+static std::vector<TimingEvent*> GetSortedActiveEvents()
+{
+  std::vector<TimingEvent*> events(s_active_events);
+  std::sort(events.begin(), events.end(), EventLess);
+  return events;
+}
 
+static void SortEvents(const std::vector<TimingEvent*>& events)
+{
+  for (TimingEvent* event : s_active_events)
+    event->m_heap_index = TimingEvent::INVALID_HEAP_INDEX;
+  s_active_events.clear();
   s_active_events_head = nullptr;
-  s_active_events_tail = nullptr;
-  s_active_event_count = 0;
 
   for (TimingEvent* event : events)
     AddActiveEvent(event);
@@ -266,7 +226,7 @@ static void SortEvents()
 
 static TimingEvent* FindActiveEvent(const char* name)
 {
-  for (TimingEvent* event = s_active_events_head; event; event = event->next)
+  for (TimingEvent* event : s_active_events)
   {
     if (event->GetName().compare(name) == 0)
       return event;
@@ -275,6 +235,15 @@ static TimingEvent* FindActiveEvent(const char* name)
   return nullptr;
 }
 
+static void UpdateFrameInvokeCounts()
+{
+  for (TimingEvent* event : s_all_events)
+  {
+    event->m_last_frame_invoke_count = event->m_frame_invoke_count;
+    event->m_frame_invoke_count = 0;
+  }
+}
+
 bool IsRunningEvents()
 {
   return (s_current_event != nullptr);
@@ -296,42 +265,55 @@ void RunEvents()
       CPU::DispatchInterrupt();
 
     TickCount pending_ticks = CPU::GetPendingTicks();
-    if (pending_ticks >= s_active_events_head->GetDowncount())
+    if (s_active_events_head && pending_ticks >= s_active_events_head->GetDowncount())
     {
       CPU::ResetPendingTicks();
       s_event_run_tick_counter = s_global_tick_counter + static_cast<u32>(pending_ticks);
 
       do
       {
-        const TickCount time = std::min(pending_ticks, s_active_events_head->GetDowncount());
+        const TickCount time =
+          s_active_events_head ? std::min(pending_ticks, s_active_events_head->GetDowncount()) : pending_ticks;
         s_global_tick_counter += static_cast<u32>(time);
         pending_ticks -= time;
 
         // Apply downcount to all events.
         // This will result in a negative downcount for those events which are late.
-        for (TimingEvent* event = s_active_events_head; event; event = event->next)
+        // Every key moves by the same amount, so the heap order is unchanged.
+        for (TimingEvent* event : s_active_events)
         {
           event->m_downcount -= time;
           event->m_time_since_last_run += time;
         }
 
         // Now we can actually run the callbacks.
-        while (s_active_events_head->m_downcount <= 0)
+        while (s_active_events_head && s_active_events_head->m_downcount <= 0)
         {
-          // move it to the end, since that'll likely be its new position
+          // Take it out of the heap while the callback runs, so anything it schedules is sorted against the others.
           TimingEvent* event = s_active_events_head;
           s_current_event = event;
+          HeapRemove(event);
+          s_active_events_head = s_active_events.empty() ? nullptr : s_active_events.front();
 
           // Factor late time into the time for the next invocation.
           const TickCount ticks_late = -event->m_downcount;
           const TickCount ticks_to_execute = event->m_time_since_last_run;
+          const TickCount old_downcount = event->m_downcount;
           event->m_downcount += event->m_interval;
           event->m_time_since_last_run = 0;
+          event->m_invoke_count++;
+          event->m_frame_invoke_count++;
 
           // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
           event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
-          if (event->m_active)
-            SortEvent(event);
+
+          // Put it back, unless it was deactivated, or deactivated and reactivated in the callback.
+          if (event->m_active && event->m_heap_index == TimingEvent::INVALID_HEAP_INDEX)
+          {
+            UpdateEventOrder(event, old_downcount);
+            HeapInsert(event);
+            s_active_events_head = s_active_events.front();
+          }
         }
       } while (pending_ticks > 0);
 
@@ -341,6 +323,7 @@ void RunEvents()
     if (s_frame_done)
     {
       s_frame_done = false;
+      UpdateFrameInvokeCounts();
       System::FrameDone();
     }
 
@@ -354,6 +337,9 @@ bool DoState(StateWrapper& sw)
 
   if (sw.IsReading())
   {
+    // Events are re-added in their current order once the new downcounts are loaded.
+    const std::vector<TimingEvent*> events = GetSortedActiveEvents();
+
     // Load timestamps for the clock events.
     // Any oneshot events should be recreated by the load state method, so we can fix up their times here.
     u32 event_count = 0;
@@ -392,14 +378,15 @@ bool DoState(StateWrapper& sw)
     }
 
     Log_DebugPrintf("Loaded %u events from save state.", event_count);
-    SortEvents();
+    SortEvents(events);
   }
   else
   {
+    const std::vector<TimingEvent*> events = GetSortedActiveEvents();
+    u32 event_count = static_cast<u32>(events.size());
+    sw.Do(&event_count);
 
-    sw.Do(&s_active_event_count);
-
-    for (TimingEvent* event = s_active_events_head; event; event = event->next)
+    for (TimingEvent* event : events)
     {
       sw.Do(&event->m_name);
       sw.Do(&event->m_downcount);
@@ -408,12 +395,71 @@ bool DoState(StateWrapper& sw)
       sw.Do(&event->m_interval);
     }
 
-    Log_DebugPrintf("Wrote %u events to save state.", s_active_event_count);
+    Log_DebugPrintf("Wrote %u events to save state.", event_count);
   }
 
   return !sw.HasError();
 }
 
+void DrawDebugStateWindow()
+{
+  static constexpr u32 NUM_COLUMNS = 7;
+  static constexpr std::array<const char*, NUM_COLUMNS> column_names = {
+    {"Name", "Active", "Downcount", "Interval", "Period", "Calls/Frame", "Total Calls"}};
+
+  const float framebuffer_scale = Host::GetOSDScale();
+
+  ImGui::SetNextWindowSize(ImVec2(800.0f * framebuffer_scale, 400.0f * framebuffer_scale), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("Timing Events", nullptr))
+  {
+    ImGui::End();
+    return;
+  }
+
+  ImGui::Columns(NUM_COLUMNS);
+  ImGui::SetColumnWidth(0, 200.0f * framebuffer_scale);
+  for (u32 i = 1; i < NUM_COLUMNS; i++)
+    ImGui::SetColumnWidth(i, 100.0f * framebuffer_scale);
+
+  for (const char* title : column_names)
+  {
+    ImGui::TextUnformatted(title);
+    ImGui::NextColumn();
+  }
+
+  // Active events in the order they'll run, then the inactive ones.
+  std::vector<TimingEvent*> events = GetSortedActiveEvents();
+  for (TimingEvent* event : s_all_events)
+  {
+    if (!event->IsActive())
+      events.push_back(event);
+  }
+
+  for (const TimingEvent* event : events)
+  {
+    ImGui::PushStyleColor(ImGuiCol_Text,
+                          event->IsActive() ? ImVec4(1.0f, 1.0f, 1.0f, 1.0f) : ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+    ImGui::TextUnformatted(event->GetName().c_str());
+    ImGui::NextColumn();
+    ImGui::TextUnformatted(event->IsActive() ? "Yes" : "No");
+    ImGui::NextColumn();
+    ImGui::Text("%d", event->IsActive() ? event->GetTicksUntilNextExecution() : event->GetDowncount());
+    ImGui::NextColumn();
+    ImGui::Text("%d", event->GetInterval());
+    ImGui::NextColumn();
+    ImGui::Text("%d", event->GetPeriod());
+    ImGui::NextColumn();
+    ImGui::Text("%u", event->m_last_frame_invoke_count);
+    ImGui::NextColumn();
+    ImGui::Text("%llu", static_cast<unsigned long long>(event->m_invoke_count));
+    ImGui::NextColumn();
+    ImGui::PopStyleColor();
+  }
+
+  ImGui::Columns(1);
+  ImGui::End();
+}
+
 } // namespace TimingEvents
 
 TimingEvent::TimingEvent(std::string name, TickCount period, TickCount interval, TimingEventCallback callback,
@@ -421,12 +467,17 @@ TimingEvent::TimingEvent(std::string name, TickCount period, TickCount interval,
   : m_callback(callback), m_callback_param(callback_param), m_downcount(interval), m_time_since_last_run(0),
     m_period(period), m_interval(interval), m_name(std::move(name))
 {
+  TimingEvents::s_all_events.push_back(this);
 }
 
 TimingEvent::~TimingEvent()
 {
   if (m_active)
     TimingEvents::RemoveActiveEvent(this);
+
+  auto iter = std::find(TimingEvents::s_all_events.begin(), TimingEvents::s_all_events.end(), this);
+  if (iter != TimingEvents::s_all_events.end())
+    TimingEvents::s_all_events.erase(iter);
 }
 
 TickCount TimingEvent::GetTicksSinceLastExecution() const
@@ -447,17 +498,17 @@ void TimingEvent::Delay(TickCount ticks)
     return;
   }
 
+  const TickCount old_downcount = m_downcount;
   m_downcount += ticks;
 
   DebugAssert(TimingEvents::s_current_event != this);
-  TimingEvents::SortEvent(this);
-  if (TimingEvents::s_active_events_head == this)
-    TimingEvents::UpdateCPUDowncount();
+  TimingEvents::SortEvent(this, old_downcount);
 }
 
 void TimingEvent::Schedule(TickCount ticks)
 {
   const TickCount pending_ticks = CPU::GetPendingTicks();
+  const TickCount old_downcount = m_downcount;
   m_downcount = pending_ticks + ticks;
 
   if (!m_active)
@@ -472,11 +523,7 @@ void TimingEvent::Schedule(TickCount ticks)
     // Event is already active, so we leave the time since last run alone, and just modify the downcount.
     // If this is a call from an IO handler for example, re-sort the event queue.
     if (TimingEvents::s_current_event != this)
-    {
-      TimingEvents::SortEvent(this);
-      if (TimingEvents::s_active_events_head == this)
-        TimingEvents::UpdateCPUDowncount();
-    }
+      TimingEvents::SortEvent(this, old_downcount);
   }
 }
 
@@ -498,14 +545,11 @@ void TimingEvent::Reset()
   if (!m_active)
     return;
 
+  const TickCount old_downcount = m_downcount;
   m_downcount = m_interval;
   m_time_since_last_run = 0;
   if (TimingEvents::s_current_event != this)
-  {
-    TimingEvents::SortEvent(this);
-    if (TimingEvents::s_active_events_head == this)
-      TimingEvents::UpdateCPUDowncount();
-  }
+    TimingEvents::SortEvent(this, old_downcount);
 }
 
 void TimingEvent::InvokeEarly(bool force /* = false */)
@@ -518,15 +562,27 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if ((!force && ticks_to_execute < m_period) || ticks_to_execute <= 0)
     return;
 
+  const TickCount old_downcount = m_downcount;
   m_downcount = pending_ticks + m_interval;
   m_time_since_last_run -= ticks_to_execute;
+  m_invoke_count++;
+  m_frame_invoke_count++;
+
+  // Keep it out of the heap while the callback runs, in case it reschedules itself.
+  DebugAssert(TimingEvents::s_current_event != this);
+  TimingEvents::HeapRemove(this);
+  TimingEvents::s_active_events_head =
+    TimingEvents::s_active_events.empty() ? nullptr : TimingEvents::s_active_events.front();
+
   m_callback(m_callback_param, ticks_to_execute, 0);
 
   // Since we've changed the downcount, we need to re-sort the events.
-  DebugAssert(TimingEvents::s_current_event != this);
-  TimingEvents::SortEvent(this);
-  if (TimingEvents::s_active_events_head == this)
-    TimingEvents::UpdateCPUDowncount();
+  if (m_active && m_heap_index == INVALID_HEAP_INDEX)
+  {
+    TimingEvents::UpdateEventOrder(this, old_downcount);
+    TimingEvents::HeapInsert(this);
+  }
+  TimingEvents::UpdateHeadEvent(this);
 }
 
 void TimingEvent::Activate()
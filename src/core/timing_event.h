@@ -63,8 +63,16 @@ public:
   void SetInterval(TickCount interval) { m_interval = interval; }
   void SetPeriod(TickCount period) { m_period = period; }
 
-  TimingEvent* prev = nullptr;
-  TimingEvent* next = nullptr;
+  static constexpr u32 INVALID_HEAP_INDEX = 0xFFFFFFFFu;
+
+  // Position in the active event heap, and tie-breaker for events with the same downcount.
+  u32 m_heap_index = INVALID_HEAP_INDEX;
+  s64 m_order = 0;
+
+  // Number of times the callback has run, for the debug window.
+  u64 m_invoke_count = 0;
+  u32 m_frame_invoke_count = 0;
+  u32 m_last_frame_invoke_count = 0;
 
   TimingEventCallback m_callback;
   void* m_callback_param;
@@ -102,4 +110,6 @@ void UpdateCPUDowncount();
 
 TimingEvent** GetHeadEventPtr();
 
+void DrawDebugStateWindow();
+
 } // namespace TimingEvents
\ No newline at end of file
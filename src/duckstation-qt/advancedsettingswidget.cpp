@@ -238,6 +238,10 @@ void AdvancedSettingsWidget::addTweakOptions()
                          Settings::DEFAULT_GPU_FIFO_SIZE);
   addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("GPU Max Run-Ahead"), "Hacks", "GPUMaxRunAhead", 0, 1000,
                          Settings::DEFAULT_GPU_MAX_RUN_AHEAD);
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Software Renderer Threads"), "GPU",
+                         "SoftwareRendererThreads", 1, 17, 1);
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("GPU Thread Wake Threshold"), "GPU",
+                         "ThreadWakeThreshold", 4, 65536, Settings::DEFAULT_GPU_THREAD_WAKE_THRESHOLD);
 
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Memory Exceptions"), "CPU",
                         "RecompilerMemoryExceptions", false);
@@ -255,10 +259,19 @@ void AdvancedSettingsWidget::addTweakOptions()
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Region Check"), "CDROM", "RegionCheck", false);
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Allow Booting Without SBI File"), "CDROM",
                         "AllowBootingWithoutSBIFile", false);
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CHD Prefetch Hunks"), "CDROM", "CHDPrefetchHunks", 0,
+                         16, Settings::DEFAULT_CDROM_CHD_PREFETCH_HUNKS);
 
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable PCDrv"), "PCDrv", "Enabled", false);
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable PCDrv Writes"), "PCDrv", "EnableWrites", false);
   addDirectoryOption(m_dialog, m_ui.tweakOptionTable, tr("PCDrv Root Directory"), "PCDrv", "Root");
+
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Capture Queue Frames"), "Capture", "QueueFrames", 1, 120,
+                         Settings::DEFAULT_CAPTURE_QUEUE_FRAMES);
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Capture Keyframe Interval"), "Capture",
+                         "KeyframeInterval", 1, 3600, Settings::DEFAULT_CAPTURE_KEYFRAME_INTERVAL);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Drop Capture Frames When Queue Is Full"), "Capture",
+                        "DropFramesWhenFull", false);
 }
 
 void AdvancedSettingsWidget::onResetToDefaultClicked()
@@ -279,6 +292,9 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
                            static_cast<int>(Settings::DEFAULT_GPU_FIFO_SIZE)); // GPU FIFO size
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD)); // GPU max run-ahead
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++, 1);                         // Software renderer threads
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           static_cast<int>(Settings::DEFAULT_GPU_THREAD_WAKE_THRESHOLD)); // GPU thread wake threshold
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler memory exceptions
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);                       // Recompiler block linking
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
@@ -287,9 +303,16 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
                          Settings::DEFAULT_CDROM_MECHACON_VERSION); // CDROM Mechacon Version
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);       // CDROM Region Check
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);       // Allow booting without SBI file
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           static_cast<int>(Settings::DEFAULT_CDROM_CHD_PREFETCH_HUNKS)); // CHD prefetch hunks
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);       // Enable PCDRV
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);       // Enable PCDRV Writes
     setDirectoryOption(m_ui.tweakOptionTable, i++, "");             // PCDrv Root Directory
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           static_cast<int>(Settings::DEFAULT_CAPTURE_QUEUE_FRAMES)); // Capture queue frames
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           static_cast<int>(Settings::DEFAULT_CAPTURE_KEYFRAME_INTERVAL)); // Capture keyframe interval
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false); // Drop capture frames when full
 
     return;
   }
@@ -308,15 +331,21 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   sif->DeleteValue("Hacks", "DMAHaltTicks");
   sif->DeleteValue("Hacks", "GPUFIFOSize");
   sif->DeleteValue("Hacks", "GPUMaxRunAhead");
+  sif->DeleteValue("GPU", "SoftwareRendererThreads");
+  sif->DeleteValue("GPU", "ThreadWakeThreshold");
   sif->DeleteValue("CPU", "RecompilerMemoryExceptions");
   sif->DeleteValue("CPU", "RecompilerBlockLinking");
   sif->DeleteValue("CPU", "FastmemMode");
   sif->DeleteValue("CDROM", "MechaconVersion");
   sif->DeleteValue("CDROM", "RegionCheck");
   sif->DeleteValue("CDROM", "AllowBootingWithoutSBIFile");
+  sif->DeleteValue("CDROM", "CHDPrefetchHunks");
   sif->DeleteValue("PCDrv", "Enabled");
   sif->DeleteValue("PCDrv", "EnableWrites");
   sif->DeleteValue("PCDrv", "Root");
+  sif->DeleteValue("Capture", "QueueFrames");
+  sif->DeleteValue("Capture", "KeyframeInterval");
+  sif->DeleteValue("Capture", "DropFramesWhenFull");
   sif->Save();
   while (m_ui.tweakOptionTable->rowCount() > 0)
     m_ui.tweakOptionTable->removeRow(m_ui.tweakOptionTable->rowCount() - 1);
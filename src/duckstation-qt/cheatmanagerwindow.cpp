@@ -311,7 +311,7 @@ void CheatManagerWindow::cheatListItemChanged(QTreeWidgetItem* item, int column)
   if (static_cast<u32>(index) >= list->GetCodeCount())
     return;
 
-  CheatCode& cc = list->GetCode(static_cast<u32>(index));
+  const CheatCode& cc = list->GetCode(static_cast<u32>(index));
   if (cc.IsManuallyActivated())
     return;
 
@@ -331,7 +331,7 @@ void CheatManagerWindow::activateCheat(u32 index)
   if (index >= list->GetCodeCount())
     return;
 
-  CheatCode& cc = list->GetCode(index);
+  const CheatCode& cc = list->GetCode(index);
   if (cc.IsManuallyActivated())
   {
     g_emu_thread->applyCheat(index);
@@ -25,6 +25,8 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindEnable, "Main", "RewindEnable", false);
   SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_ui.rewindSaveFrequency, "Main", "RewindFrequency", 10.0f);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.rewindSaveSlots, "Main", "RewindSaveSlots", 10);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindDeltaStates, "Main", "RewindDeltaStates", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindCompressStates, "Main", "RewindCompressStates", false);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.runaheadFrames, "Main", "RunaheadFrameCount", 0);
 
   const float effective_emulation_speed = m_dialog->getEffectiveFloatValue("Main", "EmulationSpeed", 1.0f);
@@ -81,6 +83,7 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
           &EmulationSettingsWidget::updateRewind);
   connect(m_ui.rewindSaveSlots, QOverload<int>::of(&QSpinBox::valueChanged), this,
           &EmulationSettingsWidget::updateRewind);
+  connect(m_ui.rewindDeltaStates, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::updateRewind);
   connect(m_ui.runaheadFrames, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
           &EmulationSettingsWidget::updateRewind);
 
@@ -128,6 +131,14 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
        "requirements.<br> "
        "<b>Rewind Buffer Size:</b> How many saves will be kept for rewinding. Higher values have greater memory "
        "requirements."));
+  dialog->registerWidgetHelp(
+    m_ui.rewindDeltaStates, tr("Delta Encode Rewind States"), tr("Unchecked"),
+    tr("Only keeps the newest rewind state in full, storing older states as differences between saves. Significantly "
+       "reduces RAM usage, allowing for larger rewind buffers, at a small CPU cost when saving and rewinding. VRAM "
+       "usage is unchanged, as the hardware renderers still keep a copy of VRAM for every state."));
+  dialog->registerWidgetHelp(
+    m_ui.rewindCompressStates, tr("Compress Rewind States"), tr("Unchecked"),
+    tr("Compresses delta encoded rewind states on a background thread, further reducing memory usage."));
   dialog->registerWidgetHelp(
     m_ui.runaheadFrames, tr("Runahead"), tr("Disabled"),
     tr(
@@ -245,6 +256,8 @@ void EmulationSettingsWidget::updateRewind()
         .arg(vram_usage / 1048576));
     m_ui.rewindSaveFrequency->setEnabled(true);
     m_ui.rewindSaveSlots->setEnabled(true);
+    m_ui.rewindDeltaStates->setEnabled(true);
+    m_ui.rewindCompressStates->setEnabled(m_dialog->getEffectiveBoolValue("Main", "RewindDeltaStates", false));
   }
   else
   {
@@ -260,5 +273,7 @@ void EmulationSettingsWidget::updateRewind()
     }
     m_ui.rewindSaveFrequency->setEnabled(false);
     m_ui.rewindSaveSlots->setEnabled(false);
+    m_ui.rewindDeltaStates->setEnabled(false);
+    m_ui.rewindCompressStates->setEnabled(false);
   }
 }
@@ -1083,7 +1083,7 @@ void MainWindow::populateCheatsMenu(QMenu* menu)
 
       for (u32 i = 0; i < cl->GetCodeCount(); i++)
       {
-        CheatCode& cc = cl->GetCode(i);
+        const CheatCode& cc = cl->GetCode(i);
         if (cc.group != group)
           continue;
 
@@ -2136,6 +2136,12 @@ void MainWindow::connectSignals()
     else
       g_emu_thread->stopDumpingAudio();
   });
+  connect(m_ui.actionCaptureVideo, &QAction::toggled, [](bool checked) {
+    if (checked)
+      g_emu_thread->startCapture();
+    else
+      g_emu_thread->stopCapture();
+  });
   connect(m_ui.actionDumpRAM, &QAction::triggered, [this]() {
     const QString filename = QDir::toNativeSeparators(
       QFileDialog::getSaveFileName(this, tr("Destination File"), QString(), tr("Binary Files (*.bin)")));
@@ -2169,6 +2175,8 @@ void MainWindow::connectSignals()
                                                false);
   SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowMDECState, "Debug", "ShowMDECState", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowDMAState, "Debug", "ShowDMAState", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowTimingEventsState, "Debug",
+                                               "ShowTimingEventsState", false);
 
   for (u32 i = 0; InterfaceSettingsWidget::THEME_NAMES[i]; i++)
   {
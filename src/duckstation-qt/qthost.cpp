@@ -1345,6 +1345,28 @@ void EmuThread::stopDumpingAudio()
   System::StopDumpingAudio();
 }
 
+void EmuThread::startCapture()
+{
+  if (!isOnThread())
+  {
+    QMetaObject::invokeMethod(this, "startCapture", Qt::QueuedConnection);
+    return;
+  }
+
+  System::StartCapture();
+}
+
+void EmuThread::stopCapture()
+{
+  if (!isOnThread())
+  {
+    QMetaObject::invokeMethod(this, "stopCapture", Qt::QueuedConnection);
+    return;
+  }
+
+  System::StopCapture();
+}
+
 void EmuThread::singleStepCPU()
 {
   if (!isOnThread())
@@ -182,6 +182,8 @@ public Q_SLOTS:
   void setAudioOutputMuted(bool muted);
   void startDumpingAudio();
   void stopDumpingAudio();
+  void startCapture();
+  void stopCapture();
   void singleStepCPU();
   void dumpRAM(const QString& filename);
   void dumpVRAM(const QString& filename);
@@ -2,10 +2,18 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "core/achievements.h"
+#include "core/cpu_code_cache.h"
+#include "core/cpu_core.h"
+#include "core/cpu_types.h"
 #include "core/fullscreen_ui.h"
 #include "core/game_list.h"
 #include "core/gpu.h"
+#include "core/gte.h"
 #include "core/host.h"
+#include "core/mdec.h"
+#include "core/perf_sections.h"
+#include "core/save_state_version.h"
+#include "core/spu.h"
 #include "core/system.h"
 
 #include "scmversion/scmversion.h"
@@ -16,17 +24,28 @@
 #include "util/platform_misc.h"
 
 #include "common/assert.h"
+#include "common/byte_stream.h"
 #include "common/crash_handler.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/memory_settings_interface.h"
 #include "common/path.h"
+#include "common/small_string.h"
 #include "common/string_util.h"
+#include "common/threading.h"
+#include "common/timer.h"
 
 #include <csignal>
 #include <cstdio>
 
+#ifdef _WIN32
+#include "common/windows_headers.h"
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
 Log_SetChannel(RegTestHost);
 
 namespace RegTestHost {
@@ -36,8 +55,14 @@ static void PrintCommandLineHelp(const char* progname);
 static bool InitializeConfig();
 static void InitializeEarlyConsole();
 static void HookSignals();
+static void WriteCrashState();
 static bool SetFolders();
 static std::string GetFrameDumpFilename(u32 frame);
+static void StartBenchmark();
+static bool WriteBenchmarkReport();
+static u64 GetPeakMemoryUsage();
+static bool OpenFrameHashLogs();
+static void RecordFrameHashes();
 } // namespace RegTestHost
 
 static std::unique_ptr<MemorySettingsInterface> s_base_settings_interface;
@@ -46,6 +71,51 @@ static u32 s_frames_to_run = 60 * 60;
 static u32 s_frame_dump_interval = 0;
 static std::string s_dump_base_directory;
 static std::string s_dump_game_directory;
+static std::string s_mdec_capture_path;
+static std::string s_capture_path;
+static std::string s_mdec_benchmark_path;
+static u32 s_mdec_benchmark_iterations = 100;
+static std::string s_reverb_capture_path;
+static std::string s_reverb_benchmark_path;
+static u32 s_gte_test_iterations = 0;
+static std::string s_achievement_benchmark_path;
+static std::string s_benchmark_report_path;
+static u32 s_benchmark_warmup_frames = 5 * 60;
+static u32 s_frames_executed = 0;
+
+namespace {
+struct BenchmarkStartState
+{
+  Common::Timer::Value time;
+  u64 cpu_thread_time;
+  u64 sw_thread_time;
+  u32 frame_number;
+  u32 internal_frame_number;
+  CPU::CodeCache::CompileStats compile_stats;
+  CPU::CodeCache::CodeBufferStats code_buffer_stats;
+};
+} // namespace
+
+static BenchmarkStartState s_benchmark_start = {};
+
+namespace {
+struct FrameHashes
+{
+  u32 frame;
+  std::array<u64, 2> vram;
+  u64 audio;
+};
+} // namespace
+
+static constexpr const char* FRAME_HASH_LOG_HEADER = "# DuckStation regtest frame hashes: frame vram audio";
+
+static std::string s_hash_log_path;
+static std::string s_hash_compare_path;
+static FileSystem::ManagedCFilePtr s_hash_log_file;
+static std::vector<FrameHashes> s_golden_hashes;
+static size_t s_golden_hash_index = 0;
+static std::optional<u32> s_first_divergent_frame;
+static u32 s_divergent_frame_count = 0;
 
 bool RegTestHost::SetFolders()
 {
@@ -283,9 +353,29 @@ void Host::OnGameChanged(const std::string& disc_path, const std::string& game_s
 
 void Host::PumpMessagesOnCPUThread()
 {
+  if (s_hash_log_file || !s_golden_hashes.empty())
+    RegTestHost::RecordFrameHashes();
+
+  s_frames_executed++;
+  if (!s_benchmark_report_path.empty() && s_frames_executed == s_benchmark_warmup_frames)
+    RegTestHost::StartBenchmark();
+
   s_frames_to_run--;
   if (s_frames_to_run == 0)
+  {
+    Error error;
+    if (!s_reverb_capture_path.empty() && !SPU::SaveReverbState(s_reverb_capture_path.c_str(), &error))
+      Log_ErrorFmt("Failed to save reverb state: {}", error.GetDescription());
+    if (!s_achievement_benchmark_path.empty() &&
+        !Achievements::RunReadBenchmark(s_achievement_benchmark_path.c_str(), 60 * 60, &error))
+    {
+      Log_ErrorFmt("Achievement read benchmark failed: {}", error.GetDescription());
+    }
+    if (!s_benchmark_report_path.empty() && !RegTestHost::WriteBenchmarkReport())
+      Log_ErrorFmt("Failed to write benchmark report to '{}'", s_benchmark_report_path);
+
     System::ShutdownSystem(false);
+  }
 }
 
 void Host::RunOnCPUThread(std::function<void()> function, bool block /* = false */)
@@ -446,10 +536,43 @@ static void SignalHandler(int signal)
 #endif
 }
 
+static void CrashSignalHandler(int signal)
+{
+  std::signal(signal, SIG_DFL);
+  RegTestHost::WriteCrashState();
+  std::raise(signal);
+}
+
 void RegTestHost::HookSignals()
 {
   std::signal(SIGINT, SignalHandler);
   std::signal(SIGTERM, SignalHandler);
+
+  // Panics, fatal errors and unhandled page faults all end up in abort().
+  std::signal(SIGABRT, CrashSignalHandler);
+}
+
+void RegTestHost::WriteCrashState()
+{
+  // Written as a single line so the suite runner can pick it out of the log. Avoids the heap, since we could be here
+  // because it is corrupted. The PC is the last one the CPU synchronized, which lags behind in recompiled code.
+  const CPU::State& state = CPU::g_state;
+  SmallStackString<2048> str;
+  str.append_format("REGTEST_CRASH {{\"frame\": {}, \"pc\": \"0x{:08X}\", \"instruction_pc\": \"0x{:08X}\", "
+                    "\"instruction\": \"0x{:08X}\", \"in_branch_delay_slot\": {}, \"sr\": \"0x{:08X}\", "
+                    "\"cause\": \"0x{:08X}\", \"epc\": \"0x{:08X}\", \"regs\": {{",
+                    System::IsShutdown() ? 0u : System::GetFrameNumber(), state.pc, state.current_instruction_pc,
+                    state.current_instruction.bits, state.current_instruction_in_branch_delay_slot,
+                    state.cop0_regs.sr.bits, state.cop0_regs.cause.bits, state.cop0_regs.EPC);
+  for (u32 i = 0; i < static_cast<u32>(CPU::Reg::count); i++)
+  {
+    str.append_format("{}\"{}\": \"0x{:08X}\"", (i == 0) ? "" : ", ", CPU::GetRegName(static_cast<CPU::Reg>(i)),
+                      state.regs.r[i]);
+  }
+  str.append("}}\n");
+
+  std::fwrite(str.c_str(), str.length(), 1, stderr);
+  std::fflush(stderr);
 }
 
 void RegTestHost::InitializeEarlyConsole()
@@ -480,6 +603,20 @@ void RegTestHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
   std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
   std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Default to software.\n");
+  std::fprintf(stderr, "  -mdeccapture <file>: Records all MDEC input to the specified file.\n");
+  std::fprintf(stderr, "  -capture <file>: Records the display and audio losslessly to the specified file.\n");
+  std::fprintf(stderr, "  -mdecbench <file>: Benchmarks decoding of a MDEC capture, then exits.\n");
+  std::fprintf(stderr, "  -mdecbenchiterations <count>: Number of times to decode the capture. Defaults to 100.\n");
+  std::fprintf(stderr, "  -reverbcapture <file>: Saves the SPU reverb state to a file after the last frame.\n");
+  std::fprintf(stderr, "  -reverbbench <file>: Benchmarks one minute of SPU reverb from a saved state, then exits.\n");
+  std::fprintf(stderr, "  -gtetest <count>: Checks specialized GTE handlers against the generic ones, then exits.\n");
+  std::fprintf(stderr, "  -achievementbench <file>: Times one minute of achievement processing against RAM after\n"
+                       "    the last frame, using a saved RetroAchievements patch response. No server is needed.\n");
+  std::fprintf(stderr, "  -benchmark <file>: Writes a JSON performance report to the file, or stdout if '-'.\n");
+  std::fprintf(stderr, "  -warmupframes <count>: Frames to run before benchmark timing starts. Defaults to 300.\n");
+  std::fprintf(stderr, "  -hashlog <file>: Writes a hash of the displayed VRAM and SPU output for each frame.\n");
+  std::fprintf(stderr, "  -hashcompare <file>: Compares frame hashes against a log from -hashlog, and reports\n"
+                       "    the first frame which differs.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -599,6 +736,85 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
                                                   Settings::GetCPUExecutionModeName(cpu.value()));
         continue;
       }
+      else if (CHECK_ARG_PARAM("-mdeccapture"))
+      {
+        s_mdec_capture_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-capture"))
+      {
+        s_capture_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-mdecbench"))
+      {
+        s_mdec_benchmark_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-mdecbenchiterations"))
+      {
+        s_mdec_benchmark_iterations = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_mdec_benchmark_iterations == 0)
+        {
+          Log_ErrorPrintf("Invalid MDEC benchmark iteration count: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-reverbcapture"))
+      {
+        s_reverb_capture_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-reverbbench"))
+      {
+        s_reverb_benchmark_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gtetest"))
+      {
+        s_gte_test_iterations = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_gte_test_iterations == 0)
+        {
+          Log_ErrorPrintf("Invalid GTE test iteration count: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-achievementbench"))
+      {
+        s_achievement_benchmark_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        s_benchmark_report_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-warmupframes"))
+      {
+        const std::optional<u32> frames = StringUtil::FromChars<u32>(argv[++i]);
+        if (!frames.has_value())
+        {
+          Log_ErrorPrintf("Invalid warm-up frame count: %s", argv[i]);
+          return false;
+        }
+
+        s_benchmark_warmup_frames = frames.value();
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-hashlog"))
+      {
+        s_hash_log_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-hashcompare"))
+      {
+        s_hash_compare_path = argv[++i];
+        continue;
+      }
       else if (CHECK_ARG("-pgxp"))
       {
         Log_InfoPrint("Enabling PGXP.");
@@ -640,6 +856,283 @@ std::string RegTestHost::GetFrameDumpFilename(u32 frame)
   return Path::Combine(s_dump_game_directory, fmt::format("frame_{:05d}.png", frame));
 }
 
+void RegTestHost::StartBenchmark()
+{
+  Log_InfoFmt("Starting benchmark timing at frame {}.", System::GetFrameNumber());
+
+  const Threading::Thread* sw_thread = g_gpu->GetSWThread();
+  s_benchmark_start.time = Common::Timer::GetCurrentValue();
+  s_benchmark_start.cpu_thread_time = Threading::GetThreadCpuTime();
+  s_benchmark_start.sw_thread_time = sw_thread ? sw_thread->GetCPUTime() : 0;
+  s_benchmark_start.frame_number = System::GetFrameNumber();
+  s_benchmark_start.internal_frame_number = System::GetInternalFrameNumber();
+  s_benchmark_start.compile_stats = CPU::CodeCache::GetCompileStats();
+  s_benchmark_start.code_buffer_stats = CPU::CodeCache::GetCodeBufferStats();
+
+  PerfSections::SetEnabled(true);
+  PerfSections::Reset();
+}
+
+u64 RegTestHost::GetPeakMemoryUsage()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc = {};
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return 0;
+
+  return pmc.PeakWorkingSetSize;
+#else
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) != 0)
+    return 0;
+
+  // Linux reports kilobytes, macOS reports bytes.
+#ifdef __APPLE__
+  return static_cast<u64>(ru.ru_maxrss);
+#else
+  return static_cast<u64>(ru.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static std::string EscapeJSONString(std::string_view str)
+{
+  std::string ret;
+  ret.reserve(str.size());
+  for (const char ch : str)
+  {
+    if (ch == '"' || ch == '\\')
+    {
+      ret.push_back('\\');
+      ret.push_back(ch);
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20)
+    {
+      fmt::format_to(std::back_inserter(ret), "\\u{:04x}", static_cast<unsigned>(ch));
+    }
+    else
+    {
+      ret.push_back(ch);
+    }
+  }
+
+  return ret;
+}
+
+bool RegTestHost::WriteBenchmarkReport()
+{
+  const Common::Timer::Value end_time = Common::Timer::GetCurrentValue();
+  const double elapsed = Common::Timer::ConvertValueToSeconds(end_time - s_benchmark_start.time);
+  const double thread_ticks_per_second = static_cast<double>(Threading::GetThreadTicksPerSecond());
+  const Threading::Thread* sw_thread = g_gpu->GetSWThread();
+  const double cpu_thread_time =
+    static_cast<double>(Threading::GetThreadCpuTime() - s_benchmark_start.cpu_thread_time) / thread_ticks_per_second;
+  const double sw_thread_time =
+    sw_thread ? (static_cast<double>(sw_thread->GetCPUTime() - s_benchmark_start.sw_thread_time) /
+                 thread_ticks_per_second) :
+                0.0;
+  const u32 frames = System::GetFrameNumber() - s_benchmark_start.frame_number;
+  const u32 internal_frames = System::GetInternalFrameNumber() - s_benchmark_start.internal_frame_number;
+  const double fps = (elapsed > 0.0) ? (static_cast<double>(frames) / elapsed) : 0.0;
+  const double speed = fps / static_cast<double>(System::GetThrottleFrequency()) * 100.0;
+
+  std::string sections;
+  for (u32 i = 0; i < static_cast<u32>(PerfSections::Section::Count); i++)
+  {
+    const PerfSections::Section section = static_cast<PerfSections::Section>(i);
+    fmt::format_to(std::back_inserter(sections), "{}\n    \"{}\": {:.6f}", (i == 0) ? "" : ",",
+                   PerfSections::GetSectionName(section), PerfSections::GetSectionTime(section));
+  }
+  PerfSections::SetEnabled(false);
+
+  const CPU::CodeCache::CompileStats& cs = CPU::CodeCache::GetCompileStats();
+  const CPU::CodeCache::CodeBufferStats& cbs = CPU::CodeCache::GetCodeBufferStats();
+  const CPU::CodeCache::CompileStats& start_cs = s_benchmark_start.compile_stats;
+  const CPU::CodeCache::CodeBufferStats& start_cbs = s_benchmark_start.code_buffer_stats;
+
+  // Save state sizes, uncompressed and with the compression used for the save state slots.
+  u64 state_size = 0;
+  u64 compressed_state_size = 0;
+  double state_save_time = 0.0;
+  {
+    Error error;
+    std::unique_ptr<GrowableMemoryByteStream> stream = std::make_unique<GrowableMemoryByteStream>(nullptr, 0);
+    Common::Timer save_timer;
+    if (!System::SaveStateToStream(stream.get(), &error, 0, SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE))
+    {
+      Log_ErrorFmt("Failed to save state for benchmark report: {}", error.GetDescription());
+      return false;
+    }
+    state_save_time = save_timer.GetTimeMilliseconds();
+    state_size = stream->GetPosition();
+
+    stream->SeekAbsolute(0);
+    if (!System::SaveStateToStream(stream.get(), &error, 0, SAVE_STATE_HEADER::COMPRESSION_TYPE_ZSTD))
+    {
+      Log_ErrorFmt("Failed to save compressed state for benchmark report: {}", error.GetDescription());
+      return false;
+    }
+    compressed_state_size = stream->GetPosition();
+  }
+
+  std::string report = fmt::format(
+    "{{\n"
+    "  \"game\": {{\n"
+    "    \"path\": \"{}\",\n"
+    "    \"serial\": \"{}\",\n"
+    "    \"title\": \"{}\"\n"
+    "  }},\n"
+    "  \"renderer\": \"{}\",\n"
+    "  \"cpu_execution_mode\": \"{}\",\n"
+    "  \"warmup_frames\": {},\n"
+    "  \"frames\": {},\n"
+    "  \"internal_frames\": {},\n"
+    "  \"elapsed_seconds\": {:.6f},\n"
+    "  \"fps\": {:.3f},\n"
+    "  \"speed_percent\": {:.2f},\n"
+    "  \"cpu_thread_seconds\": {:.6f},\n"
+    "  \"gpu_thread_seconds\": {:.6f},\n"
+    "  \"section_seconds\": {{{}\n"
+    "  }},\n"
+    "  \"jit\": {{\n"
+    "    \"blocks_compiled\": {},\n"
+    "    \"guest_instructions\": {},\n"
+    "    \"host_code_bytes\": {},\n"
+    "    \"page_invalidations\": {},\n"
+    "    \"regions_evicted\": {},\n"
+    "    \"blocks_evicted\": {},\n"
+    "    \"full_flushes\": {}\n"
+    "  }},\n"
+    "  \"peak_rss_bytes\": {},\n"
+    "  \"save_state\": {{\n"
+    "    \"bytes\": {},\n"
+    "    \"compressed_bytes\": {},\n"
+    "    \"save_ms\": {:.3f}\n"
+    "  }}\n"
+    "}}\n",
+    EscapeJSONString(System::GetDiscPath()), EscapeJSONString(System::GetGameSerial()),
+    EscapeJSONString(System::GetGameTitle()), Settings::GetRendererName(g_settings.gpu_renderer),
+    Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode), s_benchmark_warmup_frames, frames,
+    internal_frames, elapsed, fps, speed, cpu_thread_time, sw_thread_time, sections,
+    cs.blocks_compiled - start_cs.blocks_compiled, cs.guest_instructions - start_cs.guest_instructions,
+    cs.host_code_bytes - start_cs.host_code_bytes, cs.page_invalidations - start_cs.page_invalidations,
+    cbs.regions_evicted - start_cbs.regions_evicted, cbs.blocks_evicted - start_cbs.blocks_evicted,
+    cbs.full_flushes - start_cbs.full_flushes, GetPeakMemoryUsage(), state_size, compressed_state_size,
+    state_save_time);
+
+  if (s_benchmark_report_path == "-")
+  {
+    std::fputs(report.c_str(), stdout);
+    std::fflush(stdout);
+    return true;
+  }
+
+  Log_InfoFmt("Writing benchmark report to '{}'.", s_benchmark_report_path);
+  return FileSystem::WriteStringToFile(s_benchmark_report_path.c_str(), report);
+}
+
+bool RegTestHost::OpenFrameHashLogs()
+{
+  Error error;
+  if (!s_hash_compare_path.empty())
+  {
+    std::optional<std::string> golden = FileSystem::ReadFileToString(s_hash_compare_path.c_str(), &error);
+    if (!golden.has_value())
+    {
+      Log_ErrorFmt("Failed to read golden hash log '{}': {}", s_hash_compare_path, error.GetDescription());
+      return false;
+    }
+
+    for (const std::string_view line : StringUtil::SplitString(golden.value(), '\n'))
+    {
+      const std::string_view trimmed = StringUtil::StripWhitespace(line);
+      if (trimmed.empty() || trimmed[0] == '#')
+        continue;
+
+      const std::vector<std::string_view> fields = StringUtil::SplitString(trimmed, ' ');
+      const std::optional<u32> frame = (fields.size() == 3) ? StringUtil::FromChars<u32>(fields[0]) : std::nullopt;
+      const std::optional<u64> vram_high =
+        (frame.has_value() && fields[1].size() == 32) ? StringUtil::FromChars<u64>(fields[1].substr(0, 16), 16) :
+                                                         std::nullopt;
+      const std::optional<u64> vram_low =
+        vram_high.has_value() ? StringUtil::FromChars<u64>(fields[1].substr(16), 16) : std::nullopt;
+      const std::optional<u64> audio = vram_low.has_value() ? StringUtil::FromChars<u64>(fields[2], 16) : std::nullopt;
+      if (!audio.has_value())
+      {
+        Log_ErrorFmt("Malformed line in golden hash log: {}", trimmed);
+        return false;
+      }
+
+      s_golden_hashes.push_back(FrameHashes{frame.value(), {vram_high.value(), vram_low.value()}, audio.value()});
+    }
+
+    if (s_golden_hashes.empty())
+    {
+      Log_ErrorFmt("Golden hash log '{}' is empty.", s_hash_compare_path);
+      return false;
+    }
+
+    Log_InfoFmt("Comparing against {} frame hashes from '{}'.", s_golden_hashes.size(), s_hash_compare_path);
+  }
+
+  if (!s_hash_log_path.empty())
+  {
+    s_hash_log_file = FileSystem::OpenManagedCFile(s_hash_log_path.c_str(), "wb", &error);
+    if (!s_hash_log_file)
+    {
+      Log_ErrorFmt("Failed to open hash log '{}': {}", s_hash_log_path, error.GetDescription());
+      return false;
+    }
+
+    std::fprintf(s_hash_log_file.get(), "%s\n", FRAME_HASH_LOG_HEADER);
+    Log_InfoFmt("Writing frame hashes to '{}'.", s_hash_log_path);
+  }
+
+  SPU::SetOutputHashingEnabled(true);
+  return true;
+}
+
+void RegTestHost::RecordFrameHashes()
+{
+  // Flush the SPU up to the current time, so the audio hash doesn't depend on when the sample event last ran.
+  SPU::GeneratePendingSamples();
+
+  FrameHashes hashes;
+  hashes.frame = System::GetFrameNumber();
+  hashes.vram = g_gpu->HashDisplayedVRAM();
+  hashes.audio = SPU::GetAndResetOutputHash();
+
+  if (s_hash_log_file)
+  {
+    fmt::print(s_hash_log_file.get(), "{} {:016x}{:016x} {:016x}\n", hashes.frame, hashes.vram[0], hashes.vram[1],
+               hashes.audio);
+  }
+
+  if (s_golden_hash_index >= s_golden_hashes.size())
+    return;
+
+  const FrameHashes& golden = s_golden_hashes[s_golden_hash_index++];
+  const bool vram_differs = (golden.vram != hashes.vram);
+  const bool audio_differs = (golden.audio != hashes.audio);
+  if (golden.frame == hashes.frame && !vram_differs && !audio_differs)
+    return;
+
+  s_divergent_frame_count++;
+  if (s_first_divergent_frame.has_value())
+    return;
+
+  s_first_divergent_frame = hashes.frame;
+  if (golden.frame != hashes.frame)
+  {
+    Log_ErrorFmt("Frame {} does not line up with golden frame {}.", hashes.frame, golden.frame);
+  }
+  else
+  {
+    Log_ErrorFmt("First divergent frame is {} ({}{}{}).", hashes.frame, vram_differs ? "video" : "",
+                 (vram_differs && audio_differs) ? " and " : "", audio_differs ? "audio" : "");
+  }
+}
+
 int main(int argc, char* argv[])
 {
   RegTestHost::InitializeEarlyConsole();
@@ -651,6 +1144,42 @@ int main(int argc, char* argv[])
   if (!RegTestHost::ParseCommandLineParameters(argc, argv, autoboot))
     return EXIT_FAILURE;
 
+  if (!s_mdec_benchmark_path.empty())
+  {
+    Error error;
+    if (!MDEC::RunBenchmark(s_mdec_benchmark_path.c_str(), s_mdec_benchmark_iterations, &error))
+    {
+      Log_ErrorFmt("MDEC benchmark failed: {}", error.GetDescription());
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  if (!s_reverb_benchmark_path.empty())
+  {
+    Error error;
+    if (!SPU::RunReverbBenchmark(s_reverb_benchmark_path.c_str(), SPU::SAMPLE_RATE * 60, &error))
+    {
+      Log_ErrorFmt("Reverb benchmark failed: {}", error.GetDescription());
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  if (s_gte_test_iterations > 0)
+  {
+    Error error;
+    if (!GTE::RunSelfTest(s_gte_test_iterations, &error))
+    {
+      Log_ErrorFmt("GTE test failed: {}", error.GetDescription());
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   if (!autoboot || autoboot->filename.empty())
   {
     Log_ErrorPrint("No boot path specified.");
@@ -682,13 +1211,56 @@ int main(int argc, char* argv[])
     Log_InfoPrintf("Dumping every %dth frame to '%s'.", s_frame_dump_interval, s_dump_base_directory.c_str());
   }
 
+  if (!s_mdec_capture_path.empty() && !MDEC::StartCapture(s_mdec_capture_path.c_str(), &error))
+  {
+    Log_ErrorFmt("Failed to start MDEC capture: {}", error.GetDescription());
+    goto cleanup;
+  }
+
+  if (!s_benchmark_report_path.empty())
+  {
+    Log_InfoFmt("Benchmarking {} frames after {} warm-up frames.", s_frames_to_run, s_benchmark_warmup_frames);
+    s_frames_to_run += s_benchmark_warmup_frames;
+    if (s_benchmark_warmup_frames == 0)
+      RegTestHost::StartBenchmark();
+  }
+
+  if ((!s_hash_log_path.empty() || !s_hash_compare_path.empty()) && !RegTestHost::OpenFrameHashLogs())
+    goto cleanup;
+
+  if (!s_capture_path.empty() && !System::StartCapture(s_capture_path.c_str()))
+    goto cleanup;
+
   Log_InfoPrintf("Running for %d frames...", s_frames_to_run);
   System::Execute();
 
+  if (!s_golden_hashes.empty())
+  {
+    if (s_first_divergent_frame.has_value())
+    {
+      Log_ErrorFmt("{} of {} frames differ from the golden hash log, starting at frame {}.", s_divergent_frame_count,
+                   s_golden_hash_index, s_first_divergent_frame.value());
+      goto cleanup;
+    }
+
+    if (s_golden_hash_index < s_golden_hashes.size())
+    {
+      Log_WarningFmt("Only {} of {} golden frames were compared.", s_golden_hash_index, s_golden_hashes.size());
+    }
+    else
+    {
+      Log_InfoFmt("All {} frames match the golden hash log.", s_golden_hash_index);
+    }
+  }
+
   Log_InfoPrintf("Exiting with success.");
   result = 0;
 
 cleanup:
+  System::StopCapture();
+  s_hash_log_file.reset();
+  SPU::SetOutputHashingEnabled(false);
+  MDEC::StopCapture();
   System::Internal::ProcessShutdown();
   return result;
 }
@@ -398,6 +398,15 @@ s64 CDImage::GetSizeOnDisk() const
   return -1;
 }
 
+void CDImage::SetDecompressionPrefetch(u32 count)
+{
+}
+
+bool CDImage::GetDecompressionStats(DecompressionStats* stats) const
+{
+  return false;
+}
+
 void CDImage::ClearTOC()
 {
   m_lba_count = 0;
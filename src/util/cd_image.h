@@ -202,6 +202,16 @@ public:
   };
   static_assert(sizeof(SubChannelQ) == SUBCHANNEL_BYTES_PER_FRAME, "SubChannelQ is correct size");
 
+  struct DecompressionStats
+  {
+    u64 cache_hits;
+    u64 cache_misses;
+    u64 prefetch_waits;     // Hits which had to wait for a background decompression to finish.
+    u64 blocks_prefetched;
+    u64 blocks_decompressed;
+    double decompress_time_ms;
+  };
+
   struct Track
   {
     u32 track_number;
@@ -332,6 +342,12 @@ public:
   // If this function returns -1, it means the size could not be computed.
   virtual s64 GetSizeOnDisk() const;
 
+  // Sets how many compressed blocks past the read position are decompressed in the background, if supported.
+  virtual void SetDecompressionPrefetch(u32 count);
+
+  // Returns decompression cache statistics, if the image is compressed.
+  virtual bool GetDecompressionStats(DecompressionStats* stats) const;
+
 protected:
   void ClearTOC();
   void CopyTOC(const CDImage* image);
@@ -14,18 +14,25 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
+#include "common/timer.h"
 
 #include "fmt/format.h"
 #include "libchdr/cdrom.h"
 #include "libchdr/chd.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <limits>
 #include <mutex>
 #include <optional>
+#include <thread>
 
 Log_SetChannel(CDImageCHD);
 
@@ -69,6 +76,8 @@ public:
   PrecacheResult Precache(ProgressCallback* progress) override;
   bool IsPrecached() const override;
   s64 GetSizeOnDisk() const override;
+  void SetDecompressionPrefetch(u32 count) override;
+  bool GetDecompressionStats(DecompressionStats* stats) const override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
@@ -78,19 +87,61 @@ private:
   static constexpr u32 CHD_CD_TRACK_ALIGNMENT = 4;
   static constexpr u32 MAX_PARENTS = 32; // Surely someone wouldn't be insane enough to go beyond this...
 
+  static constexpr u32 INVALID_HUNK = static_cast<u32>(-1);
+  static constexpr u32 HUNK_CACHE_SIZE = 32;
+  static constexpr u32 MAX_PREFETCH_HUNKS = 16;
+  static constexpr u32 MAX_PREFETCH_THREADS = 2;
+
+  struct CachedHunk
+  {
+    DynamicHeapArray<u8, 16> data;
+    u32 hunk_index = INVALID_HUNK;
+    u32 last_used = 0;
+    bool pending = false; // being decompressed, don't touch
+  };
+
   chd_file* OpenCHD(std::string_view filename, FileSystem::ManagedCFilePtr fp, Error* error, u32 recursion_level);
   bool UpdateHunkBuffer(const Index& index, LBA lba_in_index, u32& hunk_offset);
 
+  CachedHunk* LookupCachedHunk(u32 hunk_index);
+  CachedHunk* AllocateCachedHunk();
+  void QueuePrefetch(u32 hunk_index);
+  bool DecompressHunk(chd_file* chd, u32 hunk_index, u8* buffer);
+
+  void StartPrefetchThreads(u32 count);
+  void StopPrefetchThreads();
+  void PrefetchThreadEntryPoint(chd_file* chd);
+
   static void CopyAndSwap(void* dst_ptr, const u8* src_ptr);
 
   chd_file* m_chd = nullptr;
   u32 m_hunk_size = 0;
+  u32 m_hunk_count = 0;
   u32 m_sectors_per_hunk = 0;
 
-  DynamicHeapArray<u8, 16> m_hunk_buffer;
-  u32 m_current_hunk_index = static_cast<u32>(-1);
+  // LRU of decompressed hunks, shared with the prefetch threads. The current hunk is never evicted, so the reader can
+  // access it without holding the lock.
+  std::array<CachedHunk, HUNK_CACHE_SIZE> m_hunk_cache;
+  const u8* m_current_hunk = nullptr;
+  u32 m_current_hunk_index = INVALID_HUNK;
+  u32 m_hunk_cache_counter = 0;
+  u32 m_prefetch_hunks = 0;
   bool m_precached = false;
 
+  std::mutex m_hunk_cache_mutex;
+  std::condition_variable m_prefetch_cv;
+  std::condition_variable m_hunk_ready_cv;
+  std::deque<u32> m_prefetch_queue;
+  std::vector<std::thread> m_prefetch_threads;
+  bool m_prefetch_shutdown = false;
+
+  std::atomic<u64> m_stat_cache_hits{0};
+  std::atomic<u64> m_stat_cache_misses{0};
+  std::atomic<u64> m_stat_prefetch_waits{0};
+  std::atomic<u64> m_stat_hunks_prefetched{0};
+  std::atomic<u64> m_stat_hunks_decompressed{0};
+  std::atomic<Common::Timer::Value> m_stat_decompress_time{0};
+
   CDSubChannelReplacement m_sbi;
 };
 } // namespace
@@ -99,6 +150,8 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  StopPrefetchThreads();
+
   if (m_chd)
     chd_close(m_chd);
 }
@@ -260,8 +313,10 @@ bool CDImageCHD::Open(const char* filename, Error* error)
     return false;
   }
 
+  m_hunk_count = header->totalhunks;
   m_sectors_per_hunk = m_hunk_size / CHD_CD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+  for (CachedHunk& hunk : m_hunk_cache)
+    hunk.data.resize(m_hunk_size);
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -433,7 +488,7 @@ bool CDImageCHD::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_
     return false;
 
   u8 deinterleaved_subchannel_data[96];
-  const u8* raw_subchannel_data = &m_hunk_buffer[hunk_offset + RAW_SECTOR_SIZE];
+  const u8* raw_subchannel_data = &m_current_hunk[hunk_offset + RAW_SECTOR_SIZE];
   const u8* real_subchannel_data = raw_subchannel_data;
   if (index.submode == CDImage::SubchannelMode::RawInterleaved)
   {
@@ -541,9 +596,9 @@ bool CDImageCHD::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
 
   // Audio data is in big-endian, so we have to swap it for little endian hosts...
   if (index.mode == TrackMode::Audio)
-    CopyAndSwap(buffer, &m_hunk_buffer[hunk_offset]);
+    CopyAndSwap(buffer, &m_current_hunk[hunk_offset]);
   else
-    std::memcpy(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    std::memcpy(buffer, &m_current_hunk[hunk_offset], RAW_SECTOR_SIZE);
 
   return true;
 }
@@ -558,17 +613,229 @@ ALWAYS_INLINE_RELEASE bool CDImageCHD::UpdateHunkBuffer(const Index& index, LBA
   if (m_current_hunk_index == hunk_index)
     return true;
 
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
+  std::unique_lock lock(m_hunk_cache_mutex);
+  CachedHunk* hunk = LookupCachedHunk(hunk_index);
+  if (hunk && hunk->pending)
   {
-    Log_ErrorFmt("chd_read({}) failed: %s", hunk_index, chd_error_string(err));
+    // prefetch thread is already on it
+    m_stat_prefetch_waits.fetch_add(1, std::memory_order_relaxed);
+    m_hunk_ready_cv.wait(lock, [hunk]() { return !hunk->pending; });
+    if (hunk->hunk_index != hunk_index)
+      hunk = nullptr;
+  }
 
-    // data might have been partially written
-    m_current_hunk_index = static_cast<u32>(-1);
-    return false;
+  if (hunk)
+  {
+    m_stat_cache_hits.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    m_stat_cache_misses.fetch_add(1, std::memory_order_relaxed);
+
+    // the previous hunk can go now
+    m_current_hunk = nullptr;
+    m_current_hunk_index = INVALID_HUNK;
+
+    hunk = AllocateCachedHunk();
+    hunk->hunk_index = hunk_index;
+    hunk->pending = true;
+    lock.unlock();
+
+    const bool result = DecompressHunk(m_chd, hunk_index, hunk->data.data());
+
+    lock.lock();
+    hunk->pending = false;
+    if (!result)
+    {
+      // data might have been partially written
+      hunk->hunk_index = INVALID_HUNK;
+      return false;
+    }
   }
 
+  hunk->last_used = ++m_hunk_cache_counter;
+  m_current_hunk = hunk->data.data();
   m_current_hunk_index = hunk_index;
+
+  if (m_prefetch_hunks > 0)
+    QueuePrefetch(hunk_index);
+
+  return true;
+}
+
+CDImageCHD::CachedHunk* CDImageCHD::LookupCachedHunk(u32 hunk_index)
+{
+  for (CachedHunk& hunk : m_hunk_cache)
+  {
+    if (hunk.hunk_index == hunk_index)
+      return &hunk;
+  }
+
+  return nullptr;
+}
+
+CDImageCHD::CachedHunk* CDImageCHD::AllocateCachedHunk()
+{
+  // There's always a free slot, since at most one hunk per prefetch thread plus the current hunk are in use.
+  CachedHunk* lru = nullptr;
+  for (CachedHunk& hunk : m_hunk_cache)
+  {
+    if (hunk.pending || (m_current_hunk == hunk.data.data()))
+      continue;
+    else if (hunk.hunk_index == INVALID_HUNK)
+      return &hunk;
+    else if (!lru || hunk.last_used < lru->last_used)
+      lru = &hunk;
+  }
+
+  DebugAssert(lru);
+  return lru;
+}
+
+void CDImageCHD::QueuePrefetch(u32 hunk_index)
+{
+  // Anything still queued is for a position we've moved away from.
+  m_prefetch_queue.clear();
+
+  const u32 end_hunk = std::min(hunk_index + 1 + m_prefetch_hunks, m_hunk_count);
+  for (u32 i = hunk_index + 1; i < end_hunk; i++)
+  {
+    CachedHunk* hunk = LookupCachedHunk(i);
+    if (hunk)
+    {
+      // bump it so it doesn't get evicted by the hunks we're about to prefetch
+      if (!hunk->pending)
+        hunk->last_used = ++m_hunk_cache_counter;
+      continue;
+    }
+
+    m_prefetch_queue.push_back(i);
+  }
+
+  if (!m_prefetch_queue.empty())
+    m_prefetch_cv.notify_all();
+}
+
+bool CDImageCHD::DecompressHunk(chd_file* chd, u32 hunk_index, u8* buffer)
+{
+  const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+  const chd_error err = chd_read(chd, hunk_index, buffer);
+  m_stat_decompress_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+  if (err != CHDERR_NONE)
+  {
+    Log_ErrorFmt("chd_read({}) failed: {}", hunk_index, chd_error_string(err));
+    return false;
+  }
+
+  m_stat_hunks_decompressed.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void CDImageCHD::SetDecompressionPrefetch(u32 count)
+{
+  count = std::min(count, MAX_PREFETCH_HUNKS);
+  if (count == m_prefetch_hunks)
+    return;
+
+  StopPrefetchThreads();
+  if (count > 0)
+    StartPrefetchThreads(count);
+}
+
+void CDImageCHD::StartPrefetchThreads(u32 count)
+{
+  DebugAssert(m_prefetch_threads.empty());
+
+  // libchdr isn't thread safe, so each thread needs its own handle.
+  const u32 num_threads = std::min(count, MAX_PREFETCH_THREADS);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    auto fp =
+      FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite);
+    chd_file* chd = fp ? OpenCHD(m_filename, std::move(fp), nullptr, 0) : nullptr;
+    if (!chd)
+    {
+      Log_ErrorFmt("Failed to reopen '{}' for prefetching", m_filename);
+      break;
+    }
+
+    m_prefetch_threads.emplace_back(&CDImageCHD::PrefetchThreadEntryPoint, this, chd);
+  }
+
+  if (m_prefetch_threads.empty())
+    return;
+
+  Log_DevFmt("Prefetching {} hunks using {} threads", count, m_prefetch_threads.size());
+
+  std::unique_lock lock(m_hunk_cache_mutex);
+  m_prefetch_hunks = count;
+}
+
+void CDImageCHD::StopPrefetchThreads()
+{
+  if (m_prefetch_threads.empty())
+    return;
+
+  {
+    std::unique_lock lock(m_hunk_cache_mutex);
+    m_prefetch_hunks = 0;
+    m_prefetch_queue.clear();
+    m_prefetch_shutdown = true;
+    m_prefetch_cv.notify_all();
+  }
+
+  for (std::thread& thread : m_prefetch_threads)
+    thread.join();
+  m_prefetch_threads.clear();
+  m_prefetch_shutdown = false;
+}
+
+void CDImageCHD::PrefetchThreadEntryPoint(chd_file* chd)
+{
+  Threading::SetNameOfCurrentThread("CHD Prefetch");
+
+  std::unique_lock lock(m_hunk_cache_mutex);
+  for (;;)
+  {
+    m_prefetch_cv.wait(lock, [this]() { return (m_prefetch_shutdown || !m_prefetch_queue.empty()); });
+    if (m_prefetch_shutdown)
+      break;
+
+    const u32 hunk_index = m_prefetch_queue.front();
+    m_prefetch_queue.pop_front();
+    if (LookupCachedHunk(hunk_index))
+      continue;
+
+    CachedHunk* hunk = AllocateCachedHunk();
+    hunk->hunk_index = hunk_index;
+    hunk->last_used = ++m_hunk_cache_counter;
+    hunk->pending = true;
+    lock.unlock();
+
+    const bool result = DecompressHunk(chd, hunk_index, hunk->data.data());
+    if (result)
+      m_stat_hunks_prefetched.fetch_add(1, std::memory_order_relaxed);
+
+    lock.lock();
+    hunk->pending = false;
+    if (!result)
+      hunk->hunk_index = INVALID_HUNK;
+    m_hunk_ready_cv.notify_all();
+  }
+
+  lock.unlock();
+  chd_close(chd);
+}
+
+bool CDImageCHD::GetDecompressionStats(DecompressionStats* stats) const
+{
+  stats->cache_hits = m_stat_cache_hits.load(std::memory_order_relaxed);
+  stats->cache_misses = m_stat_cache_misses.load(std::memory_order_relaxed);
+  stats->prefetch_waits = m_stat_prefetch_waits.load(std::memory_order_relaxed);
+  stats->blocks_prefetched = m_stat_hunks_prefetched.load(std::memory_order_relaxed);
+  stats->blocks_decompressed = m_stat_hunks_decompressed.load(std::memory_order_relaxed);
+  stats->decompress_time_ms =
+    Common::Timer::ConvertValueToMilliseconds(m_stat_decompress_time.load(std::memory_order_relaxed));
   return true;
 }
 
@@ -35,6 +35,8 @@ public:
   u32 GetCurrentSubImage() const override;
   std::string GetSubImageMetadata(u32 index, const std::string_view& type) const override;
   bool SwitchSubImage(u32 index, Error* error) override;
+  void SetDecompressionPrefetch(u32 count) override;
+  bool GetDecompressionStats(DecompressionStats* stats) const override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
@@ -50,6 +52,7 @@ private:
   std::vector<Entry> m_entries;
   std::unique_ptr<CDImage> m_current_image;
   u32 m_current_image_index = UINT32_C(0xFFFFFFFF);
+  u32 m_decompression_prefetch = 0;
   bool m_apply_patches = false;
 };
 
@@ -150,6 +153,9 @@ bool CDImageM3u::SwitchSubImage(u32 index, Error* error)
     return false;
   }
 
+  if (m_decompression_prefetch > 0)
+    new_image->SetDecompressionPrefetch(m_decompression_prefetch);
+
   CopyTOC(new_image.get());
   m_current_image = std::move(new_image);
   m_current_image_index = index;
@@ -159,6 +165,17 @@ bool CDImageM3u::SwitchSubImage(u32 index, Error* error)
   return true;
 }
 
+void CDImageM3u::SetDecompressionPrefetch(u32 count)
+{
+  m_decompression_prefetch = count;
+  m_current_image->SetDecompressionPrefetch(count);
+}
+
+bool CDImageM3u::GetDecompressionStats(DecompressionStats* stats) const
+{
+  return m_current_image->GetDecompressionStats(stats);
+}
+
 std::string CDImageM3u::GetSubImageMetadata(u32 index, const std::string_view& type) const
 {
   if (index > m_entries.size())
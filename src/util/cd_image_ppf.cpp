@@ -34,6 +34,8 @@ public:
   bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
   bool HasNonStandardSubchannel() const override;
   s64 GetSizeOnDisk() const override;
+  void SetDecompressionPrefetch(u32 count) override;
+  bool GetDecompressionStats(DecompressionStats* stats) const override;
 
   std::string GetMetadata(const std::string_view& type) const override;
   std::string GetSubImageMetadata(u32 index, const std::string_view& type) const override;
@@ -454,6 +456,16 @@ s64 CDImagePPF::GetSizeOnDisk() const
   return m_patch_size + m_parent_image->GetSizeOnDisk();
 }
 
+void CDImagePPF::SetDecompressionPrefetch(u32 count)
+{
+  m_parent_image->SetDecompressionPrefetch(count);
+}
+
+bool CDImagePPF::GetDecompressionStats(DecompressionStats* stats) const
+{
+  return m_parent_image->GetDecompressionStats(stats);
+}
+
 std::unique_ptr<CDImage>
 CDImage::OverlayPPFPatch(const char* filename, std::unique_ptr<CDImage> parent_image,
                          ProgressCallback* progress /* = ProgressCallback::NullProgressCallback */)
@@ -152,11 +152,13 @@ bool JitCodeBuffer::Allocate(u32 size /* = 64 * 1024 * 1024 */, u32 far_code_siz
   m_free_code_ptr = m_code_ptr;
   m_code_size = size;
   m_code_used = 0;
+  m_code_limit = size;
 
   m_far_code_ptr = static_cast<u8*>(m_code_ptr) + size;
   m_free_far_code_ptr = m_far_code_ptr;
   m_far_code_size = far_code_size;
   m_far_code_used = 0;
+  m_far_code_limit = far_code_size;
 
   m_old_protection = 0;
   m_owns_buffer = true;
@@ -279,11 +281,13 @@ bool JitCodeBuffer::Initialize(void* buffer, u32 size, u32 far_code_size /* = 0
   m_free_code_ptr = m_code_ptr + guard_size;
   m_code_size = size - far_code_size - (guard_size * 2);
   m_code_used = 0;
+  m_code_limit = m_code_size;
 
   m_far_code_ptr = static_cast<u8*>(m_code_ptr) + m_code_size;
   m_free_far_code_ptr = m_far_code_ptr;
   m_far_code_size = far_code_size - guard_size;
   m_far_code_used = 0;
+  m_far_code_limit = m_far_code_size;
 
   m_guard_size = guard_size;
   m_owns_buffer = false;
@@ -334,10 +338,18 @@ void JitCodeBuffer::Destroy()
   m_code_size = 0;
   m_code_reserve_size = 0;
   m_code_used = 0;
+  m_code_limit = 0;
   m_far_code_ptr = nullptr;
   m_free_far_code_ptr = nullptr;
   m_far_code_size = 0;
   m_far_code_used = 0;
+  m_far_code_limit = 0;
+  m_region_count = 0;
+  m_current_region = 0;
+  m_region_start = 0;
+  m_region_size = 0;
+  m_far_region_start = 0;
+  m_far_region_size = 0;
   m_total_size = 0;
   m_guard_size = 0;
   m_old_protection = 0;
@@ -352,6 +364,7 @@ void JitCodeBuffer::ReserveCode(u32 size)
   m_code_reserve_size += size;
   m_free_code_ptr += size;
   m_code_size -= size;
+  m_code_limit = m_code_size;
 }
 
 void JitCodeBuffer::CommitCode(u32 length)
@@ -364,7 +377,7 @@ void JitCodeBuffer::CommitCode(u32 length)
   FlushInstructionCache(m_free_code_ptr, length);
 #endif
 
-  Assert(length <= (m_code_size - m_code_used));
+  Assert(length <= (m_code_limit - m_code_used));
   m_free_code_ptr += length;
   m_code_used += length;
 }
@@ -379,7 +392,7 @@ void JitCodeBuffer::CommitFarCode(u32 length)
   FlushInstructionCache(m_free_far_code_ptr, length);
 #endif
 
-  Assert(length <= (m_far_code_size - m_far_code_used));
+  Assert(length <= (m_far_code_limit - m_far_code_used));
   m_free_far_code_ptr += length;
   m_far_code_used += length;
 }
@@ -388,6 +401,11 @@ void JitCodeBuffer::Reset()
 {
   MemMap::BeginCodeWrite();
 
+  m_region_count = 0;
+  m_current_region = 0;
+  m_code_limit = m_code_size;
+  m_far_code_limit = m_far_code_size;
+
   m_free_code_ptr = m_code_ptr + m_guard_size + m_code_reserve_size;
   m_code_used = 0;
 #ifdef __SWITCH__
@@ -412,6 +430,74 @@ void JitCodeBuffer::Reset()
   MemMap::EndCodeWrite();
 }
 
+void JitCodeBuffer::SetupRegions(u32 count)
+{
+  DebugAssert(count > 0);
+
+  m_region_count = count;
+  m_region_start = m_code_used;
+  m_region_size = (m_code_size - m_code_used) / count;
+  m_far_region_start = m_far_code_used;
+  m_far_region_size = (m_far_code_size - m_far_code_used) / count;
+
+  // region 0 begins where we currently are, no need to clear it
+  m_current_region = 0;
+  m_code_limit = m_region_start + m_region_size;
+  m_far_code_limit = m_far_region_start + m_far_region_size;
+}
+
+u32 JitCodeBuffer::GetRegionForPointer(const void* ptr) const
+{
+  const u8* code_base = m_code_ptr + m_guard_size + m_code_reserve_size;
+  const u8* bptr = static_cast<const u8*>(ptr);
+  if (m_region_size > 0 && bptr >= (code_base + m_region_start) && bptr < (code_base + m_code_size))
+    return std::min(static_cast<u32>(bptr - (code_base + m_region_start)) / m_region_size, m_region_count - 1);
+  if (m_far_region_size > 0 && bptr >= (m_far_code_ptr + m_far_region_start) &&
+      bptr < (m_far_code_ptr + m_far_code_size))
+  {
+    return std::min(static_cast<u32>(bptr - (m_far_code_ptr + m_far_region_start)) / m_far_region_size,
+                    m_region_count - 1);
+  }
+
+  return m_region_count;
+}
+
+void JitCodeBuffer::SwitchToRegion(u32 region)
+{
+  DebugAssert(region < m_region_count);
+
+  MemMap::BeginCodeWrite();
+
+  // last region picks up the remainder
+  const bool last = (region == (m_region_count - 1));
+  u8* const code_base = m_code_ptr + m_guard_size + m_code_reserve_size;
+  m_current_region = region;
+  m_code_used = m_region_start + (region * m_region_size);
+  m_code_limit = last ? m_code_size : (m_code_used + m_region_size);
+  m_free_code_ptr = code_base + m_code_used;
+#ifdef __SWITCH__
+  std::memset(m_free_code_ptr - m_code_ptr + m_rw_ptr, 0, m_code_limit - m_code_used);
+#else
+  std::memset(m_free_code_ptr, 0, m_code_limit - m_code_used);
+#endif
+  FlushInstructionCache(m_free_code_ptr, m_code_limit - m_code_used);
+
+  if (m_far_region_size > 0)
+  {
+    m_far_code_used = m_far_region_start + (region * m_far_region_size);
+    m_far_code_limit = last ? m_far_code_size : (m_far_code_used + m_far_region_size);
+    m_free_far_code_ptr = m_far_code_ptr + m_far_code_used;
+#ifdef __SWITCH__
+    std::memset(m_free_far_code_ptr - m_code_ptr + m_rw_ptr, 0, m_far_code_limit - m_far_code_used);
+#else
+    std::memset(m_free_far_code_ptr, 0, m_far_code_limit - m_far_code_used);
+#endif
+    FlushInstructionCache(m_free_far_code_ptr, m_far_code_limit - m_far_code_used);
+  }
+
+  MemMap::EndCodeWrite();
+}
+
 void JitCodeBuffer::Align(u32 alignment, u8 padding_value)
 {
   DebugAssert(Common::IsPow2(alignment));
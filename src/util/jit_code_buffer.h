@@ -35,14 +35,27 @@ public:
   ALWAYS_INLINE u32 GetTotalUsed() const { return m_code_used + m_far_code_used; }
 
   ALWAYS_INLINE u8* GetFreeCodePointer() const { return m_free_code_ptr; }
-  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_size - m_code_used); }
+  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_limit - m_code_used); }
   void ReserveCode(u32 size);
   void CommitCode(u32 length);
 
   ALWAYS_INLINE u8* GetFreeFarCodePointer() const { return m_free_far_code_ptr; }
-  ALWAYS_INLINE u32 GetFreeFarCodeSpace() const { return static_cast<u32>(m_far_code_size - m_far_code_used); }
+  ALWAYS_INLINE u32 GetFreeFarCodeSpace() const { return static_cast<u32>(m_far_code_limit - m_far_code_used); }
   void CommitFarCode(u32 length);
 
+  /// Splits the remaining near and far code space into equally-sized regions, which are filled one at a time and can
+  /// be recycled individually. Code committed before this call stays resident until the next Reset().
+  void SetupRegions(u32 count);
+
+  ALWAYS_INLINE u32 GetRegionCount() const { return m_region_count; }
+  ALWAYS_INLINE u32 GetCurrentRegion() const { return m_current_region; }
+
+  /// Returns the region containing the specified near or far code pointer, or GetRegionCount() if it is not in one.
+  u32 GetRegionForPointer(const void* ptr) const;
+
+  /// Clears the specified region, and continues allocating from its start.
+  void SwitchToRegion(u32 region);
+
   ALWAYS_INLINE ptrdiff_t GetRWDiff()
   {
 #ifdef __SWITCH__
@@ -72,11 +85,20 @@ private:
   u32 m_code_size = 0;
   u32 m_code_reserve_size = 0;
   u32 m_code_used = 0;
+  u32 m_code_limit = 0;
 
   u8* m_far_code_ptr = nullptr;
   u8* m_free_far_code_ptr = nullptr;
   u32 m_far_code_size = 0;
   u32 m_far_code_used = 0;
+  u32 m_far_code_limit = 0;
+
+  u32 m_region_count = 0;
+  u32 m_current_region = 0;
+  u32 m_region_start = 0;
+  u32 m_region_size = 0;
+  u32 m_far_region_start = 0;
+  u32 m_far_region_size = 0;
 
   u32 m_total_size = 0;
   u32 m_guard_size = 0;